@@ -0,0 +1,16 @@
+#-------------------------------------------------
+#
+# Приложение и консольные программы игры.
+#
+#-------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    HexxagonApplication \
+    HexxagonBench \
+    HexxagonLibrary \
+    HexxagonRender \
+    HexxagonServer \
+    HexxagonSolver \
+    HexxagonTuner
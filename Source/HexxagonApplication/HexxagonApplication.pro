@@ -11,14 +11,19 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 TARGET = HexxagonApplication
 TEMPLATE = app
 
+include(engine.pri)
 
 SOURCES += \
+    boardrenderer.cpp \
+    chipanimator.cpp \
     hexxagongame.cpp \
     hexwidget.cpp \
     main.cpp \
     mainwindow.cpp
 
 HEADERS  += \
+    boardrenderer.h \
+    chipanimator.h \
     hexxagongame.h \
     hexwidget.h \
     mainwindow.h
@@ -0,0 +1,290 @@
+﻿/**
+* @file boardrenderer.cpp
+* @author Oleg2008e28
+* @date 20.10.2026 14:32:08
+* @brief Файл реализации методов класса BoardRenderer.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "boardrenderer.h"
+#include <QRadialGradient>
+#include <QPolygon>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+const QRgb BoardRenderer::highlightColor;
+const QRgb BoardRenderer::lastMoveColor;
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief BoardRenderer::BoardRenderer Конструктор: вычисляет координаты ячеек и рисует спрайты.
+ * @param board Геометрия поля.
+ * @param height Высота изображений, пикселей.
+ */
+BoardRenderer::BoardRenderer(HexBoard const& board, int height) : hexBoard(board), height(height){
+    cells = calculateLayout(hexBoard, height);
+    int R = cells.radius;
+    spriteOrigin = QPoint(R + 1, R + 1);                    // Запас в пиксель на сглаживание контура.
+    slotSprite = sprite([R](QPainter& painter, QPoint const& c){
+        drawSlot(painter, c.x(), c.y(), R);
+    });
+    for (int player = 1; player <= 2; player++){
+        chipSprites[player - 1] = sprite([R, player](QPainter& painter, QPoint const& c){
+            painter.setPen(Qt::black);
+            drawChip(painter, c, R * 0.6, R * 0.6, int8_t(player));
+        });
+    }
+}
+HexBoard const& BoardRenderer::board() const{ return hexBoard; }
+BoardLayout const& BoardRenderer::layout() const{ return cells; }
+QSize BoardRenderer::size() const{ return QSize(cells.width, height); }
+/**
+ * @brief BoardRenderer::render Метод рисует позицию в новое изображение.
+ * @param picture Позиция и подсветка.
+ * @return Изображение размера size() с прозрачным фоном.
+ */
+QImage BoardRenderer::render(BoardPicture const& picture) const{
+    QImage image(size(), QImage::Format_ARGB32_Premultiplied);
+    QPainter painter;
+    render(picture, image, painter);
+    return image;
+}
+/**
+ * @brief BoardRenderer::render Метод рисует позицию в готовое изображение. Ячейки и фишки копируются
+ * из спрайтов, порядок слоев такой же, как в HexWidget: ячейка, подсветка, фишка.
+ * @param picture Позиция и подсветка.
+ * @param image Изображение размера size().
+ * @param painter Рисовальщик потока, не связанный с устройством.
+ */
+void BoardRenderer::render(BoardPicture const& picture, QImage& image, QPainter& painter) const{
+    int8_t field[HexBoard::maxCells];
+    hexBoard.fieldFromPosition(picture.position, field);
+    Bitboard lastMove = Bitboard::empty();                  // Ячейки последнего хода.
+    if (picture.hasLastMove){
+        lastMove.set(picture.lastMove.newPostion);
+        if (picture.lastMove.clearBeginPostion){            // Начало ближнего хода не важно.
+            lastMove.set(picture.lastMove.beginPostion);
+        }
+    }
+    Bitboard highlighted = Bitboard::empty();
+    for (int index : picture.highlights){
+        if (index >= 0 && index < hexBoard.cellCount()) highlighted.set(index);
+    }
+    QBrush lastMoveBrush(QColor::fromRgba(lastMoveColor));
+    QBrush highlightBrush(QColor::fromRgba(highlightColor));
+    image.fill(Qt::transparent);
+    painter.begin(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    for (int index = 0; index < cells.centers.size(); index++){
+        QPoint const& c = cells.centers[index];
+        if (field[index] < 3){
+            painter.drawImage(c - spriteOrigin, slotSprite);
+        }
+        if (lastMove.test(index)){
+            drawHighlight(painter, c.x(), c.y(), cells.radius, lastMoveBrush);
+        }
+        if (highlighted.test(index)){
+            drawHighlight(painter, c.x(), c.y(), cells.radius, highlightBrush);
+        }
+        if (field[index] == 1 || field[index] == 2){
+            painter.drawImage(c - spriteOrigin, chipSprites[field[index] - 1]);
+        }
+    }
+    painter.end();
+}
+/**
+ * @brief BoardRenderer::renderBatch Метод рисует пакет позиций в нескольких потоках. У каждого потока
+ * свои изображение и рисовальщик, спрайты общие. Потоки берут позиции по очереди, поэтому медленный
+ * обработчик одной позиции не задерживает остальные.
+ * @param pictures Позиции.
+ * @param threads Количество потоков.
+ * @param sink Обработчик изображения, вызывается в потоке отрисовки с номером позиции. Изображение
+ * действительно до возврата из обработчика, для хранения его нужно скопировать.
+ */
+void BoardRenderer::renderBatch(std::vector<BoardPicture> const& pictures, int threads,
+                                std::function<void(size_t, QImage const&)> const& sink) const{
+    threads = std::max(1, std::min(threads, int(pictures.size())));
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++){
+        pool.emplace_back([&](){
+            QImage image(size(), QImage::Format_ARGB32_Premultiplied);
+            QPainter painter;
+            for (size_t i = next++; i < pictures.size(); i = next++){
+                render(pictures[i], image, painter);
+                sink(i, image);
+            }
+        });
+    }
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+}
+//............................................................................................................
+/**
+ * @brief BoardRenderer::calculateLayout Метод вычисления координат центров ячеек поля, вписанного по
+ * высоте. Столбцы идут слева направо, центральный столбец выше крайних на половину ячейки на каждый шаг.
+ * @param board Геометрия поля.
+ * @param height Высота области отрисовки.
+ * @return Координаты ячеек.
+ */
+BoardLayout BoardRenderer::calculateLayout(HexBoard const& board, int height){
+    BoardLayout layout;
+    int columns = board.columnCount();                      // Количество столбцов поля.
+    int n = board.side() - 1;                               // Наибольшая осевая координата ячейки.
+    int h_op = height / (2 * columns);                      // Расстояние от центра шестигранника до стороны.
+    int R = 2*h_op/sqrt(3);                                 // Радиус шестигранника.
+    int smesh_y = double(R)*sin(double(60)* (M_PI / 180));  // Смещение по y при отрисовке поля.
+    int smesh_x = double(R)*cos(double(60)* (M_PI / 180));  // Смещение по x при отрисовке поля.
+    int x = R;                                              // Начальная координата x при отрисовке.
+    int y = n * h_op + R;                                   // Начальная координата y при отрисовке.
+    for (int j = 0; j < columns; j++){                      // Цикл перебора столбцов.
+        int delta = -smesh_y * (n - std::abs(j - n));       // Смещение по y столбца растет к центру.
+        for (int i= 0; i < board.columnSize(j); i++){       // Цикл перебора ячеек в столбце.
+            layout.centers.push_back(QPoint(x, y + delta
+                                            + i * smesh_y * 2));// Запись координат центра ячейки.
+        }
+        x += smesh_x * 3;                                   // Смещение по x для следующего столбца.
+    }
+    layout.radius = R;
+    layout.boardCenter = layout.centers[board.indexOf(0, 0)];// Начало осевых координат.
+    layout.columnStep = std::max(smesh_x * 3, 1);           // Шаги сетки такие же, как при
+    layout.rowStep = std::max(smesh_y * 2, 1);              // вычислении координат центров.
+    layout.width = x - smesh_x * 3 + R + 1;                 // Правый край последнего столбца.
+    return layout;
+}
+/**
+ * @brief BoardRenderer::drawSlot Метод отрисовки одной незаблокированной ячейки: шестигранник с бортами
+ * и дном.
+ * @param painter Рисовальщик.
+ * @param x Координата x центра ячейки.
+ * @param y Координата y центра ячейки.
+ * @param R Радиус описываемой окружности.
+ */
+void BoardRenderer::drawSlot(QPainter& painter, int x, int y, int R){
+    static const QBrush lightSlotBrush(QColor(209, 180, 0));  // Цвет светлого борта.
+    static const QBrush normalSlotBrush(QColor(255, 215, 0)); // Цвет основного полигона.
+    static const QBrush darkSlotBrush(QColor(153, 129, 0));   // Цвет темного борта.
+    static const QBrush bottomSlotBrush(QColor(178, 150, 0)); // Цвет дна.
+    QPolygon polygon;
+    int r1 = R-R*0.1;                                // Вычисление большего внутреннего радиуса шестигранника.
+    int r2 = r1-R*0.12;                              // Вычисление меньшего внутреннего радиуса шестигранника.
+    int dX = double(R)*cos(double(60)* (M_PI / 180));
+    int dY = double(R)*sin(double(60)* (M_PI / 180));
+    int dx1 = double(r1)*cos(double(60)* (M_PI / 180));
+    int dy1 = double(r1)*sin(double(60)* (M_PI / 180));
+    int dx2 = double(r2)*cos(double(60)* (M_PI / 180));
+    int dy2 = double(r2)*sin(double(60)* (M_PI / 180));
+    painter.setPen(Qt::black);
+    painter.setBrush(normalSlotBrush);
+
+    polygon << QPoint(x+R, y) << QPoint(x+dX, y-dY)         // Отрисовка большого полигона.
+            << QPoint(x-dX, y-dY) << QPoint(x-R, y)
+            << QPoint(x-dX, y+dY) << QPoint(x+dX, y+dY)
+            <<QPoint(x+R, y);
+    painter.drawPolygon(polygon);
+
+    painter.setPen(QColor(Qt::black));
+    polygon.clear();                                        // Отрисовка верхнего борта.
+    polygon << QPoint(x+dx1, y-dy1) << QPoint(x+dx2, y-dy2)
+            << QPoint(x-dx2, y-dy2) << QPoint(x-dx1, y-dy1)
+            << QPoint(x+dx1, y-dy1);
+    painter.setBrush(darkSlotBrush);
+    painter.drawPolygon(polygon);
+
+    polygon.clear();                                        // Отрисовка правого верхнего борта.
+    polygon << QPoint(x+dx1, y-dy1) << QPoint(x+dx2, y-dy2)
+            << QPoint(x+r2, y) << QPoint(x+r1, y)
+            << QPoint(x+dx1, y-dy1);
+    painter.setBrush(lightSlotBrush);
+    painter.drawPolygon(polygon);
+
+    polygon.clear();                                        // Отрисовка правого нижнего борта.
+    polygon << QPoint(x+r2, y) << QPoint(x+r1, y)
+            << QPoint(x+dx1, y+dy1) << QPoint(x+dx2, y+dy2)
+            << QPoint(x+r2, y);
+    painter.setBrush(lightSlotBrush);
+    painter.drawPolygon(polygon);
+
+    polygon.clear();                                        // Отрисовка нижнего борта.
+    polygon <<  QPoint(x+dx1, y+dy1) << QPoint(x+dx2, y+dy2)
+            << QPoint(x-dx2, y+dy2) << QPoint(x-dx1, y+dy1)
+            << QPoint(x+dx1, y+dy1);
+    painter.setBrush(lightSlotBrush);
+    painter.drawPolygon(polygon);
+
+    polygon.clear();                                        // Отрисовка левого нижнего борта.
+    polygon <<  QPoint(x-dx2, y+dy2) << QPoint(x-dx1, y+dy1)
+            << QPoint(x-r1, y) << QPoint(x-r2, y)
+            <<  QPoint(x-dx2, y+dy2);
+    painter.setBrush(darkSlotBrush);
+    painter.drawPolygon(polygon);
+
+    polygon.clear();                                        // Отрисовка левого верхнего борта.
+    polygon <<  QPoint(x-r1, y) << QPoint(x-r2, y)
+            << QPoint(x-dx2, y-dy2) << QPoint(x-dx1, y-dy1)
+            <<  QPoint(x-r1, y);
+    painter.setBrush(darkSlotBrush);
+    painter.drawPolygon(polygon);
+
+    polygon.clear();                                        // Отрисовка дна ячейки.
+    polygon << QPoint(x+r2, y) << QPoint(x+dx2, y-dy2)
+            << QPoint(x-dx2, y-dy2) << QPoint(x-r2, y)
+            << QPoint(x-dx2, y+dy2) << QPoint(x+dx2, y+dy2)
+            <<QPoint(x+r2, y);
+    painter.setBrush(bottomSlotBrush);
+    painter.drawPolygon(polygon);
+}
+/**
+ * @brief BoardRenderer::drawHighlight Метод заливки шестигранника ячейки поверх ее изображения.
+ * @param painter Рисовальщик.
+ * @param x Координата x центра ячейки.
+ * @param y Координата y центра ячейки.
+ * @param R Радиус описываемой окружности.
+ * @param brush Кисть заливки, обычно полупрозрачная.
+ */
+void BoardRenderer::drawHighlight(QPainter& painter, int x, int y, int R, QBrush const& brush){
+    int dX = double(R)*cos(double(60)* (M_PI / 180));
+    int dY = double(R)*sin(double(60)* (M_PI / 180));
+    QPolygon polygon;
+    polygon << QPoint(x+R, y) << QPoint(x+dX, y-dY)
+            << QPoint(x-dX, y-dY) << QPoint(x-R, y)
+            << QPoint(x-dX, y+dY) << QPoint(x+dX, y+dY)
+            <<QPoint(x+R, y);
+    painter.setBrush(brush);
+    painter.drawPolygon(polygon);
+}
+/**
+ * @brief BoardRenderer::drawChip Метод отрисовки фишки игрока.
+ * @param painter Рисовальщик.
+ * @param center Центр фишки.
+ * @param rx Радиус фишки по горизонтали.
+ * @param ry Радиус фишки по вертикали.
+ * @param player Игрок, которому принадлежит фишка.
+ */
+void BoardRenderer::drawChip(QPainter& painter, QPointF const& center, double rx, double ry, int8_t player){
+    QRadialGradient grad(center - QPointF(rx * 0.25, ry * 0.25), ry);  // Создается градиент.
+    grad.setColorAt(0.75, player == 1 ? Qt::red : Qt::blue);          // Цвет градиента в соответствии
+    grad.setColorAt(0, Qt::white);                                      // с цветом игрока, от белого.
+    painter.setBrush(grad);                                             // На основе градиента создается кисть
+    painter.drawEllipse(center, rx, ry);                                // и устанавливается в рисовальщик.
+}
+//............................................................................................................
+//......................................... private methods ..................................................
+//............................................................................................................
+/**
+ * @brief BoardRenderer::sprite Метод рисует спрайт: элемент ячейки на прозрачном фоне с центром в
+ * spriteOrigin.
+ * @param draw Функция отрисовки элемента по центру ячейки.
+ * @return Спрайт.
+ */
+QImage BoardRenderer::sprite(std::function<void(QPainter&, QPoint const&)> const& draw) const{
+    QImage image(2 * spriteOrigin.x() + 1, 2 * spriteOrigin.y() + 1, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    draw(painter, spriteOrigin);
+    painter.end();
+    return image;
+}
@@ -0,0 +1,82 @@
+﻿/**
+* @file boardrenderer.h
+* @author Oleg2008e28
+* @date 20.10.2026 14:06:31
+* @brief Заголовочный файл класса BoardRenderer, рисующего игровое поле в QImage без окна: геометрия
+* и отрисовка ячеек и фишек общие с HexWidget, пакет позиций рисуется в нескольких потоках.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+#include <QImage>
+#include <QPainter>
+#include <QPoint>
+#include <QVector>
+#include <functional>
+#include <vector>
+#include "hexboard.h"
+//............................................................................................................
+/**
+ * @brief The BoardLayout struct Координаты ячеек поля на рисунке заданной высоты.
+ */
+struct BoardLayout {
+    QVector<QPoint> centers;                            //!Центры ячеек по индексам.
+    QPoint boardCenter;                                 //!Центр ячейки с осевыми координатами (0, 0).
+    int radius = 0;                                     //!Радиус шестигранника ячейки.
+    int columnStep = 1;                                 //!Расстояние между столбцами по x.
+    int rowStep = 1;                                    //!Расстояние между ячейками столбца по y.
+    int width = 0;                                      //!Ширина поля.
+};
+/**
+ * @brief The BoardPicture struct Позиция для отрисовки с подсветкой.
+ */
+struct BoardPicture {
+    Position position;                                  //!Позиция.
+    Move lastMove;                                      //!Последний ход.
+    bool hasLastMove = false;                           //!Признак отрисовки последнего хода.
+    std::vector<int> highlights;                        //!Подсвеченные ячейки.
+};
+//............................................................................................................
+/**
+ * @brief The BoardRenderer class Отрисовка позиций поля заданной геометрии в изображения заданной высоты.
+ * Ячейка и фишки обоих игроков рисуются один раз в спрайты при создании объекта, изображения позиций
+ * собираются из спрайтов. После создания объект не изменяется, поэтому его методы отрисовки можно
+ * вызывать из нескольких потоков одновременно.
+ */
+class BoardRenderer{
+public:
+    BoardRenderer(HexBoard const& board, int height);   // Поле и высота изображений.
+    HexBoard const& board() const;                      // Геометрия поля.
+    BoardLayout const& layout() const;                  // Координаты ячеек.
+    QSize size() const;                                 // Размер изображений.
+    QImage render(BoardPicture const& picture) const;   // Изображение позиции.
+    void render(BoardPicture const& picture,
+                QImage& image, QPainter& painter) const;// Отрисовка позиции в готовое изображение.
+    void renderBatch(std::vector<BoardPicture> const& pictures, int threads,
+                     std::function<void(size_t, QImage const&)> const& sink) const;// Пакетная отрисовка.
+//.............................................. Общая отрисовка .............................................
+    static BoardLayout calculateLayout(HexBoard const& board,
+                                       int height);     // Координаты центров ячеек.
+    static void drawSlot(QPainter& painter, int x, int y,
+                         int R);                        // Отрисовка пустой ячейки.
+    static void drawHighlight(QPainter& painter, int x, int y, int R,
+                              QBrush const& brush);     // Заливка ячейки поверх.
+    static void drawChip(QPainter& painter, QPointF const& center,
+                         double rx, double ry,
+                         int8_t player);                // Отрисовка фишки игрока.
+//............................................................................................................
+public:
+    static const QRgb highlightColor = 0xB400FF00;      //!Подсветка ячеек (как ячейки ближнего хода).
+    static const QRgb lastMoveColor = 0xA0FF8C00;       //!Подсветка ячеек последнего хода.
+//............................................................................................................
+private:
+    QImage sprite(std::function<void(QPainter&, QPoint const&)> const& draw) const;// Спрайт ячейки.
+private:
+    HexBoard hexBoard;                                  // Геометрия поля.
+    BoardLayout cells;                                  // Координаты ячеек.
+    int height;                                         // Высота изображений.
+    QPoint spriteOrigin;                                // Центр ячейки в спрайте.
+    QImage slotSprite;                                  // Спрайт пустой ячейки.
+    QImage chipSprites[2];                              // Спрайты фишек игроков 1 и 2.
+};
+#endif // BOARDRENDERER_H
@@ -0,0 +1,156 @@
+﻿/**
+* @file chipanimator.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 10:31:05
+* @brief Файл реализации методов класса ChipAnimator.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "chipanimator.h"
+#include <cmath>
+#include <algorithm>
+const int ChipAnimator::addMoveDuration;
+const int ChipAnimator::transferMoveDuration;
+const int ChipAnimator::flipDuration;
+const int ChipAnimator::flipStagger;
+/**
+ * @brief ChipAnimator::ChipAnimator Конструктор класса.
+ */
+ChipAnimator::ChipAnimator(){
+    moveCurve.setType(QEasingCurve::InOutQuad);             // Фишка плавно разгоняется и тормозит.
+    flipCurve.setType(QEasingCurve::InOutSine);             // Переворот замедляется у краев.
+}
+/**
+ * @brief ChipAnimator::start Метод запуска анимации хода. Если предыдущая анимация еще не закончена,
+ * она прерывается: состояние поля на виджете к этому моменту уже конечное.
+ * @param newIndex Индекс ячейки, в которую выполняется ход.
+ * @param pointBegin Центр начальной ячейки.
+ * @param pointEnd Центр конечной ячейки.
+ * @param player Игрок, выполняющий ход.
+ * @param enemy Противник игрока.
+ * @param captured Индексы захваченных фишек противника.
+ * @param transfer Признак дальнего хода.
+ */
+void ChipAnimator::start(int newIndex, QPointF const& pointBegin, QPointF const& pointEnd,
+                         int8_t player, int8_t enemy, QVector<int> const& captured, bool transfer){
+    this->newIndex = newIndex;
+    this->pointBegin = pointBegin;
+    this->pointEnd = pointEnd;
+    this->player = player;
+    this->enemy = enemy;
+    this->captured = captured;
+    moveDuration = transfer ? transferMoveDuration : addMoveDuration;
+    elapsed = 0;
+    active = true;
+    clock.start();                                          // Отсчет времени хода начинается заново.
+}
+/**
+ * @brief ChipAnimator::stop Метод остановки анимации.
+ */
+void ChipAnimator::stop(){
+    active = false;
+    captured.clear();
+    newIndex = -1;
+}
+/**
+ * @brief ChipAnimator::advance Метод перевода анимации на заданный момент времени от начала хода.
+ * @param time Время от начала хода, мс.
+ * @return Признак продолжения анимации, false - анимация закончена.
+ */
+bool ChipAnimator::advance(qint64 time){
+    if (!active){
+        return false;
+    }
+    elapsed = time;
+    if (elapsed >= totalDuration()){                        // Все этапы хода закончены.
+        stop();
+    }
+    return active;
+}
+/**
+ * @brief ChipAnimator::tick Метод перевода анимации на текущий момент времени.
+ * @return Признак продолжения анимации, false - анимация закончена.
+ */
+bool ChipAnimator::tick(){
+    return advance(clock.elapsed());
+}
+/**
+ * @brief ChipAnimator::isActive Метод возвращает признак выполнения анимации.
+ * @return true - анимация выполняется.
+ */
+bool ChipAnimator::isActive() const{
+    return active;
+}
+/**
+ * @brief ChipAnimator::isChipMoving Метод возвращает признак движения фишки к ячейке хода.
+ * @return true - фишка еще не достигла ячейки хода.
+ */
+bool ChipAnimator::isChipMoving() const{
+    return active && elapsed < moveDuration;
+}
+/**
+ * @brief ChipAnimator::chipCenter Метод вычисляет центр движущейся фишки.
+ * @return Координаты центра фишки.
+ */
+QPointF ChipAnimator::chipCenter() const{
+    double progress = moveCurve.valueForProgress(
+                std::min(1.0, double(elapsed) / moveDuration));
+    return pointBegin + (pointEnd - pointBegin) * progress;
+}
+/**
+ * @brief ChipAnimator::chipScale Метод вычисляет масштаб движущейся фишки. В середине пути фишка
+ * увеличивается, как будто поднимается над полем.
+ * @return Масштаб фишки относительно фишки на поле.
+ */
+double ChipAnimator::chipScale() const{
+    double progress = std::min(1.0, double(elapsed) / moveDuration);
+    return 1.0 + 0.5 * std::sin(M_PI * progress);
+}
+/**
+ * @brief ChipAnimator::chipPlayer Метод возвращает игрока, выполняющего ход.
+ * @return Номер игрока.
+ */
+int8_t ChipAnimator::chipPlayer() const{
+    return player;
+}
+/**
+ * @brief ChipAnimator::cellOverride Метод определяет отображение ячейки, участвующей в анимации.
+ * Ячейка хода остается пустой, пока фишка не долетит. Захваченные фишки переворачиваются по очереди:
+ * до середины переворота видна фишка противника, после - фишка игрока.
+ * @param [in] index Индекс ячейки.
+ * @param [out] shownPlayer Игрок, фишка которого отображается (0 - ячейка пустая).
+ * @param [out] scaleX Сжатие фишки по горизонтали.
+ * @return true - ячейка отображается по данным анимации, false - по состоянию поля.
+ */
+bool ChipAnimator::cellOverride(int index, int8_t& shownPlayer, double& scaleX) const{
+    if (!active){
+        return false;
+    }
+    if (index == newIndex && elapsed < moveDuration){       // Фишка еще в пути.
+        shownPlayer = 0;
+        scaleX = 1.0;
+        return true;
+    }
+    int order = captured.indexOf(index);                    // Очередь переворота фишки.
+    if (order < 0){
+        return false;
+    }
+    qint64 flipBegin = moveDuration + order * flipStagger;  // Начало переворота этой фишки.
+    double progress = double(elapsed - flipBegin) / flipDuration;
+    if (progress >= 1.0){                                   // Переворот закончен.
+        return false;
+    }
+    progress = flipCurve.valueForProgress(std::max(0.0, progress));
+    shownPlayer = progress < 0.5 ? enemy : player;
+    scaleX = std::abs(std::cos(M_PI * progress));
+    return true;
+}
+/**
+ * @brief ChipAnimator::totalDuration Метод вычисляет полную длительность анимации хода.
+ * @return Длительность, мс.
+ */
+qint64 ChipAnimator::totalDuration() const{
+    if (captured.isEmpty()){
+        return moveDuration;
+    }
+    return moveDuration + (captured.size() - 1) * flipStagger + flipDuration;
+}
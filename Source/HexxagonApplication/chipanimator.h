@@ -0,0 +1,62 @@
+﻿/**
+* @file chipanimator.h
+* @author Oleg2008e28
+* @date 19.10.2026 10:12:40
+* @brief Заголовочный файл класса ChipAnimator, вычисляющего состояние анимации хода фишки по прошедшему
+* времени: перемещение фишки с плавным разгоном и торможением и поочередный переворот захваченных фишек.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef CHIPANIMATOR_H
+#define CHIPANIMATOR_H
+#include <QVector>
+#include <QPointF>
+#include <QElapsedTimer>
+#include <QEasingCurve>
+#include <cstdint>
+/**
+ * @brief The ChipAnimator class Класс анимации хода. Положение фишки и состояние переворотов вычисляются
+ * по времени, прошедшему с начала хода, поэтому длительность анимации не зависит от размера окна и
+ * от точности срабатывания таймера обновления.
+ */
+class ChipAnimator{
+public:
+    ChipAnimator();                                     // Конструктор класса.
+    void start(int newIndex,
+               QPointF const& pointBegin,
+               QPointF const& pointEnd,
+               int8_t player, int8_t enemy,
+               QVector<int> const& captured,
+               bool transfer);                          // Запуск анимации хода.
+    void stop();                                        // Остановка анимации.
+    bool advance(qint64 time);                          // Перевод анимации на заданный момент времени.
+    bool tick();                                        // Перевод анимации на текущий момент времени.
+    bool isActive() const;                              // Признак выполнения анимации.
+    bool isChipMoving() const;                          // Признак отрисовки движущейся фишки.
+    QPointF chipCenter() const;                         // Центр движущейся фишки.
+    double chipScale() const;                           // Масштаб движущейся фишки.
+    int8_t chipPlayer() const;                          // Игрок, выполняющий ход.
+    bool cellOverride(int index, int8_t& shownPlayer,
+                      double& scaleX) const;            // Отображение ячейки, участвующей в анимации.
+    qint64 totalDuration() const;                       // Полная длительность анимации хода.
+//............................................................................................................
+public:
+    static const int addMoveDuration = 220;             //!Длительность ближнего хода, мс.
+    static const int transferMoveDuration = 320;        //!Длительность дальнего хода, мс.
+    static const int flipDuration = 180;                //!Длительность переворота одной фишки, мс.
+    static const int flipStagger = 50;                  //!Задержка между началом переворотов фишек, мс.
+//............................................................................................................
+private:
+    QElapsedTimer clock;                                // Таймер отсчета времени анимации.
+    QEasingCurve moveCurve;                             // Кривая разгона и торможения при перемещении.
+    QEasingCurve flipCurve;                             // Кривая переворота фишки.
+    QPointF pointBegin;                                 // Точка начала движения фишки.
+    QPointF pointEnd;                                   // Точка окончания движения фишки.
+    QVector<int> captured;                              // Индексы захваченных фишек в порядке переворота.
+    int newIndex = -1;                                  // Индекс ячейки хода.
+    int8_t player = 0;                                  // Игрок, выполняющий ход.
+    int8_t enemy = 0;                                   // Противник, фишки которого переворачиваются.
+    int moveDuration = addMoveDuration;                 // Длительность перемещения текущего хода.
+    qint64 elapsed = 0;                                 // Время, прошедшее с начала хода.
+    bool active = false;                                // Признак выполнения анимации.
+};
+#endif // CHIPANIMATOR_H
@@ -0,0 +1,53 @@
+# Ядро игры без графического интерфейса: геометрия поля, правила, запись позиций и партий, оценочная
+# функция. Подключается приложением и консольными программами.
+CONFIG += c++14 thread
+INCLUDEPATH += $$PWD
+
+# Количество 64-битных слов битовой позиции. Одного слова хватает для поля со стороной 5 (61 ячейка),
+# для сторон 6-7 нужно 2 слова, 8 - 3 слова, 9 - 4 слова.
+DEFINES += HEXBOARD_WORDS=1
+
+# Векторные команды AVX2 для нейросетевой оценки: qmake CONFIG+=hexavx2. Без них используется
+# скалярный код.
+hexavx2 {
+    QMAKE_CXXFLAGS += -mavx2
+}
+
+# Трассировка интервалов и выделений памяти в формате Chrome Trace Event: qmake CONFIG+=hextrace.
+# Без нее макросы HEX_TRACE_* не порождают кода. Библиотеки собираются без трассировки: подмена malloc
+# и TLS initial-exec в загружаемой через dlopen библиотеке перехватили бы распределитель памяти
+# процесса или не дали бы ее загрузить.
+hextrace:!equals(TEMPLATE, lib) {
+    DEFINES += HEXTRACE
+}
+
+SOURCES += \
+    $$PWD/gamedatabase.cpp \
+    $$PWD/gamerecord.cpp \
+    $$PWD/hexboard.cpp \
+    $$PWD/hexevaluation.cpp \
+    $$PWD/hexmcts.cpp \
+    $$PWD/hexnnue.cpp \
+    $$PWD/hexntuple.cpp \
+    $$PWD/hexnotation.cpp \
+    $$PWD/hexprofile.cpp \
+    $$PWD/hexsearch.cpp \
+    $$PWD/hexsolver.cpp \
+    $$PWD/hexsuite.cpp \
+    $$PWD/hextrace.cpp
+
+HEADERS += \
+    $$PWD/gamedatabase.h \
+    $$PWD/gamerecord.h \
+    $$PWD/hexbitset.h \
+    $$PWD/hexboard.h \
+    $$PWD/hexevaluation.h \
+    $$PWD/hexmcts.h \
+    $$PWD/hexnnue.h \
+    $$PWD/hexntuple.h \
+    $$PWD/hexnotation.h \
+    $$PWD/hexprofile.h \
+    $$PWD/hexsearch.h \
+    $$PWD/hexsolver.h \
+    $$PWD/hexsuite.h \
+    $$PWD/hextrace.h
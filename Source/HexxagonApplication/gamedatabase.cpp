@@ -0,0 +1,346 @@
+﻿/**
+* @file gamedatabase.cpp
+* @author Oleg2008e28
+* @date 20.10.2026 16:42:19
+* @brief Файл реализации методов классов MappedFile и GameDatabase.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "gamedatabase.h"
+#include "hexsearch.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+const char GameDatabase::fileMagic[8] = {'H', 'X', 'G', 'I', 1, 0, 0, 0};
+const int GameDatabase::bucketBits;
+const size_t GameDatabase::defaultHitLimit;
+/**
+ * @brief mixKey Функция перемешивания битов 64-битного числа (финализатор splitmix64).
+ * @param z Число.
+ * @return Перемешанное число.
+ */
+static uint64_t mixKey(uint64_t z){
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+/**
+ * @brief parallelFor Функция делит диапазон на равные непрерывные части и вызывает функцию для каждой
+ * части в отдельном потоке.
+ * @param threads Количество потоков.
+ * @param count Размер диапазона.
+ * @param f Функция, принимающая номер части, начало и конец части.
+ */
+template<class F>
+static void parallelFor(int threads, size_t count, F f){
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++){
+        pool.emplace_back(f, t, count * t / threads, count * (t + 1) / threads);
+    }
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+}
+//............................................................................................................
+//............................................... MappedFile ..................................................
+//............................................................................................................
+/**
+ * @brief MappedFile::~MappedFile Деструктор, закрывает отображение.
+ */
+MappedFile::~MappedFile(){
+    close();
+}
+/**
+ * @brief MappedFile::open Метод отображает файл в память только для чтения.
+ * @param fileName Имя файла.
+ * @return true - файл отображен, false - файла нет или он пуст.
+ */
+bool MappedFile::open(std::string const& fileName){
+    close();
+#ifdef _WIN32
+    file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0){
+        if (file == INVALID_HANDLE_VALUE) file = nullptr;
+        close();
+        return false;
+    }
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view){
+        close();
+        return false;
+    }
+    bytes = static_cast<uint8_t const*>(view);
+    length = size_t(fileSize.QuadPart);
+#else
+    int descriptor = ::open(fileName.c_str(), O_RDONLY);
+    struct stat status;
+    if (descriptor < 0 || fstat(descriptor, &status) != 0 || status.st_size == 0){
+        if (descriptor >= 0) ::close(descriptor);
+        return false;
+    }
+    void* view = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);                                    // Отображение не зависит от дескриптора.
+    if (view == MAP_FAILED){
+        return false;
+    }
+    bytes = static_cast<uint8_t const*>(view);
+    length = size_t(status.st_size);
+#endif
+    return true;
+}
+/**
+ * @brief MappedFile::close Метод закрывает отображение.
+ */
+void MappedFile::close(){
+#ifdef _WIN32
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mapping) CloseHandle(mapping);
+    if (file) CloseHandle(file);
+    mapping = nullptr;
+    file = nullptr;
+#else
+    if (bytes) munmap(const_cast<uint8_t*>(bytes), length);
+#endif
+    bytes = nullptr;
+    length = 0;
+}
+uint8_t const* MappedFile::data() const{ return bytes; }
+size_t MappedFile::size() const{ return length; }
+//............................................................................................................
+//.............................................. GameDatabase .................................................
+//............................................................................................................
+/**
+ * @brief GameDatabase::build Метод строит индекс файла партий. Партии восстанавливаются в нескольких
+ * потоках, каждый поток считает записи своих партий по корзинам. По этим счетчикам каждый поток
+ * раскладывает свои записи в общий массив без блокировок, затем корзины сортируются параллельно.
+ * Поврежденные партии получают номер, но не дают записей.
+ * @param recordFile Файл партий.
+ * @param indexFile Файл индекса, заменяется.
+ * @param threads Количество потоков.
+ * @param [out] error Описание ошибки.
+ * @return true - индекс записан.
+ */
+bool GameDatabase::build(std::string const& recordFile, std::string const& indexFile, int threads,
+                         std::string& error){
+    GameRecordReader reader(recordFile);
+    if (!reader.isOpen()){
+        error = "неверный файл партий " + recordFile;
+        return false;
+    }
+    std::vector<GameRecord> records;                        // Партии читаются последовательно,
+    std::vector<uint64_t> gameOffsets;                      // восстанавливаются параллельно.
+    for (;;){
+        uint64_t offset = reader.offset();
+        GameRecord record;
+        if (!reader.next(record)) break;
+        records.push_back(std::move(record));
+        gameOffsets.push_back(offset);
+    }
+    threads = std::max(1, threads);
+    size_t bucketCount = size_t(1) << bucketBits;
+    int shift = 64 - bucketBits;
+    std::vector<std::vector<DatabaseEntry>> parts(threads); // Записи партий каждого потока.
+    std::vector<std::vector<uint64_t>> counts(threads, std::vector<uint64_t>(bucketCount, 0));
+    parallelFor(threads, records.size(), [&](int t, size_t begin, size_t end){
+        HexBoard board;
+        std::vector<Position> positions;
+        std::vector<Move> moves;
+        for (size_t game = begin; game < end; game++){
+            if (!records[game].replay(board, positions, moves)) continue;
+            for (size_t ply = 0; ply < positions.size(); ply++){
+                DatabaseEntry entry{positionKey(board, positions[ply]), uint32_t(game), uint16_t(ply),
+                                    records[game].result, 0};
+                parts[t].push_back(entry);
+                counts[t][entry.key >> shift]++;
+            }
+        }
+    });
+    records.clear();
+    std::vector<uint64_t> starts(bucketCount + 1, 0);       // Начала корзин в общем массиве.
+    for (size_t b = 0; b < bucketCount; b++){
+        uint64_t bucketStart = starts[b];
+        for (int t = 0; t < threads; t++){                  // Счетчик потока становится
+            uint64_t count = counts[t][b];                  // его позицией записи в корзине.
+            counts[t][b] = bucketStart;
+            bucketStart += count;
+        }
+        starts[b + 1] = bucketStart;
+    }
+    std::vector<DatabaseEntry> entries(starts[bucketCount]);
+    parallelFor(threads, size_t(threads), [&](int t, size_t, size_t){
+        for (DatabaseEntry const& entry : parts[t]){
+            entries[counts[t][entry.key >> shift]++] = entry;
+        }
+        std::vector<DatabaseEntry>().swap(parts[t]);
+    });
+    parallelFor(threads, bucketCount, [&](int, size_t begin, size_t end){
+        for (size_t b = begin; b < end; b++){
+            std::sort(entries.begin() + starts[b], entries.begin() + starts[b + 1],
+                      [](DatabaseEntry const& x, DatabaseEntry const& y){
+                return x.key != y.key ? x.key < y.key : x.game != y.game ? x.game < y.game : x.ply < y.ply;
+            });
+        }
+    });
+    IndexHeader header;
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.bucketBits = bucketBits;
+    header.entrySize = sizeof(DatabaseEntry);
+    header.games = gameOffsets.size();
+    header.entries = entries.size();
+    header.recordSize = fileSize(recordFile);
+    std::string temporary = indexFile + ".tmp";             // Открытый старый индекс не портится.
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(gameOffsets.data()), std::streamsize(gameOffsets.size() * 8));
+    file.write(reinterpret_cast<char const*>(starts.data()), std::streamsize(starts.size() * 8));
+    file.write(reinterpret_cast<char const*>(entries.data()),
+               std::streamsize(entries.size() * sizeof(DatabaseEntry)));
+    file.close();
+    if (!file){
+        std::remove(temporary.c_str());
+        error = "не удалось записать " + indexFile;
+        return false;
+    }
+    std::remove(indexFile.c_str());
+    if (std::rename(temporary.c_str(), indexFile.c_str()) != 0){
+        error = "не удалось заменить " + indexFile;
+        return false;
+    }
+    return true;
+}
+/**
+ * @brief GameDatabase::open Метод открывает базу: отображает индекс в память и проверяет, что он
+ * построен по текущему файлу партий.
+ * @param recordFile Файл партий.
+ * @param indexFile Файл индекса.
+ * @return true - база открыта, false - индекса нет, он поврежден или устарел.
+ */
+bool GameDatabase::open(std::string const& recordFile, std::string const& indexFile){
+    close();
+    if (!index.open(indexFile) || index.size() < sizeof(IndexHeader)){
+        close();
+        return false;
+    }
+    IndexHeader header;
+    std::memcpy(&header, index.data(), sizeof(header));
+    size_t bucketCount = size_t(1) << bucketBits;
+    uint64_t expected = sizeof(IndexHeader) + header.games * 8 + (bucketCount + 1) * 8
+            + header.entries * sizeof(DatabaseEntry);
+    if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.bucketBits != bucketBits
+            || header.entrySize != sizeof(DatabaseEntry) || expected != index.size()
+            || header.recordSize != fileSize(recordFile)){
+        close();
+        return false;
+    }
+    this->recordFile = recordFile;
+    games = header.games;
+    entries = header.entries;
+    offsets = reinterpret_cast<uint64_t const*>(index.data() + sizeof(IndexHeader));
+    buckets = offsets + games;
+    table = reinterpret_cast<DatabaseEntry const*>(buckets + bucketCount + 1);
+    return true;
+}
+/**
+ * @brief GameDatabase::close Метод закрывает базу.
+ */
+void GameDatabase::close(){
+    index.close();
+    recordFile.clear();
+    games = 0;
+    entries = 0;
+    offsets = nullptr;
+    buckets = nullptr;
+    table = nullptr;
+}
+bool GameDatabase::isOpen() const{ return table != nullptr; }
+uint64_t GameDatabase::gameCount() const{ return games; }
+uint64_t GameDatabase::entryCount() const{ return entries; }
+/**
+ * @brief GameDatabase::lookup Метод находит партии, прошедшие через позицию. Партия, в которой позиция
+ * повторялась, считается один раз с первым повторением.
+ * @param board Геометрия поля.
+ * @param position Позиция, включая игрока, который ходит.
+ * @param hitLimit Наибольшее количество партий в списке hits, статистика считается по всем.
+ * @return Статистика результатов и партии по возрастанию номеров.
+ */
+PositionStats GameDatabase::lookup(HexBoard const& board, Position const& position, size_t hitLimit) const{
+    PositionStats stats;
+    if (!isOpen()){
+        return stats;
+    }
+    uint64_t key = positionKey(board, position);
+    uint64_t bucket = key >> (64 - bucketBits);
+    DatabaseEntry const* last = table + buckets[bucket + 1];
+    DatabaseEntry const* entry = std::lower_bound(table + buckets[bucket], last, key,
+                                                  [](DatabaseEntry const& e, uint64_t k){ return e.key < k; });
+    int64_t previous = -1;                                  // Партия предыдущей записи.
+    for (; entry != last && entry->key == key; ++entry){
+        if (entry->game == previous){                       // Повтор позиции в той же партии.
+            continue;
+        }
+        previous = entry->game;
+        stats.games++;
+        if (entry->result == 1 || entry->result == 2){
+            stats.wins[entry->result - 1]++;
+        } else if (entry->result == 0){
+            stats.draws++;
+        } else {
+            stats.unfinished++;
+        }
+        if (stats.hits.size() < hitLimit){
+            stats.hits.push_back(DatabaseHit{entry->game, entry->ply, entry->result});
+        }
+    }
+    return stats;
+}
+/**
+ * @brief GameDatabase::readGame Метод читает партию по номеру из файла партий.
+ * @param game Номер партии.
+ * @param [out] record Партия.
+ * @return true - партия прочитана.
+ */
+bool GameDatabase::readGame(uint32_t game, GameRecord& record) const{
+    if (!isOpen() || game >= games){
+        return false;
+    }
+    GameRecordReader reader(recordFile);
+    return reader.seek(offsets[game]) && reader.next(record);
+}
+/**
+ * @brief GameDatabase::positionKey Метод вычисляет ключ позиции: ключ Зобриста фишек и очереди хода,
+ * смешанный с ключом геометрии поля, чтобы одинаковые множества фишек на разных полях не совпадали.
+ * @param board Геометрия поля.
+ * @param position Позиция.
+ * @return Ключ.
+ */
+uint64_t GameDatabase::positionKey(HexBoard const& board, Position const& position){
+    static const ZobristKeys keys;
+    uint64_t geometry = mixKey(uint64_t(board.side()));
+    for (int i = 0; i < Bitboard::wordCount; i++){
+        geometry = mixKey(geometry ^ board.blocked().w[i]);
+    }
+    return keys.key(position) ^ geometry;
+}
+//............................................................................................................
+/**
+ * @brief GameDatabase::fileSize Метод возвращает размер файла.
+ * @param fileName Имя файла.
+ * @return Размер, байт, или 0, если файла нет.
+ */
+uint64_t GameDatabase::fileSize(std::string const& fileName){
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    return file ? uint64_t(file.tellg()) : 0;
+}
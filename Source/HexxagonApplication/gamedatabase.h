@@ -0,0 +1,127 @@
+﻿/**
+* @file gamedatabase.h
+* @author Oleg2008e28
+* @date 20.10.2026 16:10:44
+* @brief Заголовочный файл класса GameDatabase - базы сыгранных партий: файл партий GameRecordWriter
+* дополняется индексом позиций, по которому находятся партии, прошедшие через позицию, и их результаты.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef GAMEDATABASE_H
+#define GAMEDATABASE_H
+#include "gamerecord.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The DatabaseEntry struct Запись индекса: позиция партии перед ходом ply.
+ */
+struct DatabaseEntry {
+    uint64_t key;                                       //!Ключ позиции (GameDatabase::positionKey).
+    uint32_t game;                                      //!Номер партии в файле партий, с нуля.
+    uint16_t ply;                                       //!Количество ходов партии до позиции.
+    int8_t result;                                      //!Результат партии (как GameRecord::result).
+    uint8_t reserved;                                   //!Не используется.
+};
+/**
+ * @brief The DatabaseHit struct Партия, прошедшая через позицию.
+ */
+struct DatabaseHit {
+    uint32_t game;                                      //!Номер партии.
+    uint16_t ply;                                       //!Количество ходов до позиции.
+    int8_t result;                                      //!Результат партии.
+};
+/**
+ * @brief The PositionStats struct Результаты партий, прошедших через позицию.
+ */
+struct PositionStats {
+    uint32_t games = 0;                                 //!Количество партий.
+    uint32_t wins[2] = {0, 0};                          //!Победы игроков 1 и 2.
+    uint32_t draws = 0;                                 //!Ничьи.
+    uint32_t unfinished = 0;                            //!Незаконченные партии.
+    std::vector<DatabaseHit> hits;                      //!Первые партии по номерам.
+};
+//............................................................................................................
+/**
+ * @brief The MappedFile class Файл, отображенный в память только для чтения.
+ */
+class MappedFile{
+public:
+    MappedFile() = default;
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    ~MappedFile();                                      // Закрытие отображения.
+    bool open(std::string const& fileName);             // Отображение файла.
+    void close();                                       // Закрытие отображения.
+    uint8_t const* data() const;                        // Начало отображения.
+    size_t size() const;                                // Размер файла.
+private:
+    uint8_t const* bytes = nullptr;                     // Начало отображения.
+    size_t length = 0;                                  // Размер файла.
+#ifdef _WIN32
+    void* file = nullptr;                               // Дескриптор файла.
+    void* mapping = nullptr;                            // Дескриптор отображения.
+#endif
+};
+//............................................................................................................
+/**
+ * @brief The GameDatabase class База партий: файл партий и файл индекса позиций.
+ *
+ * Файл партий только дополняется, номер партии - ее порядковый номер в файле. Индекс строится по файлу
+ * партий заново и помнит размер файла, по которому построен, поэтому устаревший индекс обнаруживается
+ * при открытии. Индекс отображается в память и не читается целиком.
+ *
+ * Файл индекса: заголовок IndexHeader, смещения партий в файле партий (uint64 на партию), начала
+ * корзин (uint64, 2^bucketBits + 1 чисел - номера первых записей корзин), записи DatabaseEntry,
+ * упорядоченные по ключу, номеру партии и ходу. Корзина записи - старшие bucketBits битов ключа, поэтому
+ * поиск позиции - двоичный поиск внутри одной корзины. Числа записаны в порядке байт процессора
+ * (little-endian на всех поддерживаемых платформах).
+ */
+class GameDatabase{
+public:
+    static bool build(std::string const& recordFile,
+                      std::string const& indexFile,
+                      int threads,
+                      std::string& error);              // Построение индекса.
+    bool open(std::string const& recordFile,
+              std::string const& indexFile);            // Открытие базы.
+    void close();                                       // Закрытие базы.
+    bool isOpen() const;                                // Признак открытой базы.
+    uint64_t gameCount() const;                         // Количество партий в индексе.
+    uint64_t entryCount() const;                        // Количество позиций в индексе.
+    PositionStats lookup(HexBoard const& board,
+                         Position const& position,
+                         size_t hitLimit = defaultHitLimit) const;// Партии, прошедшие через позицию.
+    bool readGame(uint32_t game,
+                  GameRecord& record) const;            // Чтение партии по номеру.
+    static uint64_t positionKey(HexBoard const& board,
+                                Position const& position);// Ключ позиции с учетом геометрии поля.
+//............................................................................................................
+public:
+    static const char fileMagic[8];                     //!Заголовок файла индекса.
+    static const int bucketBits = 16;                   //!Количество старших битов ключа номера корзины.
+    static const size_t defaultHitLimit = 100;          //!Количество партий в результате поиска.
+//............................................................................................................
+private:
+    /**
+     * @brief The IndexHeader struct Заголовок файла индекса.
+     */
+    struct IndexHeader {
+        char magic[8];                                  //!Заголовок fileMagic.
+        uint32_t bucketBits;                            //!Количество битов номера корзины.
+        uint32_t entrySize;                             //!Размер записи, байт.
+        uint64_t games;                                 //!Количество партий.
+        uint64_t entries;                               //!Количество записей.
+        uint64_t recordSize;                            //!Размер файла партий при построении, байт.
+    };
+    static uint64_t fileSize(std::string const& fileName);// Размер файла или 0.
+private:
+    MappedFile index;                                   // Отображение файла индекса.
+    std::string recordFile;                             // Имя файла партий.
+    uint64_t games = 0;                                 // Количество партий.
+    uint64_t entries = 0;                               // Количество записей.
+    uint64_t const* offsets = nullptr;                  // Смещения партий в файле партий.
+    uint64_t const* buckets = nullptr;                  // Начала корзин.
+    DatabaseEntry const* table = nullptr;               // Записи индекса.
+};
+#endif // GAMEDATABASE_H
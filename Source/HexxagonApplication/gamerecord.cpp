@@ -0,0 +1,405 @@
+﻿/**
+* @file gamerecord.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 14:31:12
+* @brief Файл реализации методов классов GameRecord, GameRecordWriter и GameRecordReader.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "gamerecord.h"
+#include <algorithm>
+#include <cstring>
+const uint16_t GameRecord::annotatedFlag;
+const uint8_t GameRecord::humanDepth;
+const size_t GameRecordWriter::defaultBufferSize;
+const int GameRecordWriter::maxPendingBuffers;
+const char GameRecordWriter::fileMagic[8] = {'H', 'X', 'G', 'R', 1, 0, 0, 0};
+/**
+ * @brief jumpOffsets Смещения дальних ходов в осевых координатах, направление i кодируется числом i+1.
+ */
+static const int jumpOffsets[12][2] = {{-2, 0}, {-2, 1}, {-2, 2}, {-1, -1}, {-1, 2}, {0, -2},
+                                       {0, 2}, {1, -2}, {1, 1}, {2, -2}, {2, -1}, {2, 0}};
+/**
+ * @brief putLE Функция добавляет в буфер число в порядке little-endian.
+ * @param out Буфер.
+ * @param value Число.
+ * @param bytes Количество байт числа.
+ */
+static void putLE(std::vector<uint8_t>& out, uint32_t value, int bytes){
+    for (int i = 0; i < bytes; i++){
+        out.push_back(uint8_t(value >> (8 * i)));
+    }
+}
+/**
+ * @brief getLE Функция читает из буфера число в порядке little-endian.
+ * @param data Буфер.
+ * @param offset Смещение числа, после чтения указывает на следующий байт.
+ * @param bytes Количество байт числа.
+ * @return Число.
+ */
+static uint32_t getLE(std::vector<uint8_t> const& data, size_t& offset, int bytes){
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++){
+        value |= uint32_t(data[offset++]) << (8 * i);
+    }
+    return value;
+}
+//............................................................................................................
+//.......................................... GameRecord ......................................................
+//............................................................................................................
+/**
+ * @brief GameRecord::begin Метод начинает запись новой партии.
+ * @param board Геометрия игрового поля.
+ * @param position Стартовая позиция, в ней же игрок, который ходит первым.
+ * @param depth_1 Глубина поиска игрока 1, -1 - человек.
+ * @param depth_2 Глубина поиска игрока 2, -1 - человек.
+ */
+void GameRecord::begin(HexBoard const& board, Position const& position, int depth_1, int depth_2){
+    startPosition = Notation::pack(board, position);
+    depth[0] = depth_1 < 0 ? humanDepth : uint8_t(depth_1);
+    depth[1] = depth_2 < 0 ? humanDepth : uint8_t(depth_2);
+    result = -1;
+    moves.clear();
+}
+/**
+ * @brief GameRecord::addMove Метод добавляет в партию ход без оценки.
+ * @param board Геометрия игрового поля.
+ * @param move Ход.
+ */
+void GameRecord::addMove(HexBoard const& board, Move const& move){
+    moves.push_back(RecordMove{encodeMove(board, move), 0, 0});
+}
+/**
+ * @brief GameRecord::addMove Метод добавляет в партию ход с оценкой движка и временем выбора хода.
+ * Оценка и время ограничиваются диапазоном 16-битных чисел.
+ * @param board Геометрия игрового поля.
+ * @param move Ход.
+ * @param score Оценка хода.
+ * @param time Время выбора хода, мс.
+ */
+void GameRecord::addMove(HexBoard const& board, Move const& move, int score, int time){
+    moves.push_back(RecordMove{uint16_t(encodeMove(board, move) | annotatedFlag),
+                               int16_t(std::max(-32767, std::min(score, 32767))),
+                               uint16_t(std::max(0, std::min(time, 65535)))});
+}
+/**
+ * @brief GameRecord::serialize Метод добавляет запись партии в конец буфера.
+ * @param out Буфер.
+ */
+void GameRecord::serialize(std::vector<uint8_t>& out) const{
+    size_t sizeOffset = out.size();
+    putLE(out, 0, 4);                                       // Размер записи заполняется в конце.
+    out.push_back(uint8_t(result));
+    out.push_back(depth[0]);
+    out.push_back(depth[1]);
+    out.insert(out.end(), startPosition.begin(), startPosition.end());
+    putLE(out, uint32_t(moves.size()), 2);
+    for (RecordMove const& move : moves){
+        putLE(out, move.code, 2);
+        if (move.code & annotatedFlag){
+            putLE(out, uint16_t(move.score), 2);
+            putLE(out, move.time, 2);
+        }
+    }
+    uint32_t size = uint32_t(out.size() - sizeOffset - 4);
+    for (int i = 0; i < 4; i++){
+        out[sizeOffset + i] = uint8_t(size >> (8 * i));
+    }
+}
+/**
+ * @brief GameRecord::deserialize Метод читает запись партии из буфера.
+ * @param data Буфер.
+ * @param offset Смещение записи, после чтения указывает на следующую запись.
+ * @return true - партия прочитана, false - запись повреждена.
+ */
+bool GameRecord::deserialize(std::vector<uint8_t> const& data, size_t& offset){
+    if (data.size() - offset < 4){
+        return false;
+    }
+    size_t end = offset + 4 + getLE(data, offset, 4);       // Конец записи партии.
+    if (end > data.size() || end - offset < 3 + Notation::packedHeaderSize){
+        return false;
+    }
+    result = int8_t(data[offset++]);
+    depth[0] = data[offset++];
+    depth[1] = data[offset++];
+    size_t packedSize = Notation::packedHeaderSize
+            + (HexBoard::cellCountForSide(data[offset]) + 3) / 4;
+    if (end - offset < packedSize + 2){
+        return false;
+    }
+    startPosition.assign(data.begin() + offset, data.begin() + offset + packedSize);
+    offset += packedSize;
+    int count = int(getLE(data, offset, 2));
+    moves.clear();
+    for (int i = 0; i < count; i++){
+        if (end - offset < 2){
+            return false;
+        }
+        RecordMove move{uint16_t(getLE(data, offset, 2)), 0, 0};
+        if (move.code & annotatedFlag){
+            if (end - offset < 4){
+                return false;
+            }
+            move.score = int16_t(getLE(data, offset, 2));
+            move.time = uint16_t(getLE(data, offset, 2));
+        }
+        moves.push_back(move);
+    }
+    offset = end;
+    return true;
+}
+/**
+ * @brief GameRecord::replay Метод восстанавливает позиции и ходы партии.
+ * @param [out] board Геометрия игрового поля партии.
+ * @param [out] positions Позиции перед каждым ходом и конечная позиция.
+ * @param [out] moves Ходы партии.
+ * @return true - партия восстановлена, false - запись не соответствует правилам.
+ */
+bool GameRecord::replay(HexBoard& board, std::vector<Position>& positions, std::vector<Move>& moves) const{
+    Position position;
+    if (!Notation::unpack(startPosition, board, position)){
+        return false;
+    }
+    positions.assign(1, position);
+    moves.clear();
+    for (RecordMove const& recordMove : this->moves){
+        Move move;
+        if (!decodeMove(board, position, recordMove.code, move)){
+            return false;
+        }
+        board.doMove(position, move);
+        moves.push_back(move);
+        positions.push_back(position);
+    }
+    return true;
+}
+/**
+ * @brief GameRecord::encodeMove Метод вычисляет код хода.
+ * @param board Геометрия игрового поля.
+ * @param move Ход.
+ * @return Код хода без признака оценки.
+ */
+uint16_t GameRecord::encodeMove(HexBoard const& board, Move const& move){
+    int direction = 0;                                      // Ближний ход.
+    if (move.clearBeginPostion){
+        int dq = board.axialQ(move.newPostion) - board.axialQ(move.beginPostion);
+        int dr = board.axialR(move.newPostion) - board.axialR(move.beginPostion);
+        for (int i = 0; i < 12; i++){
+            if (jumpOffsets[i][0] == dq && jumpOffsets[i][1] == dr) direction = i + 1;
+        }
+    }
+    return uint16_t(move.newPostion | (direction << 8));
+}
+/**
+ * @brief GameRecord::decodeMove Метод восстанавливает ход по коду и проверяет, что ход возможен.
+ * @param [in] board Геометрия игрового поля.
+ * @param [in] position Позиция перед ходом.
+ * @param [in] code Код хода.
+ * @param [out] move Ход.
+ * @return true - ход восстановлен, false - код ошибочен.
+ */
+bool GameRecord::decodeMove(HexBoard const& board, Position const& position, uint16_t code, Move& move){
+    int end = code & 0xFF;
+    int direction = (code >> 8) & 0x0F;
+    Bitboard const& own = position.chips[position.player - 1];
+    if (end >= board.cellCount() || direction > 12 || !board.emptyCells(position).test(end)){
+        return false;
+    }
+    if (direction == 0){                                    // Ближний ход из любой соседней фишки.
+        int begin = (board.nearMask(end) & own).first();
+        move = Move{int16_t(begin), int16_t(end), false};
+        return begin >= 0;
+    }
+    int begin = board.indexOf(board.axialQ(end) - jumpOffsets[direction - 1][0],
+                              board.axialR(end) - jumpOffsets[direction - 1][1]);
+    move = Move{int16_t(begin), int16_t(end), true};
+    return begin >= 0 && own.test(begin);
+}
+//............................................................................................................
+//....................................... GameRecordWriter ...................................................
+//............................................................................................................
+/**
+ * @brief GameRecordWriter::GameRecordWriter Конструктор открывает файл партий на дозапись и запускает
+ * поток записи. В новый файл записывается заголовок.
+ * @param fileName Имя файла.
+ * @param bufferSize Размер буфера, после заполнения которого партии записываются на диск.
+ */
+GameRecordWriter::GameRecordWriter(std::string const& fileName, size_t bufferSize)
+    : file(fileName, std::ios::binary | std::ios::app), fileName(fileName), bufferSize(bufferSize){
+    file.seekp(0, std::ios::end);
+    if (file.is_open() && file.tellp() == std::streampos(0)){
+        file.write(fileMagic, sizeof(fileMagic));
+        if (!file.flush()){                                 // Заголовок не записан - файл непригоден.
+            file.close();
+        }
+    }
+    pending.reserve(bufferSize);
+    writing.reserve(bufferSize);
+    worker = std::thread(&GameRecordWriter::run, this);
+}
+/**
+ * @brief GameRecordWriter::~GameRecordWriter Деструктор записывает оставшиеся партии и закрывает файл.
+ */
+GameRecordWriter::~GameRecordWriter(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeWriter.notify_one();
+    worker.join();
+}
+/**
+ * @brief GameRecordWriter::isOpen Метод возвращает признак открытого файла.
+ * @return true - файл открыт.
+ */
+bool GameRecordWriter::isOpen() const{
+    return file.is_open();
+}
+/**
+ * @brief GameRecordWriter::append Метод добавляет партию. Партия кодируется в вызывающем потоке вне
+ * блокировки, под блокировкой выполняется только копирование в буфер. Запись на диск выполняется позже,
+ * поэтому ошибка записи обнаруживается при добавлении одной из следующих партий или в flush().
+ * @param record Партия.
+ * @return false - запись в файл завершилась ошибкой, партия не добавлена.
+ */
+bool GameRecordWriter::append(GameRecord const& record){
+    std::vector<uint8_t> bytes;
+    record.serialize(bytes);
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeClients.wait(lock, [this]{                          // Ожидание, только если диск не успевает.
+        return failed || pending.size() < bufferSize * maxPendingBuffers;
+    });
+    if (failed){
+        return false;
+    }
+    pending.insert(pending.end(), bytes.begin(), bytes.end());
+    appended++;
+    pendingGames++;
+    if (pending.size() >= bufferSize){
+        wakeWriter.notify_one();
+    }
+    return true;
+}
+/**
+ * @brief GameRecordWriter::flush Метод ожидает записи на диск всех добавленных партий.
+ * @return false - запись в файл завершилась ошибкой, часть партий не записана.
+ */
+bool GameRecordWriter::flush(){
+    std::unique_lock<std::mutex> lock(mutex);
+    flushRequested = true;
+    wakeWriter.notify_one();
+    wakeClients.wait(lock, [this]{ return failed || written == appended; });
+    return !failed;
+}
+/**
+ * @brief GameRecordWriter::error Метод возвращает описание ошибки записи.
+ * @return Описание ошибки, пустая строка - ошибок не было.
+ */
+std::string GameRecordWriter::error(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed ? "не удалось записать " + fileName : std::string();
+}
+/**
+ * @brief GameRecordWriter::gameCount Метод возвращает количество добавленных партий.
+ * @return Количество партий.
+ */
+uint64_t GameRecordWriter::gameCount(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return appended;
+}
+/**
+ * @brief GameRecordWriter::run Цикл потока записи: буфер ожидания меняется местами с буфером записи,
+ * и пока буфер записи пишется на диск, партии добавляются в освободившийся буфер ожидания. Состояние
+ * потока проверяется после каждой записи; после ошибки партии больше не пишутся, чтобы не дописывать
+ * их за оборванной записью, а ожидающие потоки будятся и получают отказ.
+ */
+void GameRecordWriter::run(){
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;){
+        wakeWriter.wait(lock, [this]{
+            return stopping || flushRequested || pending.size() >= bufferSize;
+        });
+        if (pending.empty() || failed){
+            pending.clear();
+            pendingGames = 0;
+            flushRequested = false;
+            wakeClients.notify_all();
+            if (stopping) break;
+            continue;
+        }
+        std::swap(pending, writing);
+        uint64_t games = pendingGames;
+        pendingGames = 0;
+        lock.unlock();
+        wakeClients.notify_all();                           // Буфер ожидания снова свободен.
+        file.write(reinterpret_cast<char const*>(writing.data()), std::streamsize(writing.size()));
+        bool good = bool(file.flush());
+        writing.clear();
+        lock.lock();
+        if (good){
+            written += games;
+        } else {
+            failed = true;
+        }
+        wakeClients.notify_all();
+    }
+}
+//............................................................................................................
+//....................................... GameRecordReader ...................................................
+//............................................................................................................
+/**
+ * @brief GameRecordReader::GameRecordReader Конструктор открывает файл партий и проверяет заголовок.
+ * @param fileName Имя файла.
+ */
+GameRecordReader::GameRecordReader(std::string const& fileName) : file(fileName, std::ios::binary){
+    char magic[sizeof(GameRecordWriter::fileMagic)];
+    valid = file.read(magic, sizeof(magic))
+            && std::memcmp(magic, GameRecordWriter::fileMagic, sizeof(magic)) == 0;
+}
+/**
+ * @brief GameRecordReader::isOpen Метод возвращает признак открытого файла с верным заголовком.
+ * @return true - файл можно читать.
+ */
+bool GameRecordReader::isOpen() const{
+    return valid;
+}
+/**
+ * @brief GameRecordReader::next Метод читает очередную партию.
+ * @param record Партия.
+ * @return true - партия прочитана, false - конец файла или поврежденная запись.
+ */
+bool GameRecordReader::next(GameRecord& record){
+    uint8_t sizeBytes[4];
+    if (!valid || !file.read(reinterpret_cast<char*>(sizeBytes), 4)){
+        return false;
+    }
+    uint32_t size = uint32_t(sizeBytes[0]) | uint32_t(sizeBytes[1]) << 8
+            | uint32_t(sizeBytes[2]) << 16 | uint32_t(sizeBytes[3]) << 24;
+    std::vector<uint8_t> data(sizeBytes, sizeBytes + 4);
+    data.resize(4 + size);
+    if (!file.read(reinterpret_cast<char*>(data.data() + 4), size)){
+        return false;
+    }
+    size_t offset = 0;
+    return record.deserialize(data, offset);
+}
+/**
+ * @brief GameRecordReader::offset Метод возвращает смещение от начала файла партии, которую прочитает
+ * следующий вызов next.
+ * @return Смещение, байт.
+ */
+uint64_t GameRecordReader::offset(){
+    return valid ? uint64_t(file.tellg()) : 0;
+}
+/**
+ * @brief GameRecordReader::seek Метод переходит к партии по смещению, полученному методом offset.
+ * @param offset Смещение партии от начала файла.
+ * @return true - переход выполнен.
+ */
+bool GameRecordReader::seek(uint64_t offset){
+    if (!valid || offset < sizeof(GameRecordWriter::fileMagic)){
+        return false;
+    }
+    file.clear();
+    return bool(file.seekg(std::streamoff(offset)));
+}
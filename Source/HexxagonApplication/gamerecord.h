@@ -0,0 +1,125 @@
+﻿/**
+* @file gamerecord.h
+* @author Oleg2008e28
+* @date 19.10.2026 14:02:37
+* @brief Заголовочный файл классов записи сыгранных партий: GameRecord - партия (стартовая позиция, ходы,
+* результат), GameRecordWriter - буферизованная запись партий в файл в отдельном потоке,
+* GameRecordReader - чтение файла партий.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+#include "hexnotation.h"
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The RecordMove struct Ход партии в записи.
+ */
+struct RecordMove {
+    uint16_t code;                                      //!Код хода (см. GameRecord::encodeMove).
+    int16_t score;                                      //!Оценка хода движком.
+    uint16_t time;                                      //!Время выбора хода, мс.
+};
+//............................................................................................................
+/**
+ * @brief The GameRecord class Партия: стартовая позиция в упакованной записи, глубины поиска игроков,
+ * ходы и результат.
+ *
+ * Ход кодируется двумя байтами: биты 0-7 - индекс конечной ячейки, биты 8-11 - направление (0 - ближний
+ * ход, 1-12 - дальний ход с соответствующим смещением), бит 15 - после кода следуют оценка (int16) и время
+ * (uint16, мс). Начальная ячейка дальнего хода вычисляется по направлению, для ближнего хода она не важна.
+ *
+ * Партия в файле: размер записи без этого поля (uint32), результат (int8: -1 - не закончена, 0 - ничья,
+ * 1, 2 - победитель), глубины поиска игроков 1 и 2 (uint8, 255 - человек), стартовая позиция
+ * (Notation::pack), количество ходов (uint16), ходы. Все числа little-endian.
+ */
+class GameRecord{
+public:
+    void begin(HexBoard const& board, Position const& position,
+               int depth_1, int depth_2);               // Начало записи партии, глубина -1 - человек.
+    void addMove(HexBoard const& board, Move const& move);// Добавление хода человека.
+    void addMove(HexBoard const& board, Move const& move,
+                 int score, int time);                  // Добавление хода с оценкой и временем.
+    void serialize(std::vector<uint8_t>& out) const;    // Добавление записи партии в буфер.
+    bool deserialize(std::vector<uint8_t> const& data,
+                     size_t& offset);                   // Чтение записи партии из буфера.
+    bool replay(HexBoard& board,
+                std::vector<Position>& positions,
+                std::vector<Move>& moves) const;        // Восстановление позиций и ходов партии.
+    static uint16_t encodeMove(HexBoard const& board,
+                               Move const& move);       // Код хода.
+    static bool decodeMove(HexBoard const& board,
+                           Position const& position,
+                           uint16_t code, Move& move);  // Восстановление хода по коду.
+//............................................................................................................
+public:
+    std::vector<uint8_t> startPosition;                 //!Стартовая позиция (Notation::pack).
+    uint8_t depth[2] = {humanDepth, humanDepth};        //!Глубины поиска игроков 1 и 2.
+    int8_t result = -1;                                 //!Результат: -1 - нет, 0 - ничья, 1, 2 - победитель.
+    std::vector<RecordMove> moves;                      //!Ходы партии.
+    static const uint16_t annotatedFlag = 0x8000;       //!Признак хода с оценкой и временем.
+    static const uint8_t humanDepth = 255;              //!Глубина поиска, означающая игрока-человека.
+};
+//............................................................................................................
+/**
+ * @brief The GameRecordWriter class Запись партий в файл. Партия кодируется в потоке, который ее добавляет,
+ * и копируется в буфер; запись буфера на диск выполняется в отдельном потоке, когда буфер заполнен.
+ * Добавляющий поток ждет только если на диск не успевает записаться несколько буферов подряд.
+ */
+class GameRecordWriter{
+public:
+    explicit GameRecordWriter(std::string const& fileName,
+                              size_t bufferSize = defaultBufferSize);// Открытие файла на дозапись.
+    ~GameRecordWriter();                                // Запись оставшихся партий и закрытие файла.
+    bool isOpen() const;                                // Признак открытого файла.
+    bool append(GameRecord const& record);              // Добавление партии.
+    bool flush();                                       // Ожидание записи всех добавленных партий.
+    std::string error();                                // Описание ошибки записи.
+    uint64_t gameCount();                               // Количество добавленных партий.
+//............................................................................................................
+public:
+    static const size_t defaultBufferSize = 1 << 20;    //!Размер буфера по умолчанию, байт.
+    static const int maxPendingBuffers = 8;             //!Наибольшее число буферов в очереди на запись.
+    static const char fileMagic[8];                     //!Заголовок файла партий.
+//............................................................................................................
+private:
+    void run();                                         // Цикл потока записи.
+private:
+    std::ofstream file;                                 // Файл партий.
+    std::string fileName;                               // Имя файла партий.
+    size_t bufferSize;                                  // Размер буфера, после которого идет запись.
+    std::vector<uint8_t> pending;                       // Партии, ожидающие записи.
+    std::vector<uint8_t> writing;                       // Партии, которые записываются.
+    uint64_t appended = 0;                              // Количество добавленных партий.
+    uint64_t pendingGames = 0;                          // Количество партий в буфере ожидания.
+    uint64_t written = 0;                               // Количество записанных партий.
+    bool flushRequested = false;                        // Запрос записи неполного буфера.
+    bool stopping = false;                              // Запрос завершения потока записи.
+    bool failed = false;                                // Признак ошибки записи в файл.
+    std::mutex mutex;                                   // Защита буферов и счетчиков.
+    std::condition_variable wakeWriter;                 // Пробуждение потока записи.
+    std::condition_variable wakeClients;                // Пробуждение потоков, ожидающих записи.
+    std::thread worker;                                 // Поток записи.
+};
+//............................................................................................................
+/**
+ * @brief The GameRecordReader class Последовательное чтение файла партий.
+ */
+class GameRecordReader{
+public:
+    explicit GameRecordReader(std::string const& fileName);// Открытие файла и проверка заголовка.
+    bool isOpen() const;                                // Признак открытого файла с верным заголовком.
+    bool next(GameRecord& record);                      // Чтение очередной партии.
+    uint64_t offset();                                  // Смещение очередной партии в файле.
+    bool seek(uint64_t offset);                         // Переход к партии по смещению.
+private:
+    std::ifstream file;                                 // Файл партий.
+    bool valid = false;                                 // Признак верного заголовка.
+};
+#endif // GAMERECORD_H
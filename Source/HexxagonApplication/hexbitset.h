@@ -0,0 +1,152 @@
+﻿/**
+* @file hexbitset.h
+* @author Oleg2008e28
+* @date 19.10.2026 11:05:17
+* @brief Заголовочный файл шаблона BitSet - битового множества ячеек игрового поля фиксированного размера
+* из нескольких 64-битных слов. Операции выполняются поэлементно над массивом слов, поэтому компилятор
+* разворачивает и векторизует их при любом количестве слов.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXBITSET_H
+#define HEXBITSET_H
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+//............................................................................................................
+#ifndef HEXBOARD_WORDS
+#define HEXBOARD_WORDS 1                                // Количество 64-битных слов в битовом поле.
+#endif
+//............................................................................................................
+/**
+ * @brief hexPopCount Функция подсчета количества единичных битов в слове.
+ * @param word Слово.
+ * @return Количество единичных битов.
+ */
+inline int hexPopCount(uint64_t word){
+#ifdef _MSC_VER
+    return int(__popcnt64(word));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+/**
+ * @brief hexLowestBit Функция поиска младшего единичного бита в ненулевом слове.
+ * @param word Слово, не равное нулю.
+ * @return Номер младшего единичного бита.
+ */
+inline int hexLowestBit(uint64_t word){
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return int(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+//............................................................................................................
+/**
+ * @brief The BitSet struct Битовое множество индексов ячеек игрового поля.
+ * @tparam Words Количество 64-битных слов.
+ */
+template<int Words>
+struct BitSet{
+    static const int wordCount = Words;                 //!Количество слов.
+    static const int bitCount = Words * 64;             //!Наибольшее количество ячеек.
+    uint64_t w[Words];                                  //!Слова множества, ячейка i - бит i%64 слова i/64.
+//............................................................................................................
+    /**
+     * @brief empty Метод возвращает пустое множество.
+     */
+    static BitSet empty(){
+        BitSet b;
+        for (int i = 0; i < Words; i++) b.w[i] = 0;
+        return b;
+    }
+    /**
+     * @brief single Метод возвращает множество из одной ячейки.
+     * @param index Индекс ячейки.
+     */
+    static BitSet single(int index){
+        BitSet b = empty();
+        b.set(index);
+        return b;
+    }
+    void set(int index){ w[index >> 6] |= uint64_t(1) << (index & 63); }
+    void reset(int index){ w[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+    bool test(int index) const{ return (w[index >> 6] >> (index & 63)) & 1; }
+    /**
+     * @brief any Метод проверяет, есть ли в множестве хотя бы одна ячейка.
+     */
+    bool any() const{
+        uint64_t acc = 0;
+        for (int i = 0; i < Words; i++) acc |= w[i];
+        return acc != 0;
+    }
+    /**
+     * @brief count Метод возвращает количество ячеек в множестве.
+     */
+    int count() const{
+        int n = 0;
+        for (int i = 0; i < Words; i++) n += hexPopCount(w[i]);
+        return n;
+    }
+    /**
+     * @brief first Метод возвращает наименьший индекс ячейки множества или -1 для пустого множества.
+     */
+    int first() const{
+        for (int i = 0; i < Words; i++){
+            if (w[i]) return i * 64 + hexLowestBit(w[i]);
+        }
+        return -1;
+    }
+    /**
+     * @brief forEach Метод вызывает функцию для каждого индекса ячейки множества по возрастанию.
+     * @param f Функция, принимающая индекс ячейки.
+     */
+    template<class F>
+    void forEach(F f) const{
+        for (int i = 0; i < Words; i++){
+            uint64_t word = w[i];
+            while (word){
+                f(i * 64 + hexLowestBit(word));
+                word &= word - 1;
+            }
+        }
+    }
+    /**
+     * @brief anyOf Метод проверяет условие для индексов ячеек множества по возрастанию и прекращает
+     * перебор на первом индексе, для которого условие выполнено.
+     * @param f Условие, принимающее индекс ячейки.
+     * @return true - условие выполнено хотя бы для одной ячейки.
+     */
+    template<class F>
+    bool anyOf(F f) const{
+        for (int i = 0; i < Words; i++){
+            uint64_t word = w[i];
+            while (word){
+                if (f(i * 64 + hexLowestBit(word))) return true;
+                word &= word - 1;
+            }
+        }
+        return false;
+    }
+//............................................................................................................
+    BitSet operator&(BitSet const& o) const{ BitSet b; for (int i = 0; i < Words; i++) b.w[i] = w[i] & o.w[i]; return b; }
+    BitSet operator|(BitSet const& o) const{ BitSet b; for (int i = 0; i < Words; i++) b.w[i] = w[i] | o.w[i]; return b; }
+    BitSet operator^(BitSet const& o) const{ BitSet b; for (int i = 0; i < Words; i++) b.w[i] = w[i] ^ o.w[i]; return b; }
+    BitSet operator~() const{ BitSet b; for (int i = 0; i < Words; i++) b.w[i] = ~w[i]; return b; }
+    BitSet andNot(BitSet const& o) const{ BitSet b; for (int i = 0; i < Words; i++) b.w[i] = w[i] & ~o.w[i]; return b; }
+    BitSet& operator&=(BitSet const& o){ for (int i = 0; i < Words; i++) w[i] &= o.w[i]; return *this; }
+    BitSet& operator|=(BitSet const& o){ for (int i = 0; i < Words; i++) w[i] |= o.w[i]; return *this; }
+    BitSet& operator^=(BitSet const& o){ for (int i = 0; i < Words; i++) w[i] ^= o.w[i]; return *this; }
+    bool operator==(BitSet const& o) const{
+        uint64_t diff = 0;
+        for (int i = 0; i < Words; i++) diff |= w[i] ^ o.w[i];
+        return diff == 0;
+    }
+    bool operator!=(BitSet const& o) const{ return !(*this == o); }
+};
+//............................................................................................................
+typedef BitSet<HEXBOARD_WORDS> Bitboard;                // Битовое поле, размер задается при сборке.
+#endif // HEXBITSET_H
@@ -0,0 +1,273 @@
+﻿/**
+* @file hexboard.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 11:48:02
+* @brief Файл реализации методов класса HexBoard.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexboard.h"
+#include <algorithm>
+#include <cstdlib>
+const int HexBoard::standardSide;
+const int HexBoard::maxCells;
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief HexBoard::HexBoard Конструктор поля со стандартной раскладкой заблокированных ячеек: три ячейки
+ * вокруг центра через одну, как на стандартном поле из 61 ячейки.
+ * @param side Количество ячеек на стороне поля.
+ */
+HexBoard::HexBoard(int side){
+    sideCells = std::max(2, std::min(side, maxSide()));     // Сторона ограничена размером Bitboard.
+    build(std::vector<int>());                              // Геометрия строится без блоков,
+    build(standardBlockedCells());                          // затем блоки задаются по осевым координатам.
+}
+/**
+ * @brief HexBoard::HexBoard Конструктор поля с заданными заблокированными ячейками.
+ * @param side Количество ячеек на стороне поля.
+ * @param blockedCells Индексы заблокированных ячеек. Индексы вне поля пропускаются.
+ */
+HexBoard::HexBoard(int side, std::vector<int> const& blockedCells){
+    sideCells = std::max(2, std::min(side, maxSide()));
+    build(blockedCells);
+}
+/**
+ * @brief HexBoard::cellCountForSide Метод вычисляет количество ячеек поля с заданной стороной.
+ * @param side Количество ячеек на стороне поля.
+ * @return Количество ячеек.
+ */
+int HexBoard::cellCountForSide(int side){
+    return 3 * side * (side - 1) + 1;
+}
+/**
+ * @brief HexBoard::maxSide Метод вычисляет наибольшую сторону поля, которое помещается в Bitboard.
+ * Для полей больше стандартного сборка выполняется с HEXBOARD_WORDS > 1.
+ * @return Наибольшая сторона поля.
+ */
+int HexBoard::maxSide(){
+    int side = 2;
+    while (cellCountForSide(side + 1) <= maxCells){
+        side++;
+    }
+    return side;
+}
+/**
+ * @brief HexBoard::standardBlockedCells Метод возвращает стандартные заблокированные ячейки поля.
+ * @return Индексы ячеек с осевыми координатами (-1, 1), (0, -1), (1, 0).
+ */
+std::vector<int> HexBoard::standardBlockedCells() const{
+    std::vector<int> result;
+    const int axial[3][2] = {{-1, 1}, {0, -1}, {1, 0}};
+    for (auto const& a : axial){
+        int index = indexOf(a[0], a[1]);
+        if (index >= 0) result.push_back(index);
+    }
+    return result;
+}
+//............................................................................................................
+int HexBoard::side() const{ return sideCells; }
+int HexBoard::cellCount() const{ return cells; }
+int HexBoard::columnCount() const{ return 2 * sideCells - 1; }
+int HexBoard::columnBegin(int column) const{ return columnStart[column]; }
+int HexBoard::columnSize(int column) const{ return columnStart[column + 1] - columnStart[column]; }
+int HexBoard::cellColumn(int index) const{ return qOfCell[index] + sideCells - 1; }
+int HexBoard::cellRow(int index) const{ return index - columnStart[cellColumn(index)]; }
+int HexBoard::axialQ(int index) const{ return qOfCell[index]; }
+int HexBoard::axialR(int index) const{ return rOfCell[index]; }
+bool HexBoard::isBlocked(int index) const{ return blockedMask.test(index); }
+Bitboard const& HexBoard::playable() const{ return playableMask; }
+Bitboard const& HexBoard::blocked() const{ return blockedMask; }
+Bitboard const& HexBoard::edge() const{ return edgeMask; }
+Bitboard const& HexBoard::nearMask(int index) const{ return nearMasks[index]; }
+Bitboard const& HexBoard::farMask(int index) const{ return farMasks[index]; }
+std::vector<int> const& HexBoard::nearCells(int index) const{ return nearLists[index]; }
+std::vector<int> const& HexBoard::farCells(int index) const{ return farLists[index]; }
+/**
+ * @brief HexBoard::nearUnion Метод вычисляет объединение соседних ячеек для всех ячеек множества.
+ * @param set Множество ячеек.
+ * @return Ячейки, соседние хотя бы с одной ячейкой множества.
+ */
+Bitboard HexBoard::nearUnion(Bitboard const& set) const{
+    Bitboard result = Bitboard::empty();
+    set.forEach([&](int i){ result |= nearMasks[i]; });
+    return result;
+}
+/**
+ * @brief HexBoard::farUnion Метод вычисляет объединение ячеек дальнего хода для всех ячеек множества.
+ * @param set Множество ячеек.
+ * @return Ячейки через одну хотя бы от одной ячейки множества.
+ */
+Bitboard HexBoard::farUnion(Bitboard const& set) const{
+    Bitboard result = Bitboard::empty();
+    set.forEach([&](int i){ result |= farMasks[i]; });
+    return result;
+}
+/**
+ * @brief HexBoard::indexOf Метод вычисляет индекс ячейки по осевым координатам.
+ * @param q Осевая координата столбца.
+ * @param r Осевая координата ячейки вдоль столбца.
+ * @return Индекс ячейки или -1, если ячейки с такими координатами нет.
+ */
+int HexBoard::indexOf(int q, int r) const{
+    int n = sideCells - 1;                                  // Наибольшая осевая координата.
+    if (q < -n || q > n){
+        return -1;
+    }
+    int rBegin = std::max(-n, -q - n);                      // Первая и последняя ячейки столбца.
+    int rEnd = std::min(n, -q + n);
+    if (r < rBegin || r > rEnd){
+        return -1;
+    }
+    return columnStart[q + n] + r - rBegin;
+}
+/**
+ * @brief HexBoard::fillClearField Метод заполняет пустое игровое поле: 0 - пустая ячейка,
+ * 3 - заблокированная.
+ * @param [out] cells Массив из cellCount() ячеек.
+ */
+void HexBoard::fillClearField(int8_t* cells) const{
+    for (int i = 0; i < this->cells; i++){
+        cells[i] = blockedMask.test(i) ? 3 : 0;
+    }
+}
+/**
+ * @brief HexBoard::fillStartField Метод заполняет стартовое игровое поле: фишки игроков стоят в углах
+ * шестиугольника через один.
+ * @param [out] cells Массив из cellCount() ячеек.
+ */
+void HexBoard::fillStartField(int8_t* cells) const{
+    fillClearField(cells);
+    int n = sideCells - 1;
+    const int corners[6][3] = {{-n, 0, 1}, {0, n, 1}, {n, -n, 1},       // Углы игрока 1.
+                               {-n, n, 2}, {0, -n, 2}, {n, 0, 2}};      // Углы игрока 2.
+    for (auto const& c : corners){
+        int index = indexOf(c[0], c[1]);
+        if (index >= 0 && !blockedMask.test(index)){
+            cells[index] = int8_t(c[2]);
+        }
+    }
+}
+/**
+ * @brief HexBoard::positionFromField Метод строит битовую позицию по состоянию игрового поля.
+ * @param cells Состояние поля, cellCount() ячеек.
+ * @param player Игрок, который должен сделать ход.
+ * @return Битовая позиция.
+ */
+Position HexBoard::positionFromField(int8_t const* cells, int player) const{
+    Position position;
+    position.chips[0] = Bitboard::empty();
+    position.chips[1] = Bitboard::empty();
+    for (int i = 0; i < this->cells; i++){
+        if (cells[i] == 1) position.chips[0].set(i);
+        if (cells[i] == 2) position.chips[1].set(i);
+    }
+    position.player = int8_t(player);
+    return position;
+}
+/**
+ * @brief HexBoard::fieldFromPosition Метод заполняет игровое поле по битовой позиции.
+ * @param position Битовая позиция.
+ * @param [out] cells Массив из cellCount() ячеек.
+ */
+void HexBoard::fieldFromPosition(Position const& position, int8_t* cells) const{
+    fillClearField(cells);
+    position.chips[0].forEach([cells](int i){ cells[i] = 1; });
+    position.chips[1].forEach([cells](int i){ cells[i] = 2; });
+}
+/**
+ * @brief HexBoard::emptyCells Метод возвращает множество пустых ячеек позиции.
+ * @param position Битовая позиция.
+ * @return Множество пустых ячеек.
+ */
+Bitboard HexBoard::emptyCells(Position const& position) const{
+    return playableMask.andNot(position.chips[0] | position.chips[1]);
+}
+/**
+ * @brief HexBoard::generateMoves Метод генерации ходов игрока, который должен сделать ход. Ближние ходы
+ * в одну и ту же ячейку из разных фишек дают одинаковую позицию, поэтому генерируется один ближний ход
+ * в каждую доступную ячейку. Ближние ходы идут в списке первыми.
+ * @param position Битовая позиция.
+ * @param [out] moves Список ходов.
+ * @return Количество ходов.
+ */
+int HexBoard::generateMoves(Position const& position, MoveList& moves) const{
+    return position.player == 1 ? generateMovesFor<1>(position, moves)
+                                : generateMovesFor<2>(position, moves);
+}
+/**
+ * @brief HexBoard::hasMoves Метод проверяет наличие ходов игрока.
+ * @param position Битовая позиция.
+ * @param player Игрок, для которого выполняется проверка.
+ * @return true - у игрока есть ход.
+ */
+bool HexBoard::hasMoves(Position const& position, int player) const{
+    Bitboard empty = emptyCells(position);
+    return position.chips[player - 1].anyOf([&](int s){
+        return (nearMasks[s] & empty).any() || (farMasks[s] & empty).any();
+    });
+}
+/**
+ * @brief HexBoard::doMove Метод выполнения хода игрока, который должен сделать ход. После хода очередь
+ * переходит к противнику.
+ * @param position Битовая позиция.
+ * @param move Ход.
+ * @return Множество перевернутых фишек противника.
+ */
+Bitboard HexBoard::doMove(Position& position, Move const& move) const{
+    return position.player == 1 ? doMoveFor<1>(position, move) : doMoveFor<2>(position, move);
+}
+//............................................................................................................
+//......................................... private methods ..................................................
+//............................................................................................................
+/**
+ * @brief HexBoard::build Метод построения геометрии поля и таблиц соседства для текущей стороны поля.
+ * @param blockedCells Индексы заблокированных ячеек.
+ */
+void HexBoard::build(std::vector<int> const& blockedCells){
+    int n = sideCells - 1;                                  // Наибольшая осевая координата.
+    cells = cellCountForSide(sideCells);
+    columnStart.assign(1, 0);
+    qOfCell.clear();
+    rOfCell.clear();
+    for (int q = -n; q <= n; q++){                          // Нумерация ячеек по столбцам сверху вниз.
+        int rBegin = std::max(-n, -q - n);
+        int rEnd = std::min(n, -q + n);
+        for (int r = rBegin; r <= rEnd; r++){
+            qOfCell.push_back(int8_t(q));
+            rOfCell.push_back(int8_t(r));
+        }
+        columnStart.push_back(int(qOfCell.size()));
+    }
+    blockedMask = Bitboard::empty();
+    for (int index : blockedCells){
+        if (index >= 0 && index < cells) blockedMask.set(index);
+    }
+    playableMask = Bitboard::empty();
+    for (int i = 0; i < cells; i++){
+        if (!blockedMask.test(i)) playableMask.set(i);
+    }
+    nearMasks.assign(cells, Bitboard::empty());
+    farMasks.assign(cells, Bitboard::empty());
+    nearLists.assign(cells, std::vector<int>());
+    farLists.assign(cells, std::vector<int>());
+    for (int i = 0; i < cells; i++){                        // Таблицы строятся по расстоянию между
+        for (int j = 0; j < cells; j++){                    // ячейками в осевых координатах.
+            int dq = qOfCell[j] - qOfCell[i];
+            int dr = rOfCell[j] - rOfCell[i];
+            int distance = (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+            if (distance == 1){
+                nearMasks[i].set(j);
+                nearLists[i].push_back(j);
+            }
+            if (distance == 2){
+                farMasks[i].set(j);
+                farLists[i].push_back(j);
+            }
+        }
+    }
+    edgeMask = Bitboard::empty();
+    for (int i = 0; i < cells; i++){                        // У ячеек края меньше шести соседей.
+        if (nearLists[i].size() < 6) edgeMask.set(i);
+    }
+}
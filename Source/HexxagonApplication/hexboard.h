@@ -0,0 +1,180 @@
+﻿/**
+* @file hexboard.h
+* @author Oleg2008e28
+* @date 19.10.2026 11:20:44
+* @brief Заголовочный файл класса HexBoard, описывающего геометрию игрового поля гексагона: количество
+* ячеек на стороне, заблокированные ячейки и таблицы соседства, построенные для заданной раскладки.
+* Здесь же описаны битовая позиция Position, ход Move и правила игры над битовыми позициями.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXBOARD_H
+#define HEXBOARD_H
+#include "hexbitset.h"
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The Move struct Объект для хранения хода.
+ */
+struct Move {
+    int16_t beginPostion;                               //!Текущая позиция фишки.
+    int16_t newPostion;                                 //!Новая позиция фишки.
+    bool clearBeginPostion;                             //!Очистка начальной позиции true-очистить, false-нет.
+};
+/**
+ * @brief The Position struct Битовая позиция: множества фишек обоих игроков и игрок, который ходит.
+ * Заблокированные ячейки хранятся в HexBoard.
+ */
+struct Position {
+    Bitboard chips[2];                                  //!Фишки игрока 1 (chips[0]) и игрока 2 (chips[1]).
+    int8_t player;                                      //!Игрок, который должен сделать ход (1 или 2).
+};
+//............................................................................................................
+class HexBoard;
+/**
+ * @brief The MoveList struct Список ходов фиксированной емкости, размещаемый на стеке без выделения памяти.
+ * В каждую пустую ячейку возможен один ближний ход и не более двенадцати дальних.
+ */
+struct MoveList {
+    static const int capacity = Bitboard::bitCount * 13;//!Наибольшее количество ходов в позиции.
+    Move moves[capacity];                               //!Ходы.
+    int size = 0;                                       //!Количество ходов.
+    void push(int begin, int end, bool transfer){
+        moves[size++] = Move{int16_t(begin), int16_t(end), transfer};
+    }
+    bool empty() const{ return size == 0; }
+    Move& operator[](int i){ return moves[i]; }
+    Move const& operator[](int i) const{ return moves[i]; }
+    Move* begin(){ return moves; }
+    Move* end(){ return moves + size; }
+    Move const* begin() const{ return moves; }
+    Move const* end() const{ return moves + size; }
+};
+//............................................................................................................
+/**
+ * @brief The HexBoard class Геометрия игрового поля и правила игры. Поле - шестиугольник из шестиугольных
+ * ячеек со стороной side ячеек. Ячейки нумеруются по столбцам слева направо, в столбце - сверху вниз.
+ * Ячейке сопоставлены осевые координаты (q, r): q - номер столбца относительно центрального, r - номер
+ * ячейки вдоль столбца, центральная ячейка имеет координаты (0, 0).
+ */
+class HexBoard{
+public:
+    explicit HexBoard(int side = standardSide);         // Поле со стандартной раскладкой блоков.
+    HexBoard(int side,
+             std::vector<int> const& blockedCells);     // Поле с заданными заблокированными ячейками.
+    static int cellCountForSide(int side);              // Количество ячеек поля с заданной стороной.
+    static int maxSide();                               // Наибольшая сторона поля для размера Bitboard.
+    std::vector<int> standardBlockedCells() const;      // Стандартные заблокированные ячейки.
+//.................................................. Геометрия ..............................................
+    int side() const;                                   // Количество ячеек на стороне поля.
+    int cellCount() const;                              // Количество ячеек поля.
+    int columnCount() const;                            // Количество столбцов поля.
+    int columnBegin(int column) const;                  // Индекс первой ячейки столбца.
+    int columnSize(int column) const;                   // Количество ячеек в столбце.
+    int cellColumn(int index) const;                    // Номер столбца ячейки.
+    int cellRow(int index) const;                       // Номер ячейки в столбце.
+    int axialQ(int index) const;                        // Осевая координата q ячейки.
+    int axialR(int index) const;                        // Осевая координата r ячейки.
+    int indexOf(int q, int r) const;                    // Индекс ячейки по осевым координатам.
+    bool isBlocked(int index) const;                    // Признак заблокированной ячейки.
+    Bitboard const& playable() const;                   // Множество незаблокированных ячеек.
+    Bitboard const& blocked() const;                    // Множество заблокированных ячеек.
+    Bitboard const& edge() const;                       // Множество ячеек на краю поля.
+    Bitboard const& nearMask(int index) const;          // Соседние ячейки (ближний ход).
+    Bitboard const& farMask(int index) const;           // Ячейки через одну (дальний ход).
+    std::vector<int> const& nearCells(int index) const; // Индексы соседних ячеек.
+    std::vector<int> const& farCells(int index) const;  // Индексы ячеек через одну.
+    Bitboard nearUnion(Bitboard const& set) const;      // Ячейки, соседние с ячейками множества.
+    Bitboard farUnion(Bitboard const& set) const;       // Ячейки через одну от ячеек множества.
+    void fillClearField(int8_t* cells) const;           // Заполнение пустого поля.
+    void fillStartField(int8_t* cells) const;           // Заполнение стартового поля.
+//.................................................. Правила ................................................
+    Position positionFromField(int8_t const* cells,
+                               int player) const;       // Построение битовой позиции по полю.
+    void fieldFromPosition(Position const& position,
+                           int8_t* cells) const;        // Заполнение поля по битовой позиции.
+    Bitboard emptyCells(Position const& position) const;// Множество пустых ячеек.
+    int generateMoves(Position const& position,
+                      MoveList& moves) const;           // Генерация ходов игрока, который ходит.
+    bool hasMoves(Position const& position,
+                  int player) const;                    // Проверка наличия ходов игрока.
+    Bitboard doMove(Position& position,
+                    Move const& move) const;            // Выполнение хода и смена игрока.
+    template<int Player>
+    int generateMovesFor(Position const& position,
+                         MoveList& moves) const;        // Генерация ходов заданного игрока.
+    template<int Player>
+    Bitboard doMoveFor(Position& position,
+                       Move const& move) const;         // Выполнение хода заданного игрока.
+//............................................................................................................
+public:
+    static const int standardSide = 5;                  //!Сторона стандартного поля из 61 ячейки.
+    static const int maxCells = Bitboard::bitCount;     //!Наибольшее количество ячеек поля.
+//............................................................................................................
+private:
+    void build(std::vector<int> const& blockedCells);   // Построение таблиц соседства.
+private:
+    int sideCells;                                      // Количество ячеек на стороне поля.
+    int cells;                                          // Количество ячеек поля.
+    std::vector<int> columnStart;                       // Индексы первых ячеек столбцов.
+    std::vector<int8_t> qOfCell;                        // Осевая координата q для каждой ячейки.
+    std::vector<int8_t> rOfCell;                        // Осевая координата r для каждой ячейки.
+    Bitboard playableMask;                              // Незаблокированные ячейки.
+    Bitboard blockedMask;                               // Заблокированные ячейки.
+    Bitboard edgeMask;                                  // Ячейки на краю поля.
+    std::vector<Bitboard> nearMasks;                    // Таблица соседних ячеек.
+    std::vector<Bitboard> farMasks;                     // Таблица ячеек через одну.
+    std::vector<std::vector<int>> nearLists;            // Списки соседних ячеек.
+    std::vector<std::vector<int>> farLists;             // Списки ячеек через одну.
+};
+//............................................................................................................
+/**
+ * @brief HexBoard::generateMovesFor Метод генерации ходов игрока Player, который должен сделать ход.
+ * Номер игрока известен при компиляции, поэтому множества фишек выбираются без ветвлений. Порядок ходов
+ * такой же, как у generateMoves.
+ * @tparam Player Игрок, который ходит (1 или 2).
+ * @param position Битовая позиция.
+ * @param [out] moves Список ходов.
+ * @return Количество ходов.
+ */
+template<int Player>
+inline int HexBoard::generateMovesFor(Position const& position, MoveList& moves) const{
+    static_assert(Player == 1 || Player == 2, "Player must be 1 or 2");
+    moves.size = 0;
+    Bitboard const& own = position.chips[Player - 1];
+    Bitboard empty = playableMask.andNot(position.chips[0] | position.chips[1]);
+    Bitboard addTargets = Bitboard::empty();                // Ячейки, доступные для ближнего хода.
+    own.forEach([&](int s){ addTargets |= nearMasks[s]; });
+    addTargets &= empty;
+    addTargets.forEach([&](int t){
+        moves.push((nearMasks[t] & own).first(), t, false); // Любая соседняя фишка игрока.
+    });
+    own.forEach([&](int s){                                 // Дальние ходы каждой фишки.
+        (farMasks[s] & empty).forEach([&](int t){ moves.push(s, t, true); });
+    });
+    return moves.size;
+}
+/**
+ * @brief HexBoard::doMoveFor Метод выполнения хода игрока Player. После хода очередь переходит к
+ * противнику.
+ * @tparam Player Игрок, который ходит (1 или 2).
+ * @param position Битовая позиция.
+ * @param move Ход.
+ * @return Множество перевернутых фишек противника.
+ */
+template<int Player>
+inline Bitboard HexBoard::doMoveFor(Position& position, Move const& move) const{
+    static_assert(Player == 1 || Player == 2, "Player must be 1 or 2");
+    Bitboard& own = position.chips[Player - 1];
+    Bitboard& enemy = position.chips[2 - Player];
+    if (move.clearBeginPostion){                            // Если ход с очисткой начальной позиции,
+        own.reset(move.beginPostion);                       // очищаем ее.
+    }
+    own.set(move.newPostion);                               // Устанавливаем фишку в новую позицию.
+    Bitboard flips = nearMasks[move.newPostion] & enemy;    // Фишки противника вокруг новой позиции
+    own |= flips;                                           // перекрашиваются.
+    enemy = enemy.andNot(flips);
+    position.player = int8_t(3 - Player);                   // Очередь противника.
+    return flips;
+}
+#endif // HEXBOARD_H
@@ -0,0 +1,222 @@
+﻿/**
+* @file hexevaluation.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 15:26:40
+* @brief Файл реализации методов класса Evaluation.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexevaluation.h"
+#include <fstream>
+#include <sstream>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+const int Evaluation::scale;
+/**
+ * @brief Evaluation::Evaluation Конструктор класса, устанавливает веса по умолчанию.
+ */
+Evaluation::Evaluation(){
+    for (int f = 0; f < featureCount; f++){
+        weights[f] = 0;
+    }
+    weights[material] = scale;
+}
+/**
+ * @brief Evaluation::featureName Метод возвращает название признака, используемое в файле весов.
+ * @param feature Признак.
+ * @return Название признака.
+ */
+char const* Evaluation::featureName(int feature){
+    static char const* const names[featureCount] = {
+        "material", "exposed", "cloneTargets", "jumpTargets", "edge", "tempo"
+    };
+    return names[feature];
+}
+/**
+ * @brief Evaluation::features Метод вычисляет признаки позиции: разности значений для игрока 1 и игрока 2.
+ * @param [in] board Геометрия игрового поля.
+ * @param [in] position Позиция.
+ * @param [out] values Массив из featureCount значений признаков.
+ */
+void Evaluation::features(HexBoard const& board, Position const& position, int16_t* values){
+    Bitboard empty = board.emptyCells(position);
+    Bitboard nearEmpty = board.nearUnion(empty);            // Ячейки, соседние с пустыми.
+    int value[2][featureCount];
+    for (int p = 0; p < 2; p++){
+        Bitboard const& own = position.chips[p];
+        Bitboard nearOwn = board.nearUnion(own);
+        value[p][material] = own.count();
+        value[p][exposed] = (own & nearEmpty).count();
+        value[p][cloneTargets] = (nearOwn & empty).count();
+        value[p][jumpTargets] = (board.farUnion(own) & empty).andNot(nearOwn).count();
+        value[p][edge] = (own & board.edge()).count();
+    }
+    for (int f = 0; f < tempo; f++){
+        values[f] = int16_t(value[0][f] - value[1][f]);
+    }
+    values[tempo] = position.player == 1 ? 1 : -1;
+}
+/**
+ * @brief Evaluation::evaluate Метод вычисляет оценку позиции для игрока. При весах по умолчанию признаки
+ * не вычисляются, оценка считается по количеству фишек.
+ * @param board Геометрия игрового поля.
+ * @param position Позиция.
+ * @param player Игрок, для которого вычисляется оценка.
+ * @return Оценка позиции, scale - одна фишка.
+ */
+int Evaluation::evaluate(HexBoard const& board, Position const& position, int player) const{
+    int score;
+    if (materialOnly){
+        score = weights[material] * (position.chips[0].count() - position.chips[1].count());
+    } else {
+        int16_t values[featureCount];
+        features(board, position, values);
+        score = 0;
+        for (int f = 0; f < featureCount; f++){
+            score += weights[f] * values[f];
+        }
+    }
+    return player == 1 ? score : -score;
+}
+/**
+ * @brief Evaluation::evaluateMoves Метод оценивает позиции после каждого хода списка, результат совпадает
+ * с evaluate для каждой позиции. При весах только фишек позиции не строятся: разность фишек после хода
+ * равна разности до хода плюс поставленная фишка клонирования плюс удвоенное количество перевернутых,
+ * а перевернутые фишки - пересечение соседей конечной ячейки с фишками противника. Маски соседей
+ * выбираются, пересекаются и считаются по четыре хода в одной команде AVX2, без AVX2 - по одному.
+ * При других весах позиции оцениваются по одной.
+ * @param [in] board Геометрия игрового поля.
+ * @param [in] position Позиция до хода.
+ * @param [in] moves Ходы игрока, который ходит.
+ * @param [in] player Игрок, для которого вычисляется оценка.
+ * @param [out] scores Оценки moves.size позиций.
+ */
+void Evaluation::evaluateMoves(HexBoard const& board, Position const& position, MoveList const& moves,
+                               int player, int* scores) const{
+    if (!materialOnly){
+        for (int i = 0; i < moves.size; i++){
+            Position child = position;
+            board.doMove(child, moves[i]);
+            scores[i] = evaluate(board, child, player);
+        }
+        return;
+    }
+    int own = position.player - 1;
+    Bitboard const& enemy = position.chips[1 - own];
+    int base = position.chips[own].count() - enemy.count();// Разность фишек игрока, который ходит.
+    int weight = position.player == player ? weights[material] : -weights[material];
+    int i = 0;
+#if defined(__AVX2__)
+    long long const* masks = reinterpret_cast<long long const*>(&board.nearMask(0));
+    __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i low = _mm256_set1_epi8(0x0F);
+    for (; i + 4 <= moves.size; i += 4){
+        Move const* m = &moves[i];
+        __m256i cells = _mm256_setr_epi64x(m[0].newPostion, m[1].newPostion, m[2].newPostion, m[3].newPostion);
+        __m256i rows = _mm256_mul_epu32(cells, _mm256_set1_epi64x(Bitboard::wordCount));
+        __m256i counts = _mm256_setzero_si256();
+        for (int w = 0; w < Bitboard::wordCount; w++){      // Перевернутые фишки слова w.
+            __m256i near = _mm256_i64gather_epi64(masks + w, rows, 8);
+            __m256i flips = _mm256_and_si256(near, _mm256_set1_epi64x((long long)enemy.w[w]));
+            __m256i bytes = _mm256_add_epi8(                // Количество единиц в байтах по тетрадам.
+                        _mm256_shuffle_epi8(lookup, _mm256_and_si256(flips, low)),
+                        _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(flips, 4), low)));
+            counts = _mm256_add_epi64(counts, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+        }
+        alignas(32) long long flipCounts[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(flipCounts), counts);
+        for (int k = 0; k < 4; k++){
+            scores[i + k] = weight * (base + !m[k].clearBeginPostion + 2 * int(flipCounts[k]));
+        }
+    }
+#endif
+    for (; i < moves.size; i++){                            // Остаток списка или сборка без AVX2.
+        Move const& move = moves[i];
+        int flips = (board.nearMask(move.newPostion) & enemy).count();
+        scores[i] = weight * (base + !move.clearBeginPostion + 2 * flips);
+    }
+}
+/**
+ * @brief Evaluation::isMaterialOnly Метод проверяет, равны ли нулю веса всех признаков, кроме фишек.
+ * @return true - оценка пропорциональна разности фишек.
+ */
+bool Evaluation::isMaterialOnly() const{
+    return materialOnly;
+}
+/**
+ * @brief Evaluation::batchKernel Метод возвращает название реализации пакетной оценки evaluateMoves.
+ * @return "AVX2" или "scalar".
+ */
+char const* Evaluation::batchKernel(){
+#if defined(__AVX2__)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+/**
+ * @brief Evaluation::weight Метод возвращает вес признака.
+ * @param feature Признак.
+ * @return Вес признака.
+ */
+int Evaluation::weight(int feature) const{
+    return weights[feature];
+}
+/**
+ * @brief Evaluation::setWeight Метод устанавливает вес признака.
+ * @param feature Признак.
+ * @param value Вес признака.
+ */
+void Evaluation::setWeight(int feature, int value){
+    weights[feature] = value;
+    materialOnly = true;
+    for (int f = 0; f < featureCount; f++){
+        if (f != material && weights[f] != 0) materialOnly = false;
+    }
+}
+/**
+ * @brief Evaluation::load Метод загружает веса из файла. Признаки, которых нет в файле, сохраняют вес.
+ * @param fileName Имя файла весов.
+ * @return true - веса загружены, false - файл не открыт или содержит неизвестный признак.
+ */
+bool Evaluation::load(std::string const& fileName){
+    std::ifstream file(fileName);
+    if (!file.is_open()){
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)){
+        std::istringstream stream(line);
+        std::string name;
+        int value = 0;
+        if (!(stream >> name) || name[0] == '#'){
+            continue;
+        }
+        int feature = 0;
+        while (feature < featureCount && name != featureName(feature)){
+            feature++;
+        }
+        if (feature == featureCount || !(stream >> value)){
+            return false;
+        }
+        setWeight(feature, value);
+    }
+    return true;
+}
+/**
+ * @brief Evaluation::save Метод записывает веса в файл.
+ * @param fileName Имя файла весов.
+ * @return true - веса записаны.
+ */
+bool Evaluation::save(std::string const& fileName) const{
+    std::ofstream file(fileName);
+    if (!file.is_open()){
+        return false;
+    }
+    file << "# Веса оценочной функции, " << scale << " - одна фишка.\n";
+    for (int f = 0; f < featureCount; f++){
+        file << featureName(f) << ' ' << weights[f] << '\n';
+    }
+    return bool(file);
+}
@@ -0,0 +1,63 @@
+﻿/**
+* @file hexevaluation.h
+* @author Oleg2008e28
+* @date 19.10.2026 15:12:08
+* @brief Заголовочный файл класса Evaluation - линейной оценочной функции позиции с настраиваемыми весами.
+* Веса подбираются по сыгранным партиям программой HexxagonTuner и загружаются из текстового файла.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXEVALUATION_H
+#define HEXEVALUATION_H
+#include "hexboard.h"
+#include <string>
+//............................................................................................................
+/**
+ * @brief The Evaluation class Линейная оценочная функция: сумма произведений весов на признаки позиции.
+ * Каждый признак - разность значений для игрока 1 и игрока 2, поэтому оценка для игрока 2 - та же сумма
+ * с обратным знаком. Веса целые, вес фишки по умолчанию равен scale, остальные веса равны нулю, и оценка
+ * совпадает с разностью количества фишек, умноженной на scale.
+ *
+ * Файл весов текстовый: строки "<название признака> <вес>", строки, начинающиеся с '#', пропускаются.
+ */
+class Evaluation{
+public:
+    /**
+     * @brief The Feature enum Признаки позиции.
+     */
+    enum Feature{
+        material,                                       //!Количество фишек.
+        exposed,                                        //!Фишки рядом с пустыми ячейками.
+        cloneTargets,                                   //!Пустые ячейки, доступные для ближнего хода.
+        jumpTargets,                                    //!Пустые ячейки, доступные только для дальнего хода.
+        edge,                                           //!Фишки на краю поля.
+        tempo,                                          //!Очередь хода: 1 - ходит игрок 1, -1 - игрок 2.
+        featureCount
+    };
+//............................................................................................................
+public:
+    Evaluation();                                       // Конструктор, веса по умолчанию.
+    static char const* featureName(int feature);        // Название признака.
+    static void features(HexBoard const& board,
+                         Position const& position,
+                         int16_t* values);              // Признаки позиции для игрока 1.
+    int evaluate(HexBoard const& board,
+                 Position const& position,
+                 int player) const;                     // Оценка позиции для игрока.
+    void evaluateMoves(HexBoard const& board,
+                       Position const& position,
+                       MoveList const& moves, int player,
+                       int* scores) const;              // Оценки позиций после каждого хода списка.
+    bool isMaterialOnly() const;                        // Признак оценки только по фишкам.
+    static char const* batchKernel();                   // Название реализации пакетной оценки.
+    int weight(int feature) const;                      // Вес признака.
+    void setWeight(int feature, int value);             // Установка веса признака.
+    bool load(std::string const& fileName);             // Загрузка весов из файла.
+    bool save(std::string const& fileName) const;       // Запись весов в файл.
+//............................................................................................................
+public:
+    static const int scale = 100;                       //!Вес фишки по умолчанию, единица оценки.
+private:
+    int weights[featureCount];                          // Веса признаков.
+    bool materialOnly = true;                           // Признак нулевых весов всех признаков, кроме фишек.
+};
+#endif // HEXEVALUATION_H
@@ -0,0 +1,283 @@
+﻿/**
+* @file hexmcts.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 17:40:09
+* @brief Файл реализации методов класса MctsEngine.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexmcts.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+const int MctsEngine::defaultNodeCapacity;
+const int MctsEngine::virtualLossCount;
+const int MctsEngine::playoutCandidates;
+const int MctsEngine::playoutPlies;
+constexpr double MctsEngine::exploration;
+/**
+ * @brief nextRandom Генератор псевдослучайных чисел xorshift64*.
+ * @param state Состояние генератора, не равное нулю.
+ * @return Случайное число.
+ */
+static inline uint64_t nextRandom(uint64_t& state){
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief MctsEngine::MctsEngine Конструктор класса, выделяет пул узлов.
+ * @param nodeCapacity Размер пула узлов.
+ */
+MctsEngine::MctsEngine(int nodeCapacity){
+    capacity = nodeCapacity;
+    nodes = new MctsNode[capacity];                         // Пул выделяется один раз на все поиски.
+    used = 0;
+    iterationCount = 0;
+    stop = false;
+}
+/**
+ * @brief MctsEngine::~MctsEngine Деструктор класса.
+ */
+MctsEngine::~MctsEngine(){
+    delete[] nodes;
+}
+/**
+ * @brief MctsEngine::search Метод выбирает ход для игрока, который ходит, за заданное время.
+ * @param board Геометрия игрового поля.
+ * @param position Позиция.
+ * @param timeLimit Время поиска, мс.
+ * @param threadCount Количество потоков поиска.
+ * @param iterationLimit Наибольшее количество итераций, 0 - поиск идет все время. Количество проверяется
+ * каждую миллисекунду, поэтому потоки успевают сделать несколько лишних итераций.
+ * @param cancel Внешний признак отмены, nullptr - поиск идет до ограничений. Потоки проверяют его перед
+ * каждой итерацией, отмененный поиск возвращает лучший ход найденного к этому моменту дерева.
+ * @return Ход с наибольшим количеством проходов или нулевой ход, если ходов нет.
+ */
+Move MctsEngine::search(HexBoard const& board, Position const& position, int timeLimit, int threadCount,
+                        int64_t iterationLimit, std::atomic<bool> const* cancel){
+    this->board = &board;
+    this->cancel = cancel;
+    root = position;
+    maxPlayoutPlies = playoutPlies;
+    used = 1;
+    iterationCount = 0;
+    stop = false;
+    rootValue = 0.5;
+    initNode(0, Move{0, 0, false});
+    MoveList moves;
+    if (board.generateMoves(position, moves) <= 1){         // Выбора нет.
+        return moves.empty() ? Move{0, 0, false} : moves[0];
+    }
+    expand(0, position);
+    std::vector<std::thread> pool;
+    uint64_t seed = uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+    for (int t = 0; t < std::max(1, threadCount); t++){
+        pool.emplace_back(&MctsEngine::worker, this, int(seed + t));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimit);
+    while (std::chrono::steady_clock::now() < deadline && !cancelled()
+           && (iterationLimit <= 0 || iterationCount.load(std::memory_order_relaxed) < iterationLimit)){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stop = true;
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+    MctsNode const& node = nodes[0];
+    uint32_t best = node.firstChild;
+    for (uint32_t c = node.firstChild; c < node.firstChild + uint32_t(node.childCount); c++){
+        if (nodes[c].visits > nodes[best].visits) best = c;
+    }
+    if (nodes[best].visits > 0){
+        rootValue = nodes[best].score / 2.0 / nodes[best].visits;
+    }
+    return nodes[best].move;
+}
+/**
+ * @brief MctsEngine::bestValue Метод возвращает долю побед выбранного хода по результатам поиска.
+ * @return Доля побед, 0 - поражение, 1 - победа.
+ */
+double MctsEngine::bestValue() const{
+    return rootValue;
+}
+/**
+ * @brief MctsEngine::iterations Метод возвращает количество итераций последнего поиска.
+ * @return Количество итераций.
+ */
+int64_t MctsEngine::iterations() const{
+    return iterationCount;
+}
+/**
+ * @brief MctsEngine::nodeCount Метод возвращает количество узлов дерева последнего поиска.
+ * @return Количество узлов.
+ */
+int MctsEngine::nodeCount() const{
+    return int(std::min<uint32_t>(used, uint32_t(capacity)));
+}
+//............................................................................................................
+//......................................... private methods ..................................................
+//............................................................................................................
+/**
+ * @brief MctsEngine::worker Цикл итераций одного потока поиска: спуск, раскрытие, случайная партия и
+ * возврат результата по пути.
+ * @param seed Начальное значение генератора случайных чисел потока.
+ */
+void MctsEngine::worker(int seed){
+    uint64_t random = uint64_t(seed) * 0x9E3779B97F4A7C15ULL | 1;
+    std::vector<uint32_t> path;                             // Узлы пути от корня.
+    std::vector<int8_t> movers;                             // Игроки, сделавшие ход в узлы пути.
+    path.reserve(256);
+    movers.reserve(256);
+    while (!stop.load(std::memory_order_relaxed) && !cancelled()){
+        Position position = root;
+        path.assign(1, 0);
+        movers.assign(1, 0);
+        uint32_t index = 0;
+        for (;;){                                           // Спуск до листа.
+            MctsNode& node = nodes[index];
+            uint8_t state = node.state.load(std::memory_order_acquire);
+            if (state != 2){                                // Лист раскрывается после первого прохода.
+                if (state == 0 && node.visits.load(std::memory_order_relaxed) > 0 && expand(index, position)){
+                    continue;
+                }
+                break;
+            }
+            if (node.childCount.load(std::memory_order_relaxed) == 0){
+                break;                                      // Конец партии.
+            }
+            uint32_t child = select(index);
+            nodes[child].virtualLoss += virtualLossCount;
+            movers.push_back(position.player);
+            board->doMove(position, nodes[child].move);
+            path.push_back(child);
+            index = child;
+        }
+        int result = playout(position, random);             // Полуочки игрока 1.
+        for (size_t i = 0; i < path.size(); i++){
+            MctsNode& node = nodes[path[i]];
+            if (i > 0){
+                node.score += movers[i] == 1 ? result : 2 - result;
+                node.virtualLoss -= virtualLossCount;
+            }
+            node.visits++;
+        }
+        iterationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+/**
+ * @brief MctsEngine::expand Метод раскрывает узел: добавляет детей для всех ходов позиции. Раскрывает
+ * узел только один поток, остальные на это время считают узел листом.
+ * @param index Индекс узла.
+ * @param position Позиция узла.
+ * @return true - узел раскрыт, false - узел раскрывается другим потоком или пул узлов заполнен.
+ */
+bool MctsEngine::expand(uint32_t index, Position const& position){
+    MctsNode& node = nodes[index];
+    uint8_t expected = 0;
+    if (!node.state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)){
+        return false;
+    }
+    MoveList moves;
+    int count = board->generateMoves(position, moves);
+    if (used.load(std::memory_order_relaxed) + uint32_t(count) > uint32_t(capacity)){
+        node.state.store(0, std::memory_order_release);     // Дерево больше не растет.
+        return false;
+    }
+    uint32_t first = used.fetch_add(uint32_t(count));
+    if (first + uint32_t(count) > uint32_t(capacity)){
+        node.state.store(0, std::memory_order_release);
+        return false;
+    }
+    for (int i = 0; i < count; i++){
+        initNode(first + i, moves[i]);
+    }
+    node.firstChild.store(first, std::memory_order_relaxed);
+    node.childCount.store(count, std::memory_order_relaxed);
+    node.state.store(2, std::memory_order_release);         // Дети видны другим потокам.
+    return true;
+}
+/**
+ * @brief MctsEngine::select Метод выбирает ребенка узла по формуле UCT. Виртуальные поражения
+ * увеличивают количество проходов без увеличения результата.
+ * @param index Индекс раскрытого узла.
+ * @return Индекс выбранного ребенка.
+ */
+uint32_t MctsEngine::select(uint32_t index) const{
+    MctsNode const& node = nodes[index];
+    uint32_t first = node.firstChild.load(std::memory_order_relaxed);
+    uint32_t last = first + uint32_t(node.childCount.load(std::memory_order_relaxed));
+    double logParent = std::log(double(node.visits + node.virtualLoss) + 1.0);
+    uint32_t best = first;
+    double bestScore = -1.0;
+    for (uint32_t c = first; c < last; c++){
+        int32_t visits = nodes[c].visits.load(std::memory_order_relaxed)
+                + nodes[c].virtualLoss.load(std::memory_order_relaxed);
+        if (visits == 0){                                   // Непройденный ход выбирается сразу.
+            return c;
+        }
+        double value = nodes[c].score.load(std::memory_order_relaxed) / 2.0 / visits
+                + exploration * std::sqrt(logParent / visits);
+        if (value > bestScore){
+            bestScore = value;
+            best = c;
+        }
+    }
+    return best;
+}
+/**
+ * @brief MctsEngine::playout Метод доигрывает позицию быстрой случайной партией. На каждом ходу из
+ * нескольких случайных ходов выбирается ход с наибольшим изменением разницы фишек.
+ * @param position Позиция.
+ * @param random Состояние генератора случайных чисел.
+ * @return Результат для игрока 1 в полуочках: 2 - победа, 1 - ничья, 0 - поражение.
+ */
+int MctsEngine::playout(Position position, uint64_t& random) const{
+    MoveList moves;
+    for (int ply = 0; ply < maxPlayoutPlies; ply++){
+        int count = board->generateMoves(position, moves);
+        if (count == 0){
+            break;
+        }
+        Bitboard const& enemy = position.chips[2 - position.player];
+        int best = 0, bestGain = -1;
+        for (int k = 0; k < playoutCandidates; k++){
+            Move const& move = moves[int(nextRandom(random) % uint64_t(count))];
+            int gain = 2 * (board->nearMask(move.newPostion) & enemy).count()
+                    + (move.clearBeginPostion ? 0 : 1);
+            if (gain > bestGain){
+                bestGain = gain;
+                best = int(&move - moves.begin());
+            }
+        }
+        board->doMove(position, moves[best]);
+    }
+    int balance = position.chips[0].count() - position.chips[1].count();
+    return balance > 0 ? 2 : balance < 0 ? 0 : 1;
+}
+/**
+ * @brief MctsEngine::initNode Метод устанавливает начальное состояние узла.
+ * @param index Индекс узла.
+ * @param move Ход, ведущий в узел.
+ */
+void MctsEngine::initNode(uint32_t index, Move const& move){
+    MctsNode& node = nodes[index];
+    node.move = move;
+    node.visits.store(0, std::memory_order_relaxed);
+    node.virtualLoss.store(0, std::memory_order_relaxed);
+    node.score.store(0, std::memory_order_relaxed);
+    node.firstChild.store(0, std::memory_order_relaxed);
+    node.childCount.store(0, std::memory_order_relaxed);
+    node.state.store(0, std::memory_order_relaxed);
+}
+/**
+ * @brief MctsEngine::cancelled Метод проверяет внешний признак отмены текущего поиска.
+ * @return true - поиск отменен.
+ */
+bool MctsEngine::cancelled() const{
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
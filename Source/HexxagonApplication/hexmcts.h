@@ -0,0 +1,80 @@
+﻿/**
+* @file hexmcts.h
+* @author Oleg2008e28
+* @date 19.10.2026 17:14:33
+* @brief Заголовочный файл класса MctsEngine - выбора хода методом Монте-Карло поиска по дереву (MCTS)
+* с формулой UCT, быстрыми случайными партиями и параллельным поиском по общему дереву.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXMCTS_H
+#define HEXMCTS_H
+#include "hexboard.h"
+#include <atomic>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The MctsNode struct Узел дерева поиска. Узлы хранятся в заранее выделенном пуле, дети узла
+ * занимают непрерывный участок пула.
+ */
+struct MctsNode {
+    Move move;                                          //!Ход, ведущий в узел.
+    std::atomic<int32_t> visits;                        //!Количество проходов через узел.
+    std::atomic<int32_t> virtualLoss;                   //!Проходы, которые еще не вернули результат.
+    std::atomic<int64_t> score;                         //!Сумма результатов в полуочках для игрока,
+                                                        //!сделавшего ход в узел.
+    std::atomic<uint32_t> firstChild;                   //!Индекс первого ребенка в пуле.
+    std::atomic<int32_t> childCount;                    //!Количество детей.
+    std::atomic<uint8_t> state;                         //!0 - лист, 1 - раскрывается, 2 - раскрыт.
+};
+//............................................................................................................
+/**
+ * @brief The MctsEngine class Выбор хода методом MCTS.
+ *
+ * Каждая итерация спускается от корня по формуле UCT, раскрывает лист, через который уже проходили,
+ * доигрывает позицию быстрой случайной партией и возвращает результат по пройденному пути. Партия
+ * выбирает из нескольких случайных ходов ход с наибольшим количеством захваченных фишек, ближние ходы
+ * предпочтительнее дальних. Потоки поиска работают с одним деревом без блокировок: на время итерации
+ * узлы пути получают виртуальное поражение, чтобы другие потоки расходились по разным ветвям.
+ */
+class MctsEngine{
+public:
+    explicit MctsEngine(int nodeCapacity = defaultNodeCapacity);// Конструктор, размер пула узлов.
+    ~MctsEngine();                                      // Деструктор, освобождение пула.
+    Move search(HexBoard const& board,
+                Position const& position,
+                int timeLimit, int threadCount,
+                int64_t iterationLimit = 0,
+                std::atomic<bool> const* cancel = nullptr);// Выбор хода за заданное время, мс.
+    double bestValue() const;                           // Доля побед выбранного хода, 0..1.
+    int64_t iterations() const;                         // Количество итераций последнего поиска.
+    int nodeCount() const;                              // Количество узлов последнего поиска.
+//............................................................................................................
+public:
+    static const int defaultNodeCapacity = 1 << 21;     //!Размер пула узлов по умолчанию.
+    static const int virtualLossCount = 3;              //!Виртуальное поражение на узел пути.
+    static const int playoutCandidates = 3;             //!Количество ходов, сравниваемых в партии.
+    static const int playoutPlies = 16;                 //!Длина случайной партии, после нее результат
+                                                        //!определяется по разнице фишек.
+    static constexpr double exploration = 0.7;          //!Коэффициент исследования UCT.
+//............................................................................................................
+private:
+    void worker(int seed);                              // Цикл итераций одного потока.
+    bool expand(uint32_t index, Position const& position);// Раскрытие узла.
+    uint32_t select(uint32_t index) const;              // Выбор ребенка по формуле UCT.
+    int playout(Position position,
+                uint64_t& random) const;                // Случайная партия, результат игрока 1.
+    void initNode(uint32_t index, Move const& move);    // Начальное состояние узла.
+    bool cancelled() const;                             // Проверка внешнего признака отмены.
+private:
+    MctsNode* nodes;                                    // Пул узлов.
+    int capacity;                                       // Размер пула узлов.
+    std::atomic<uint32_t> used;                         // Количество занятых узлов пула.
+    std::atomic<int64_t> iterationCount;                // Количество итераций поиска.
+    std::atomic<bool> stop;                             // Признак окончания поиска.
+    std::atomic<bool> const* cancel = nullptr;          // Внешний признак отмены, nullptr - без отмены.
+    HexBoard const* board = nullptr;                    // Геометрия поля текущего поиска.
+    Position root;                                      // Позиция корня.
+    int maxPlayoutPlies = 0;                            // Наибольшая длина случайной партии.
+    double rootValue = 0.5;                             // Доля побед выбранного хода.
+};
+#endif // HEXMCTS_H
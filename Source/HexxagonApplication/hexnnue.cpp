@@ -0,0 +1,315 @@
+﻿/**
+* @file hexnnue.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 18:47:16
+* @brief Файл реализации методов класса Nnue.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexnnue.h"
+#include "hexevaluation.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+const uint32_t Nnue::fileVersion;
+static const char nnueMagic[4] = {'H', 'X', 'N', 'N'};
+/**
+ * @brief nextRandom Генератор псевдослучайных чисел xorshift64*.
+ * @param state Состояние генератора, не равное нулю.
+ * @return Случайное число.
+ */
+static inline uint64_t nextRandom(uint64_t& state){
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief Nnue::Nnue Конструктор класса, создает сеть с нулевыми весами.
+ */
+Nnue::Nnue(){
+    inputWeights.assign(2 * HexBoard::maxCells * nnueHiddenSize, 0);
+    inputBias.assign(nnueHiddenSize, 0);
+    outputWeights.assign(2 * nnueHiddenSize, 0);
+}
+/**
+ * @brief Nnue::materialNetwork Метод строит сеть, оценка которой равна разнице фишек. Нейрон 0 считает
+ * 64 + (фишки 1 - фишки 2), нейрон 1 - 64 - (фишки 1 - фишки 2), выход - их разность. Сеть служит
+ * начальной точкой обучения и проверкой вычислений.
+ * @param cells Количество ячеек поля.
+ * @return Сеть.
+ */
+Nnue Nnue::materialNetwork(int cells){
+    Nnue network;
+    network.inputCells = cells;
+    for (int i = 0; i < cells; i++){
+        network.column(0, i)[0] = 1;
+        network.column(0, i)[1] = -1;
+        network.column(1, i)[0] = -1;
+        network.column(1, i)[1] = 1;
+    }
+    network.inputBias[0] = 64;
+    network.inputBias[1] = 64;
+    for (int stm = 0; stm < 2; stm++){
+        network.outputWeights[stm * nnueHiddenSize + 0] = 1;
+        network.outputWeights[stm * nnueHiddenSize + 1] = -1;
+    }
+    network.divisor = 2;                                    // Разность нейронов равна 2 * разница фишек.
+    return network;
+}
+/**
+ * @brief Nnue::randomNetwork Метод строит сеть со случайными весами во всем допустимом диапазоне
+ * активаций и весов выхода. Сеть ничего не оценивает, она служит для сравнения векторного кода со
+ * скалярным и обновления аккумулятора с полным вычислением: значения аккумулятора не выходят за int16.
+ * @param cells Количество ячеек поля.
+ * @param seed Начальное значение генератора случайных чисел.
+ * @return Сеть.
+ */
+Nnue Nnue::randomNetwork(int cells, uint64_t seed){
+    Nnue network;
+    uint64_t random = seed | 1;
+    network.inputCells = cells;
+    for (int p = 0; p < 2; p++){
+        for (int i = 0; i < cells; i++){
+            for (int h = 0; h < nnueHiddenSize; h++){
+                network.column(p, i)[h] = int16_t(int(nextRandom(random) % 65) - 32);
+            }
+        }
+    }
+    for (int16_t& bias : network.inputBias){
+        bias = int16_t(int(nextRandom(random) % 257) - 64);
+    }
+    for (int8_t& weight : network.outputWeights){
+        weight = int8_t(int(nextRandom(random) % 255) - 127);
+    }
+    network.outputBias[0] = int32_t(nextRandom(random) % 2001) - 1000;
+    network.outputBias[1] = int32_t(nextRandom(random) % 2001) - 1000;
+    network.divisor = 64;
+    return network;
+}
+/**
+ * @brief Nnue::load Метод загружает сеть из файла.
+ * @param fileName Имя файла сети.
+ * @return true - сеть загружена, false - файл не открыт или не подходит для сборки.
+ */
+bool Nnue::load(std::string const& fileName){
+    std::ifstream file(fileName, std::ios::binary);
+    char magic[4];
+    uint32_t header[3];                                     // Версия, ячейки, нейроны.
+    if (!file.read(magic, 4) || std::memcmp(magic, nnueMagic, 4) != 0
+            || !file.read(reinterpret_cast<char*>(header), sizeof(header))
+            || header[0] != fileVersion || header[1] > uint32_t(HexBoard::maxCells)
+            || header[2] != uint32_t(nnueHiddenSize)){
+        return false;
+    }
+    Nnue network;
+    network.inputCells = int(header[1]);
+    for (int p = 0; p < 2; p++){
+        file.read(reinterpret_cast<char*>(network.column(p, 0)),
+                  std::streamsize(network.inputCells * nnueHiddenSize * sizeof(int16_t)));
+    }
+    file.read(reinterpret_cast<char*>(network.inputBias.data()), nnueHiddenSize * sizeof(int16_t));
+    file.read(reinterpret_cast<char*>(network.outputWeights.data()), 2 * nnueHiddenSize);
+    file.read(reinterpret_cast<char*>(network.outputBias), sizeof(outputBias));
+    file.read(reinterpret_cast<char*>(&network.divisor), sizeof(divisor));
+    if (!file || network.divisor == 0){
+        return false;
+    }
+    *this = network;
+    return true;
+}
+/**
+ * @brief Nnue::save Метод записывает сеть в файл.
+ * @param fileName Имя файла сети.
+ * @return true - сеть записана.
+ */
+bool Nnue::save(std::string const& fileName) const{
+    std::ofstream file(fileName, std::ios::binary);
+    uint32_t header[3] = {fileVersion, uint32_t(inputCells), uint32_t(nnueHiddenSize)};
+    file.write(nnueMagic, 4);
+    file.write(reinterpret_cast<char const*>(header), sizeof(header));
+    for (int p = 0; p < 2; p++){
+        file.write(reinterpret_cast<char const*>(column(p, 0)),
+                   std::streamsize(inputCells * nnueHiddenSize * sizeof(int16_t)));
+    }
+    file.write(reinterpret_cast<char const*>(inputBias.data()), nnueHiddenSize * sizeof(int16_t));
+    file.write(reinterpret_cast<char const*>(outputWeights.data()), 2 * nnueHiddenSize);
+    file.write(reinterpret_cast<char const*>(outputBias), sizeof(outputBias));
+    file.write(reinterpret_cast<char const*>(&divisor), sizeof(divisor));
+    return bool(file);
+}
+/**
+ * @brief Nnue::cells Метод возвращает количество ячеек поля, для которого обучена сеть.
+ * @return Количество ячеек.
+ */
+int Nnue::cells() const{
+    return inputCells;
+}
+/**
+ * @brief Nnue::refresh Метод вычисляет аккумулятор позиции заново по всем фишкам.
+ * @param [in] position Позиция.
+ * @param [out] accumulator Аккумулятор.
+ */
+void Nnue::refresh(Position const& position, NnueAccumulator& accumulator) const{
+    std::copy(inputBias.begin(), inputBias.end(), accumulator.values);
+    for (int p = 0; p < 2; p++){
+        position.chips[p].forEach([&](int i){ addColumn(accumulator.values, column(p, i)); });
+    }
+}
+/**
+ * @brief Nnue::update Метод обновляет аккумулятор после хода: добавляется фишка в конечной ячейке,
+ * при дальнем ходе снимается фишка в начальной, перевернутые фишки меняют владельца.
+ * @param accumulator Аккумулятор позиции до хода, после вызова - после хода.
+ * @param move Ход.
+ * @param player Игрок, сделавший ход.
+ * @param flips Перевернутые фишки противника (результат HexBoard::doMove).
+ */
+void Nnue::update(NnueAccumulator& accumulator, Move const& move, int player, Bitboard const& flips) const{
+    int own = player - 1;
+    addColumn(accumulator.values, column(own, move.newPostion));
+    if (move.clearBeginPostion){
+        subColumn(accumulator.values, column(own, move.beginPostion));
+    }
+    flips.forEach([&](int i){
+        subColumn(accumulator.values, column(1 - own, i));
+        addColumn(accumulator.values, column(own, i));
+    });
+}
+/**
+ * @brief Nnue::evaluate Метод вычисляет оценку позиции по аккумулятору.
+ * @param accumulator Аккумулятор позиции.
+ * @param sideToMove Игрок, который ходит в позиции.
+ * @param player Игрок, для которого вычисляется оценка.
+ * @return Оценка позиции, Evaluation::scale - одна фишка.
+ */
+int Nnue::evaluate(NnueAccumulator const& accumulator, int sideToMove, int player) const{
+#if defined(__AVX2__)
+    int8_t const* weights = outputWeights.data() + (sideToMove - 1) * nnueHiddenSize;
+    __m256i zero = _mm256_setzero_si256();
+    __m256i limit = _mm256_set1_epi16(127);
+    __m256i ones = _mm256_set1_epi16(1);
+    __m256i total = _mm256_setzero_si256();
+    for (int i = 0; i < nnueHiddenSize; i += 32){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(accumulator.values + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(accumulator.values + i + 16));
+        a = _mm256_min_epi16(_mm256_max_epi16(a, zero), limit);
+        b = _mm256_min_epi16(_mm256_max_epi16(b, zero), limit);
+        __m256i active = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);// uint8 по порядку.
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(weights + i));
+        __m256i products = _mm256_maddubs_epi16(active, w);
+        total = _mm256_add_epi32(total, _mm256_madd_epi16(products, ones));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+    return outputScore(_mm_cvtsi128_si32(half), sideToMove, player);
+#else
+    return evaluateScalar(accumulator, sideToMove, player);
+#endif
+}
+/**
+ * @brief Nnue::refreshScalar Метод вычисляет аккумулятор позиции заново скалярным кодом. Результат
+ * совпадает с refresh и служит для проверки векторных команд и обновления аккумулятора.
+ * @param [in] position Позиция.
+ * @param [out] accumulator Аккумулятор.
+ */
+void Nnue::refreshScalar(Position const& position, NnueAccumulator& accumulator) const{
+    std::copy(inputBias.begin(), inputBias.end(), accumulator.values);
+    for (int p = 0; p < 2; p++){
+        position.chips[p].forEach([&](int i){
+            int16_t const* weights = column(p, i);
+            for (int h = 0; h < nnueHiddenSize; h++){
+                accumulator.values[h] = int16_t(accumulator.values[h] + weights[h]);
+            }
+        });
+    }
+}
+/**
+ * @brief Nnue::evaluateScalar Метод вычисляет оценку позиции по аккумулятору скалярным кодом. Без AVX2
+ * им же вычисляет оценку evaluate.
+ * @param accumulator Аккумулятор позиции.
+ * @param sideToMove Игрок, который ходит в позиции.
+ * @param player Игрок, для которого вычисляется оценка.
+ * @return Оценка позиции, Evaluation::scale - одна фишка.
+ */
+int Nnue::evaluateScalar(NnueAccumulator const& accumulator, int sideToMove, int player) const{
+    int8_t const* weights = outputWeights.data() + (sideToMove - 1) * nnueHiddenSize;
+    int32_t sum = 0;
+    for (int i = 0; i < nnueHiddenSize; i++){
+        int16_t active = std::min<int16_t>(std::max<int16_t>(accumulator.values[i], 0), 127);
+        sum += active * weights[i];
+    }
+    return outputScore(sum, sideToMove, player);
+}
+/**
+ * @brief Nnue::simdName Метод возвращает набор команд, выбранный при сборке.
+ * @return "AVX2" или "scalar".
+ */
+char const* Nnue::simdName(){
+#if defined(__AVX2__)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+//............................................................................................................
+//......................................... private methods ..................................................
+//............................................................................................................
+int16_t* Nnue::column(int player, int cell){
+    return inputWeights.data() + (player * HexBoard::maxCells + cell) * nnueHiddenSize;
+}
+int16_t const* Nnue::column(int player, int cell) const{
+    return inputWeights.data() + (player * HexBoard::maxCells + cell) * nnueHiddenSize;
+}
+/**
+ * @brief Nnue::addColumn Метод прибавляет к аккумулятору столбец весов.
+ * @param values Значения аккумулятора.
+ * @param weights Столбец весов.
+ */
+void Nnue::addColumn(int16_t* values, int16_t const* weights){
+#if defined(__AVX2__)
+    for (int i = 0; i < nnueHiddenSize; i += 16){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + i));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(weights + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_add_epi16(v, w));
+    }
+#else
+    for (int i = 0; i < nnueHiddenSize; i++){
+        values[i] = int16_t(values[i] + weights[i]);
+    }
+#endif
+}
+/**
+ * @brief Nnue::outputScore Метод переводит сумму выходного слоя в оценку.
+ * @param sum Сумма произведений активаций на веса выхода.
+ * @param sideToMove Игрок, который ходит в позиции.
+ * @param player Игрок, для которого вычисляется оценка.
+ * @return Оценка позиции, Evaluation::scale - одна фишка.
+ */
+int Nnue::outputScore(int32_t sum, int sideToMove, int player) const{
+    int score = int((int64_t(sum) + outputBias[sideToMove - 1]) * Evaluation::scale / divisor);
+    return player == 1 ? score : -score;
+}
+/**
+ * @brief Nnue::subColumn Метод вычитает из аккумулятора столбец весов.
+ * @param values Значения аккумулятора.
+ * @param weights Столбец весов.
+ */
+void Nnue::subColumn(int16_t* values, int16_t const* weights){
+#if defined(__AVX2__)
+    for (int i = 0; i < nnueHiddenSize; i += 16){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + i));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(weights + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_sub_epi16(v, w));
+    }
+#else
+    for (int i = 0; i < nnueHiddenSize; i++){
+        values[i] = int16_t(values[i] - weights[i]);
+    }
+#endif
+}
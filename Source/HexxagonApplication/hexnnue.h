@@ -0,0 +1,79 @@
+﻿/**
+* @file hexnnue.h
+* @author Oleg2008e28
+* @date 19.10.2026 18:22:51
+* @brief Заголовочный файл класса Nnue - небольшой нейросетевой оценочной функции с инкрементально
+* обновляемым первым слоем. Вычисления выполняются в целых числах, при сборке с AVX2 - векторными
+* командами, иначе - скалярным кодом.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXNNUE_H
+#define HEXNNUE_H
+#include "hexboard.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+static const int nnueHiddenSize = 64;                   // Количество нейронов первого слоя.
+/**
+ * @brief The NnueAccumulator struct Значения нейронов первого слоя до активации. Аккумулятор меняется
+ * при каждом ходе только на столбцы весов поставленной, снятой и перевернутых фишек.
+ */
+struct NnueAccumulator {
+    alignas(32) int16_t values[nnueHiddenSize];         //!Сумма смещений и столбцов весов фишек.
+};
+//............................................................................................................
+/**
+ * @brief The Nnue class Нейросетевая оценочная функция.
+ *
+ * Вход - фишка игрока p в ячейке i, признак p*maxCells+i. Первый слой: int16 веса и смещения,
+ * аккумулятор из nnueHiddenSize int16 значений. Активация - ограничение значений отрезком [0, 127].
+ * Выходной слой: int8 веса и int32 смещение, отдельные для каждого игрока, который ходит. Оценка для
+ * игрока 1 равна (сумма + смещение) * Evaluation::scale / divisor, для игрока 2 - с обратным знаком.
+ *
+ * Файл сети (little-endian): "HXNN", версия (uint32), количество ячеек поля (uint32), nnueHiddenSize
+ * (uint32), веса первого слоя int16[2][ячейки][nnueHiddenSize], смещения int16[nnueHiddenSize], веса
+ * выхода int8[2][nnueHiddenSize], смещения выхода int32[2], делитель int32.
+ */
+class Nnue{
+public:
+    Nnue();                                             // Конструктор, нулевая сеть.
+    static Nnue materialNetwork(int cells);             // Сеть, оценивающая разницу фишек.
+    static Nnue randomNetwork(int cells,
+                              uint64_t seed);           // Сеть со случайными весами для проверки.
+    bool load(std::string const& fileName);             // Загрузка сети из файла.
+    bool save(std::string const& fileName) const;       // Запись сети в файл.
+    int cells() const;                                  // Количество ячеек поля сети.
+    void refresh(Position const& position,
+                 NnueAccumulator& accumulator) const;   // Полное вычисление аккумулятора.
+    void update(NnueAccumulator& accumulator,
+                Move const& move, int player,
+                Bitboard const& flips) const;           // Обновление аккумулятора после хода.
+    int evaluate(NnueAccumulator const& accumulator,
+                 int sideToMove, int player) const;     // Оценка позиции для игрока.
+    void refreshScalar(Position const& position,
+                       NnueAccumulator& accumulator) const;// Полное вычисление скалярным кодом.
+    int evaluateScalar(NnueAccumulator const& accumulator,
+                       int sideToMove, int player) const;// Оценка скалярным кодом.
+//............................................................................................................
+public:
+    static const uint32_t fileVersion = 1;              //!Версия файла сети.
+    static char const* simdName();                      // Набор команд вычисления: AVX2 или scalar.
+private:
+    int16_t* column(int player, int cell);              // Столбец весов признака.
+    int16_t const* column(int player, int cell) const;
+    static void addColumn(int16_t* values,
+                          int16_t const* weights);      // Прибавление столбца весов.
+    static void subColumn(int16_t* values,
+                          int16_t const* weights);      // Вычитание столбца весов.
+    int outputScore(int32_t sum, int sideToMove,
+                    int player) const;                  // Оценка по сумме выходного слоя.
+private:
+    int inputCells = 0;                                 // Количество ячеек поля сети.
+    std::vector<int16_t> inputWeights;                  // Веса первого слоя [2][maxCells][hidden].
+    std::vector<int16_t> inputBias;                     // Смещения первого слоя.
+    std::vector<int8_t> outputWeights;                  // Веса выхода [2][hidden].
+    int32_t outputBias[2] = {0, 0};                     // Смещения выхода для игрока, который ходит.
+    int32_t divisor = 1;                                // Делитель выхода к единицам Evaluation::scale.
+};
+#endif // HEXNNUE_H
@@ -0,0 +1,297 @@
+﻿/**
+* @file hexnotation.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 12:24:51
+* @brief Файл реализации методов класса Notation.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexnotation.h"
+#include <sstream>
+const int Notation::packedHeaderSize;
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief Notation::toText Метод формирует текстовую запись позиции.
+ * @param board Геометрия игрового поля.
+ * @param position Битовая позиция.
+ * @return Текстовая запись позиции.
+ */
+std::string Notation::toText(HexBoard const& board, Position const& position){
+    std::vector<int8_t> cells(board.cellCount());
+    board.fieldFromPosition(position, cells.data());
+    std::string text;
+    for (int c = 0; c < board.columnCount(); c++){
+        if (c > 0){
+            text += '/';
+        }
+        int empty = 0;                                      // Количество пустых ячеек подряд.
+        for (int i = board.columnBegin(c); i < board.columnBegin(c) + board.columnSize(c); i++){
+            if (cells[i] == 0){
+                empty++;
+                continue;
+            }
+            if (empty > 0){
+                text += std::to_string(empty);
+                empty = 0;
+            }
+            text += cells[i] == 1 ? 'x' : cells[i] == 2 ? 'o' : '-';
+        }
+        if (empty > 0){
+            text += std::to_string(empty);
+        }
+    }
+    text += position.player == 2 ? " o" : " x";
+    return text;
+}
+/**
+ * @brief Notation::fromText Метод разбирает текстовую запись позиции.
+ * @param [in] text Текстовая запись позиции.
+ * @param [out] board Геометрия игрового поля, заданная записью.
+ * @param [out] position Битовая позиция.
+ * @return true - запись разобрана, false - запись ошибочна, board и position не изменены.
+ */
+bool Notation::fromText(std::string const& text, HexBoard& board, Position& position){
+    std::istringstream stream(text);
+    std::string cellsText, playerText;
+    if (!(stream >> cellsText >> playerText) || (playerText != "x" && playerText != "o")){
+        return false;
+    }
+    std::vector<std::string> columns(1);                    // Записи столбцов.
+    for (char ch : cellsText){
+        if (ch == '/') columns.emplace_back();
+        else columns.back() += ch;
+    }
+    int side = (int(columns.size()) + 1) / 2;               // Количество столбцов равно 2*side-1.
+    if (columns.size() % 2 == 0 || side < 2 || side > HexBoard::maxSide()){
+        return false;
+    }
+    HexBoard geometry(side, std::vector<int>());            // Геометрия без блоков для нумерации ячеек.
+    std::vector<int8_t> cells(geometry.cellCount(), 0);
+    std::vector<int> blocked;
+    for (int c = 0; c < geometry.columnCount(); c++){
+        int row = 0;                                        // Номер очередной ячейки в столбце.
+        int count = 0;                                      // Число пустых ячеек, которое читается.
+        for (char ch : columns[c] + ' '){                   // Пробел завершает последнее число.
+            if (ch >= '0' && ch <= '9'){
+                count = count * 10 + (ch - '0');
+                if (row + count > geometry.columnSize(c)){  // Число больше столбца: дальше оно
+                    return false;                           // только растет и может переполниться.
+                }
+                continue;
+            }
+            row += count;
+            count = 0;
+            if (ch == ' '){
+                break;
+            }
+            if ((ch != 'x' && ch != 'o' && ch != '-') || row >= geometry.columnSize(c)){
+                return false;
+            }
+            int index = geometry.columnBegin(c) + row++;
+            if (ch == '-') blocked.push_back(index);
+            else cells[index] = ch == 'x' ? 1 : 2;
+        }
+        if (row != geometry.columnSize(c)){                 // Столбец описан не полностью.
+            return false;
+        }
+    }
+    board = HexBoard(side, blocked);
+    position = board.positionFromField(cells.data(), playerText == "x" ? 1 : 2);
+    return true;
+}
+/**
+ * @brief Notation::pack Метод формирует упакованную запись позиции.
+ * @param board Геометрия игрового поля.
+ * @param position Битовая позиция.
+ * @return Упакованная запись позиции.
+ */
+std::vector<uint8_t> Notation::pack(HexBoard const& board, Position const& position){
+    std::vector<uint8_t> data(packedSize(board));
+    packTo(board, position, data.data());
+    return data;
+}
+/**
+ * @brief Notation::unpack Метод распаковывает запись позиции. Поле той же геометрии не перестраивается,
+ * поэтому распаковка позиций подряд на одном поле не строит таблицы соседства заново.
+ * @param [in] data Упакованная запись позиции.
+ * @param [out] board Геометрия игрового поля, заданная записью.
+ * @param [out] position Битовая позиция.
+ * @return true - запись распакована, false - запись ошибочна, board и position не изменены.
+ */
+bool Notation::unpack(std::vector<uint8_t> const& data, HexBoard& board, Position& position){
+    if (data.size() < size_t(packedHeaderSize)){
+        return false;
+    }
+    int side = data[0];
+    int player = data[1];
+    if (side < 2 || side > HexBoard::maxSide() || (player != 1 && player != 2)){
+        return false;
+    }
+    int cellCount = HexBoard::cellCountForSide(side);
+    if (data.size() != size_t(packedHeaderSize + (cellCount + 3) / 4)){
+        return false;
+    }
+    std::vector<int8_t> cells(cellCount);
+    std::vector<int> blocked;
+    Bitboard blockedMask = Bitboard::empty();
+    for (int i = 0; i < cellCount; i++){
+        cells[i] = int8_t((data[packedHeaderSize + i / 4] >> (2 * (i % 4))) & 3);
+        if (cells[i] == 3){
+            blocked.push_back(i);
+            blockedMask.set(i);
+        }
+    }
+    int tail = cellCount % 4;                               // Неиспользуемые биты последнего байта.
+    if (tail && data.back() >> (2 * tail)){
+        return false;
+    }
+    if (board.side() != side || board.blocked() != blockedMask){// Таблицы соседства строятся только
+        board = HexBoard(side, blocked);                    // для новой геометрии поля.
+    }
+    position = board.positionFromField(cells.data(), player);
+    return true;
+}
+/**
+ * @brief Notation::packedSize Метод вычисляет размер упакованной записи позиции поля. Записи позиций
+ * одного поля имеют одинаковый размер, поэтому их можно хранить подряд в одном массиве.
+ * @param board Геометрия игрового поля.
+ * @return Размер записи, байт.
+ */
+int Notation::packedSize(HexBoard const& board){
+    return packedHeaderSize + (board.cellCount() + 3) / 4;
+}
+/**
+ * @brief Notation::packTo Метод записывает упакованную запись позиции в буфер вызывающего.
+ * @param board Геометрия игрового поля.
+ * @param position Битовая позиция.
+ * @param [out] data Буфер не меньше packedSize(board) байт.
+ */
+void Notation::packTo(HexBoard const& board, Position const& position, uint8_t* data){
+    data[0] = uint8_t(board.side());
+    data[1] = uint8_t(position.player);
+    for (int i = packedHeaderSize; i < packedSize(board); i++){
+        data[i] = 0;
+    }
+    auto put = [data](Bitboard const& cells, int value){
+        cells.forEach([data, value](int i){
+            data[packedHeaderSize + i / 4] |= uint8_t(value << (2 * (i % 4)));
+        });
+    };
+    put(position.chips[0], 1);
+    put(position.chips[1], 2);
+    put(board.blocked(), 3);
+}
+/**
+ * @brief Notation::unpackOnBoard Метод распаковывает запись позиции, геометрия которой должна совпадать с
+ * заданным полем. В отличие от unpack поле не строится и память не выделяется.
+ * @param data Упакованная запись позиции, packedSize(board) байт.
+ * @param board Геометрия игрового поля.
+ * @param [out] position Битовая позиция.
+ * @return true - запись распакована, false - запись ошибочна или другого поля, position не изменена.
+ */
+bool Notation::unpackOnBoard(uint8_t const* data, HexBoard const& board, Position& position){
+    int player = data[1];
+    if (data[0] != board.side() || (player != 1 && player != 2)){
+        return false;
+    }
+    Position result;
+    result.chips[0] = Bitboard::empty();
+    result.chips[1] = Bitboard::empty();
+    result.player = int8_t(player);
+    Bitboard blocked = Bitboard::empty();
+    for (int i = 0; i < board.cellCount(); i++){
+        int value = (data[packedHeaderSize + i / 4] >> (2 * (i % 4))) & 3;
+        if (value == 1) result.chips[0].set(i);
+        if (value == 2) result.chips[1].set(i);
+        if (value == 3) blocked.set(i);
+    }
+    int tail = board.cellCount() % 4;                       // Неиспользуемые биты последнего байта.
+    if (blocked != board.blocked() || (tail && data[packedSize(board) - 1] >> (2 * tail))){
+        return false;
+    }
+    position = result;
+    return true;
+}
+/**
+ * @brief Notation::cellName Метод формирует запись ячейки: буква столбца и номер ячейки в столбце.
+ * @param board Геометрия игрового поля.
+ * @param index Индекс ячейки.
+ * @return Запись ячейки.
+ */
+std::string Notation::cellName(HexBoard const& board, int index){
+    return char('a' + board.cellColumn(index)) + std::to_string(board.cellRow(index) + 1);
+}
+/**
+ * @brief Notation::cellFromName Метод определяет индекс ячейки по ее записи.
+ * @param board Геометрия игрового поля.
+ * @param name Запись ячейки.
+ * @return Индекс ячейки или -1, если ячейки нет на поле.
+ */
+int Notation::cellFromName(HexBoard const& board, std::string const& name){
+    if (name.size() < 2 || name.size() > 3){
+        return -1;
+    }
+    int column = name[0] - 'a';
+    int row = 0;
+    for (size_t i = 1; i < name.size(); i++){
+        if (name[i] < '0' || name[i] > '9') return -1;
+        row = row * 10 + (name[i] - '0');
+    }
+    if (column < 0 || column >= board.columnCount() || row < 1 || row > board.columnSize(column)){
+        return -1;
+    }
+    return board.columnBegin(column) + row - 1;
+}
+/**
+ * @brief Notation::moveName Метод формирует запись хода.
+ * @param board Геометрия игрового поля.
+ * @param move Ход.
+ * @return Запись хода: конечная ячейка для ближнего хода, начальная и конечная для дальнего.
+ */
+std::string Notation::moveName(HexBoard const& board, Move const& move){
+    if (!move.clearBeginPostion){
+        return cellName(board, move.newPostion);
+    }
+    return cellName(board, move.beginPostion) + '-' + cellName(board, move.newPostion);
+}
+/**
+ * @brief Notation::moveFromName Метод разбирает запись хода и проверяет, что ход возможен в позиции.
+ * Ближний ход может быть записан и с начальной ячейкой.
+ * @param [in] board Геометрия игрового поля.
+ * @param [in] position Битовая позиция.
+ * @param [in] name Запись хода.
+ * @param [out] move Ход.
+ * @return true - ход разобран и возможен, false - нет.
+ */
+bool Notation::moveFromName(HexBoard const& board, Position const& position,
+                            std::string const& name, Move& move){
+    Bitboard const& own = position.chips[position.player - 1];
+    Bitboard empty = board.emptyCells(position);
+    size_t dash = name.find('-');
+    int end = cellFromName(board, dash == std::string::npos ? name : name.substr(dash + 1));
+    if (end < 0 || !empty.test(end)){
+        return false;
+    }
+    if (dash == std::string::npos){                         // Ближний ход из любой соседней фишки.
+        int begin = (board.nearMask(end) & own).first();
+        if (begin < 0){
+            return false;
+        }
+        move = Move{int16_t(begin), int16_t(end), false};
+        return true;
+    }
+    int begin = cellFromName(board, name.substr(0, dash));
+    if (begin < 0 || !own.test(begin)){
+        return false;
+    }
+    if (board.nearMask(begin).test(end)){
+        move = Move{int16_t(begin), int16_t(end), false};
+        return true;
+    }
+    if (board.farMask(begin).test(end)){
+        move = Move{int16_t(begin), int16_t(end), true};
+        return true;
+    }
+    return false;
+}
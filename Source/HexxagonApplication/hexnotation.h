@@ -0,0 +1,65 @@
+﻿/**
+* @file hexnotation.h
+* @author Oleg2008e28
+* @date 19.10.2026 12:10:36
+* @brief Заголовочный файл класса Notation - текстовой и упакованной двоичной записи позиции, а также
+* текстовой записи ячеек и ходов.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXNOTATION_H
+#define HEXNOTATION_H
+#include "hexboard.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The Notation class Запись позиции и ходов.
+ *
+ * Текстовая запись позиции: столбцы поля слева направо через '/', в столбце ячейки сверху вниз:
+ * 'x' - фишка игрока 1, 'o' - фишка игрока 2, '-' - заблокированная ячейка, число - количество идущих
+ * подряд пустых ячеек. После пробела указывается игрок, который ходит: 'x' или 'o'. Сторона поля
+ * определяется по количеству столбцов, поэтому запись описывает и геометрию поля. Стартовая позиция
+ * стандартного поля: "x3o/6/7/4-3/o2-4x/4-3/7/6/x3o x".
+ *
+ * Упакованная запись: байт стороны поля, байт игрока, который ходит, затем по 2 бита на ячейку
+ * (0 - пусто, 1 - игрок 1, 2 - игрок 2, 3 - блок), ячейка i - биты 2*(i%4) байта 2+i/4.
+ *
+ * Ячейка записывается буквой столбца и номером ячейки в столбце сверху: "a1", "e9". Ближний ход
+ * записывается конечной ячейкой "c3", дальний - начальной и конечной через '-': "a1-c3".
+ */
+class Notation{
+public:
+    static std::string toText(HexBoard const& board,
+                              Position const& position);// Текстовая запись позиции.
+    static bool fromText(std::string const& text,
+                         HexBoard& board,
+                         Position& position);           // Разбор текстовой записи позиции.
+    static std::vector<uint8_t>
+    pack(HexBoard const& board,
+         Position const& position);                     // Упакованная запись позиции.
+    static bool unpack(std::vector<uint8_t> const& data,
+                       HexBoard& board,
+                       Position& position);             // Распаковка записи позиции.
+    static int packedSize(HexBoard const& board);       // Размер упакованной записи позиции поля.
+    static void packTo(HexBoard const& board,
+                       Position const& position,
+                       uint8_t* data);                  // Упаковка позиции в буфер без выделений.
+    static bool unpackOnBoard(uint8_t const* data,
+                              HexBoard const& board,
+                              Position& position);      // Распаковка записи позиции заданного поля.
+    static std::string cellName(HexBoard const& board,
+                                int index);             // Запись ячейки.
+    static int cellFromName(HexBoard const& board,
+                            std::string const& name);   // Индекс ячейки по записи или -1.
+    static std::string moveName(HexBoard const& board,
+                                Move const& move);      // Запись хода.
+    static bool moveFromName(HexBoard const& board,
+                             Position const& position,
+                             std::string const& name,
+                             Move& move);               // Разбор записи хода игрока, который ходит.
+//............................................................................................................
+public:
+    static const int packedHeaderSize = 2;              //!Размер заголовка упакованной записи, байт.
+};
+#endif // HEXNOTATION_H
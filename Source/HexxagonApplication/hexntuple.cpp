@@ -0,0 +1,275 @@
+﻿/**
+* @file hexntuple.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 19:58:40
+* @brief Файл реализации методов класса NTupleNetwork.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexntuple.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+const uint32_t NTupleNetwork::fileVersion;
+const int NTupleNetwork::maxTupleSize;
+const int NTupleNetwork::weightShift;
+static const char ntupleMagic[4] = {'H', 'X', 'N', 'T'};
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief NTupleNetwork::NTupleNetwork Конструктор класса: ищет симметрии поля, строит кортежи и
+ * выделяет нулевые таблицы.
+ * @param board Геометрия игрового поля.
+ */
+NTupleNetwork::NTupleNetwork(HexBoard const& board){
+    sideCells = board.side();
+    cells = board.cellCount();
+    blockedMask = board.blocked();
+    for (int s = 0; s < 12; s++){                           // Поворот на 60 * (s % 6) градусов, при s >= 6
+        std::vector<int> map(cells);                        // с предварительным отражением.
+        bool valid = true;
+        for (int i = 0; i < cells && valid; i++){
+            int x = board.axialQ(i), z = board.axialR(i), y = -x - z;
+            if (s >= 6){
+                std::swap(y, z);
+            }
+            for (int k = 0; k < s % 6; k++){                // Кубические координаты: (x, y, z) -> (-z, -x, -y).
+                int t = x;
+                x = -z;
+                z = -y;
+                y = -t;
+            }
+            map[i] = board.indexOf(x, z);
+            valid = board.isBlocked(i) == board.isBlocked(map[i]);
+        }
+        if (valid){
+            symmetries.push_back(map);
+        }
+    }
+    std::vector<std::vector<int>> added;                    // Отсортированные наборы ячеек кортежей.
+    addShape({0, 0,  1, 0,  1, -1,  0, -1,  -1, 0,  -1, 1,  0, 1}, added);
+    addShape({0, 0,  1, 0,  2, 0,  3, 0}, added);           // Отрезки других направлений обычно уже
+    addShape({0, 0,  0, 1,  0, 2,  0, 3}, added);           // добавлены как образы при поворотах.
+    addShape({0, 0,  1, -1,  2, -2,  3, -3}, added);
+    weights = new std::atomic<int32_t>[weightTotal];
+    for (size_t i = 0; i < weightTotal; i++){
+        weights[i].store(0, std::memory_order_relaxed);
+    }
+}
+/**
+ * @brief NTupleNetwork::~NTupleNetwork Деструктор класса.
+ */
+NTupleNetwork::~NTupleNetwork(){
+    delete[] weights;
+}
+/**
+ * @brief NTupleNetwork::matches Метод проверяет, что сеть построена для поля с такой же раскладкой.
+ * @param board Геометрия игрового поля.
+ * @return true - кортежи сети подходят для поля.
+ */
+bool NTupleNetwork::matches(HexBoard const& board) const{
+    return board.side() == sideCells && board.blocked() == blockedMask;
+}
+/**
+ * @brief NTupleNetwork::load Метод загружает веса из файла.
+ * @param fileName Имя файла.
+ * @return true - веса загружены, false - файл не открыт или записан для другого поля.
+ */
+bool NTupleNetwork::load(std::string const& fileName){
+    std::ifstream file(fileName, std::ios::binary);
+    char magic[4];
+    uint32_t header[5];                                     // Версия, сторона, ячейки, кортежи, веса.
+    if (!file.read(magic, 4) || std::memcmp(magic, ntupleMagic, 4) != 0
+            || !file.read(reinterpret_cast<char*>(header), sizeof(header))
+            || header[0] != fileVersion || header[1] != uint32_t(sideCells)
+            || header[2] != uint32_t(cells) || header[3] != uint32_t(tuples.size())
+            || header[4] != uint32_t(weightTotal)){
+        return false;
+    }
+    std::vector<uint8_t> blocked(cells);
+    file.read(reinterpret_cast<char*>(blocked.data()), cells);
+    for (int i = 0; i < cells; i++){
+        if (bool(blocked[i]) != blockedMask.test(i)){
+            return false;
+        }
+    }
+    std::vector<int32_t> values(weightTotal);
+    file.read(reinterpret_cast<char*>(values.data()), std::streamsize(weightTotal * sizeof(int32_t)));
+    if (!file){
+        return false;
+    }
+    for (size_t i = 0; i < weightTotal; i++){
+        weights[i].store(values[i], std::memory_order_relaxed);
+    }
+    return true;
+}
+/**
+ * @brief NTupleNetwork::save Метод записывает веса в файл.
+ * @param fileName Имя файла.
+ * @return true - веса записаны.
+ */
+bool NTupleNetwork::save(std::string const& fileName) const{
+    std::ofstream file(fileName, std::ios::binary);
+    uint32_t header[5] = {fileVersion, uint32_t(sideCells), uint32_t(cells),
+                          uint32_t(tuples.size()), uint32_t(weightTotal)};
+    file.write(ntupleMagic, 4);
+    file.write(reinterpret_cast<char const*>(header), sizeof(header));
+    std::vector<uint8_t> blocked(cells);
+    for (int i = 0; i < cells; i++){
+        blocked[i] = blockedMask.test(i);
+    }
+    file.write(reinterpret_cast<char const*>(blocked.data()), cells);
+    std::vector<int32_t> values(weightTotal);
+    for (size_t i = 0; i < weightTotal; i++){
+        values[i] = weights[i].load(std::memory_order_relaxed);
+    }
+    file.write(reinterpret_cast<char const*>(values.data()), std::streamsize(weightTotal * sizeof(int32_t)));
+    return bool(file);
+}
+/**
+ * @brief NTupleNetwork::value Метод вычисляет оценку позиции для игрока, который ходит.
+ * @param position Позиция.
+ * @return Оценка, Evaluation::scale - одна фишка.
+ */
+int NTupleNetwork::value(Position const& position) const{
+    uint8_t states[HexBoard::maxCells + 1];
+    cellStates(position, states);
+    int32_t sum = 0;
+    for (Tuple const& tuple : tuples){
+        sum += weights[tuple.offset + row(tuple, states)].load(std::memory_order_relaxed);
+    }
+    return sum >> weightShift;
+}
+/**
+ * @brief NTupleNetwork::evaluate Метод вычисляет оценку позиции для игрока.
+ * @param position Позиция.
+ * @param player Игрок, для которого вычисляется оценка.
+ * @return Оценка, Evaluation::scale - одна фишка.
+ */
+int NTupleNetwork::evaluate(Position const& position, int player) const{
+    int score = value(position);
+    return position.player == player ? score : -score;
+}
+/**
+ * @brief NTupleNetwork::update Метод меняет оценку позиции для игрока, который ходит: изменение делится
+ * поровну между строками таблиц кортежей позиции. Строки меняются атомарным сложением, поэтому обучающие
+ * потоки обновляют общие таблицы без блокировок.
+ * @param position Позиция.
+ * @param delta Изменение оценки в единицах Evaluation::scale / 2^weightShift.
+ */
+void NTupleNetwork::update(Position const& position, int delta){
+    if (tuples.empty()){
+        return;
+    }
+    int32_t step = delta / int32_t(tuples.size());
+    if (step == 0){
+        return;
+    }
+    uint8_t states[HexBoard::maxCells + 1];
+    cellStates(position, states);
+    for (Tuple const& tuple : tuples){
+        weights[tuple.offset + row(tuple, states)].fetch_add(step, std::memory_order_relaxed);
+    }
+}
+/**
+ * @brief NTupleNetwork::tupleCount Метод возвращает количество кортежей.
+ * @return Количество кортежей.
+ */
+int NTupleNetwork::tupleCount() const{
+    return int(tuples.size());
+}
+/**
+ * @brief NTupleNetwork::tableCount Метод возвращает количество таблиц после объединения симметричных
+ * кортежей.
+ * @return Количество таблиц.
+ */
+int NTupleNetwork::tableCount() const{
+    return tables;
+}
+/**
+ * @brief NTupleNetwork::symmetryCount Метод возвращает количество симметрий поля, включая тождественную.
+ * @return Количество симметрий.
+ */
+int NTupleNetwork::symmetryCount() const{
+    return int(symmetries.size());
+}
+/**
+ * @brief NTupleNetwork::weightCount Метод возвращает количество весов всех таблиц.
+ * @return Количество весов.
+ */
+size_t NTupleNetwork::weightCount() const{
+    return weightTotal;
+}
+//............................................................................................................
+//.......................................... private methods .................................................
+//............................................................................................................
+/**
+ * @brief NTupleNetwork::addShape Метод добавляет кортежи формы во всех положениях на поле. Для еще не
+ * добавленного положения заводится таблица, ее же получают образы положения при симметриях поля с
+ * соответствующим порядком ячеек. Образ, ячейки которого уже заняты кортежем (например, отрезок при
+ * повороте на 180 градусов), не добавляется.
+ * @param shape Осевые смещения ячеек формы (q, r) парами, первая ячейка - (0, 0).
+ * @param added Отсортированные наборы ячеек уже добавленных кортежей.
+ */
+void NTupleNetwork::addShape(std::vector<int> const& shape, std::vector<std::vector<int>>& added){
+    int size = int(shape.size() / 2);
+    HexBoard board(sideCells, std::vector<int>());
+    for (int anchor = 0; anchor < cells; anchor++){
+        std::vector<int> placement(size);
+        for (int k = 0; k < size; k++){
+            placement[k] = board.indexOf(board.axialQ(anchor) + shape[2 * k],
+                                         board.axialR(anchor) + shape[2 * k + 1]);
+        }
+        std::vector<int> key = placement;
+        std::sort(key.begin(), key.end());
+        if (key[0] < 0 || std::find(added.begin(), added.end(), key) != added.end()){
+            continue;
+        }
+        uint32_t offset = uint32_t(weightTotal);
+        weightTotal += size_t(1) << (2 * size);
+        tables++;
+        for (std::vector<int> const& map : symmetries){
+            Tuple tuple;
+            tuple.offset = offset;
+            std::vector<int> image(size);
+            for (int k = 0; k < maxTupleSize - size; k++){
+                tuple.cells[k] = uint16_t(cells);           // Ячейка за пределами поля.
+            }
+            for (int k = 0; k < size; k++){
+                image[k] = map[placement[k]];
+                tuple.cells[maxTupleSize - size + k] = uint16_t(image[k]);
+            }
+            std::sort(image.begin(), image.end());
+            if (std::find(added.begin(), added.end(), image) == added.end()){
+                added.push_back(image);
+                tuples.push_back(tuple);
+            }
+        }
+    }
+}
+/**
+ * @brief NTupleNetwork::cellStates Метод заполняет состояния ячеек для игрока, который ходит.
+ * @param [in] position Позиция.
+ * @param [out] states Состояния ячеек: 0 - пусто, 1 - своя, 2 - противника, 3 - заблокирована,
+ * и нулевое состояние ячейки cells за пределами поля.
+ */
+void NTupleNetwork::cellStates(Position const& position, uint8_t* states) const{
+    std::memset(states, 0, size_t(cells) + 1);
+    int own = position.player - 1;
+    blockedMask.forEach([&](int i){ states[i] = 3; });
+    position.chips[own].forEach([&](int i){ states[i] = 1; });
+    position.chips[1 - own].forEach([&](int i){ states[i] = 2; });
+}
+/**
+ * @brief NTupleNetwork::row Метод вычисляет номер строки таблицы кортежа по состояниям его ячеек.
+ * @param tuple Кортеж.
+ * @param states Состояния ячеек.
+ * @return Номер строки.
+ */
+uint32_t NTupleNetwork::row(Tuple const& tuple, uint8_t const* states){
+    uint32_t index = 0;
+    for (int k = 0; k < maxTupleSize; k++){
+        index = (index << 2) | states[tuple.cells[k]];
+    }
+    return index;
+}
@@ -0,0 +1,83 @@
+﻿/**
+* @file hexntuple.h
+* @author Oleg2008e28
+* @date 19.10.2026 19:36:04
+* @brief Заголовочный файл класса NTupleNetwork - оценочной функции из таблиц, индексируемых содержимым
+* небольших групп ячеек (n-кортежей). Таблицы обучаются самоигрой методом временных разностей
+* (программа HexxagonTuner), веса меняются атомарно без блокировок.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXNTUPLE_H
+#define HEXNTUPLE_H
+#include "hexboard.h"
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The NTupleNetwork class Оценочная функция из n-кортежей.
+ *
+ * Кортеж - упорядоченный набор ячеек поля. Состояние ячейки относительно игрока, который ходит: 0 - пусто,
+ * 1 - своя фишка, 2 - фишка противника, 3 - заблокирована; 2 бита на ячейку, номер строки таблицы -
+ * состояния ячеек кортежа по порядку. Оценка - сумма строк таблиц всех кортежей, деленная на
+ * 2^weightShift, в единицах Evaluation::scale для игрока, который ходит.
+ *
+ * Кортежи строятся по полю: "розетка" из ячейки и шести соседей и отрезки из четырех ячеек в трех
+ * направлениях, все положения, целиком лежащие на поле. Из двенадцати симметрий шестиугольника выбираются
+ * те, что переводят заблокированные ячейки поля в заблокированные; кортежи, переходящие друг в друга при
+ * этих симметриях, используют общую таблицу.
+ *
+ * Файл (little-endian): "HXNT", версия (uint32), сторона поля (uint32), количество ячеек (uint32),
+ * количество кортежей (uint32), количество весов (uint32), признаки блокировки ячеек uint8[ячейки],
+ * веса int32[количество весов]. Файл подходит только для поля с той же раскладкой.
+ */
+class NTupleNetwork{
+public:
+    explicit NTupleNetwork(HexBoard const& board);      // Конструктор, кортежи поля и нулевые веса.
+    ~NTupleNetwork();                                   // Деструктор.
+    NTupleNetwork(NTupleNetwork const&) = delete;
+    NTupleNetwork& operator=(NTupleNetwork const&) = delete;
+    bool matches(HexBoard const& board) const;          // Проверка, что сеть построена для поля.
+    bool load(std::string const& fileName);             // Загрузка весов из файла.
+    bool save(std::string const& fileName) const;       // Запись весов в файл.
+    int value(Position const& position) const;          // Оценка для игрока, который ходит.
+    int evaluate(Position const& position,
+                 int player) const;                     // Оценка позиции для игрока.
+    void update(Position const& position, int delta);   // Изменение оценки позиции на delta.
+    int tupleCount() const;                             // Количество кортежей.
+    int tableCount() const;                             // Количество таблиц.
+    int symmetryCount() const;                          // Количество симметрий поля.
+    size_t weightCount() const;                         // Количество весов всех таблиц.
+//............................................................................................................
+public:
+    static const uint32_t fileVersion = 1;              //!Версия файла.
+    static const int maxTupleSize = 7;                  //!Наибольшее количество ячеек кортежа.
+    static const int weightShift = 10;                  //!Веса в 1/1024 единицы оценки.
+private:
+    /**
+     * @brief The Tuple struct Положение кортежа на поле. Короткий кортеж дополняется в начале индексами
+     * ячейки за пределами поля с состоянием 0, которые не меняют номер строки, поэтому номер строки
+     * вычисляется развернутым циклом из maxTupleSize шагов для кортежей любой длины.
+     */
+    struct Tuple{
+        uint32_t offset;                                //!Начало таблицы кортежа в массиве весов.
+        uint16_t cells[maxTupleSize];                   //!Индексы ячеек по порядку.
+    };
+    void addShape(std::vector<int> const& shape,
+                  std::vector<std::vector<int>>& added);// Добавление кортежей формы во всех положениях.
+    void cellStates(Position const& position,
+                    uint8_t* states) const;             // Состояния ячеек для игрока, который ходит.
+    static uint32_t row(Tuple const& tuple,
+                        uint8_t const* states);         // Номер строки таблицы кортежа.
+private:
+    int sideCells;                                      // Сторона поля.
+    int cells;                                          // Количество ячеек поля.
+    Bitboard blockedMask;                               // Заблокированные ячейки поля.
+    std::vector<std::vector<int>> symmetries;           // Перестановки ячеек для симметрий поля.
+    std::vector<Tuple> tuples;                          // Кортежи.
+    int tables = 0;                                     // Количество таблиц.
+    size_t weightTotal = 0;                             // Количество весов.
+    std::atomic<int32_t>* weights = nullptr;            // Веса всех таблиц подряд.
+};
+#endif // HEXNTUPLE_H
@@ -0,0 +1,139 @@
+﻿/**
+* @file hexprofile.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 22:48:52
+* @brief Файл реализации методов класса EngineProfiles.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexprofile.h"
+#include <fstream>
+#include <sstream>
+static char const* const algorithmNames[] = {"minimax", "mcts", "search"};
+static char const* const evaluatorNames[] = {"auto", "material", "weights", "nnue", "ntuple"};
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief EngineProfiles::load Метод загружает профили из файла.
+ * @param [in] fileName Имя файла профилей.
+ * @param [out] profiles Профили в порядке следования в файле.
+ * @param [out] error Описание ошибки.
+ * @return true - файл прочитан, false - файл не открыт или содержит ошибку.
+ */
+bool EngineProfiles::load(std::string const& fileName, std::vector<EngineProfile>& profiles,
+                          std::string& error){
+    std::ifstream file(fileName);
+    if (!file.is_open()){
+        error = "не удалось открыть файл профилей " + fileName;
+        return false;
+    }
+    return read(file, profiles, error);
+}
+/**
+ * @brief EngineProfiles::read Метод читает профили из потока.
+ * @param [in] stream Поток с текстом профилей.
+ * @param [out] profiles Профили в порядке следования.
+ * @param [out] error Описание ошибки с номером строки.
+ * @return true - профили прочитаны.
+ */
+bool EngineProfiles::read(std::istream& stream, std::vector<EngineProfile>& profiles, std::string& error){
+    profiles.clear();
+    std::string line;
+    for (int number = 1; std::getline(stream, line); number++){
+        std::istringstream words(line);
+        std::string key;
+        if (!(words >> key) || key[0] == '#'){
+            continue;
+        }
+        auto fail = [&](std::string const& message){
+            error = "строка " + std::to_string(number) + ": " + message;
+            return false;
+        };
+        if (key[0] == '['){                                 // Начало профиля.
+            size_t end = line.find(']');
+            size_t begin = line.find('[');
+            if (end == std::string::npos || end == begin + 1){
+                return fail("неверное название профиля");
+            }
+            profiles.push_back(EngineProfile());
+            profiles.back().name = line.substr(begin + 1, end - begin - 1);
+            continue;
+        }
+        if (profiles.empty()){
+            return fail("параметр вне профиля");
+        }
+        EngineProfile& profile = profiles.back();
+        std::string value;
+        if (!(words >> value)){
+            return fail("нет значения параметра " + key);
+        }
+        if (key == "engine" || key == "evaluator"){
+            bool engine = key == "engine";
+            int count = engine ? 3 : 5;
+            int found = 0;
+            while (found < count && value != (engine ? algorithmNames : evaluatorNames)[found]){
+                found++;
+            }
+            if (found == count){
+                return fail("неизвестное значение " + value);
+            }
+            if (engine){
+                profile.algorithm = EngineProfile::Algorithm(found);
+            } else {
+                profile.evaluator = EngineProfile::Evaluator(found);
+            }
+            continue;
+        }
+        std::istringstream digits(value);
+        long long parsed = 0;
+        if (!(digits >> parsed) || parsed < -1){
+            return fail("неверное число " + value);
+        }
+        if (key == "depth"){
+            profile.depth = int(parsed);
+        } else
+        if (key == "time"){
+            profile.time = int(parsed);
+        } else
+        if (key == "nodes"){
+            profile.nodes = parsed;
+        } else
+        if (key == "threads"){
+            profile.threads = int(parsed);
+        } else
+        if (key == "hash" && parsed > 0){
+            profile.hash = int(parsed);
+        } else
+        if (key == "reductions" && parsed >= 0){
+            profile.reductions = parsed != 0;
+        } else
+        if (key == "futility" && parsed >= 0){
+            profile.futility = parsed != 0;
+        } else
+        if (key == "nullmove" && parsed >= 0){
+            profile.nullMove = parsed != 0;
+        } else
+        if (key == "solver" && parsed >= 0){
+            profile.solverNodes = parsed;
+        } else {
+            return fail("неизвестный параметр " + key);
+        }
+    }
+    return true;
+}
+/**
+ * @brief EngineProfiles::algorithmName Метод возвращает название алгоритма в файле профилей.
+ * @param algorithm Алгоритм.
+ * @return Название.
+ */
+char const* EngineProfiles::algorithmName(EngineProfile::Algorithm algorithm){
+    return algorithmNames[int(algorithm)];
+}
+/**
+ * @brief EngineProfiles::evaluatorName Метод возвращает название оценочной функции в файле профилей.
+ * @param evaluator Оценочная функция.
+ * @return Название.
+ */
+char const* EngineProfiles::evaluatorName(EngineProfile::Evaluator evaluator){
+    return evaluatorNames[int(evaluator)];
+}
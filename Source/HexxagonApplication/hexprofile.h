@@ -0,0 +1,77 @@
+﻿/**
+* @file hexprofile.h
+* @author Oleg2008e28
+* @date 19.10.2026 22:31:18
+* @brief Заголовочный файл структуры EngineProfile - профиля компьютерного игрока: алгоритма выбора хода,
+* ограничений глубины, времени и количества позиций, количества потоков, размера таблицы транспозиций и
+* оценочной функции. Профили загружаются из текстового файла.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXPROFILE_H
+#define HEXPROFILE_H
+#include <istream>
+#include <string>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The EngineProfile struct Профиль компьютерного игрока. Ограничение, равное 0 (глубина - -1),
+ * не задано. Алгоритм использует только свои ограничения: миниМакс - глубину, поиск с итеративным
+ * углублением - глубину, время, количество позиций и размер таблицы, MCTS - время, количество итераций
+ * и потоков.
+ */
+struct EngineProfile {
+    /**
+     * @brief The Algorithm enum Алгоритмы выбора хода.
+     */
+    enum class Algorithm{
+        miniMax,                                        //!МиниМакс с альфа-бета отсечением на заданную глубину.
+        mcts,                                           //!Поиск Монте-Карло по дереву за время хода.
+        search                                          //!Итеративное углубление с таблицей транспозиций.
+    };
+    /**
+     * @brief The Evaluator enum Оценочные функции.
+     */
+    enum class Evaluator{
+        automatic,                                      //!Загруженная сеть, n-кортежи или веса.
+        material,                                       //!Разность фишек.
+        weights,                                        //!Веса Evaluation.
+        nnue,                                           //!Нейросеть, если загружена.
+        ntuple                                          //!n-кортежи, если загружены.
+    };
+    std::string name;                                   //!Название профиля.
+    Algorithm algorithm = Algorithm::miniMax;           //!Алгоритм.
+    int depth = -1;                                     //!Глубина, -1 - выбирается при запуске игры.
+    int time = 0;                                       //!Время хода, мс, 0 - время хода по умолчанию.
+    int64_t nodes = 0;                                  //!Наибольшее количество позиций или итераций.
+    int threads = 0;                                    //!Количество потоков, 0 - все ядра.
+    int hash = 16;                                      //!Размер таблицы транспозиций, МБ.
+    bool reductions = true;                             //!Сокращение глубины поздних ходов в search.
+    bool futility = true;                               //!Отсечение у листьев в search.
+    bool nullMove = true;                               //!Пропуск хода в search.
+    int64_t solverNodes = 0;                            //!Бюджет решателя перед search, 0 - без решателя.
+    Evaluator evaluator = Evaluator::automatic;         //!Оценочная функция.
+};
+//............................................................................................................
+/**
+ * @brief The EngineProfiles class Чтение профилей из текстового файла.
+ *
+ * Профиль начинается строкой "[название]", за ней следуют строки "<параметр> <значение>": engine
+ * (minimax, search, mcts), depth, time, nodes, threads, hash, evaluator (auto, material, weights, nnue,
+ * ntuple), reductions, futility, nullmove (0 - прием выборочного поиска выключен), solver (бюджет решателя
+ * ProofSolver). Пустые строки и строки, начинающиеся с '#', пропускаются.
+ */
+class EngineProfiles{
+public:
+    static bool load(std::string const& fileName,
+                     std::vector<EngineProfile>& profiles,
+                     std::string& error);               // Загрузка профилей из файла.
+    static bool read(std::istream& stream,
+                     std::vector<EngineProfile>& profiles,
+                     std::string& error);               // Чтение профилей из потока.
+    static char const* algorithmName(
+            EngineProfile::Algorithm algorithm);        // Название алгоритма.
+    static char const* evaluatorName(
+            EngineProfile::Evaluator evaluator);        // Название оценочной функции.
+};
+#endif // HEXPROFILE_H
@@ -0,0 +1,503 @@
+﻿/**
+* @file hexsearch.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 21:40:02
+* @brief Файл реализации методов классов ZobristKeys, TranspositionTable и SearchEngine.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexsearch.h"
+#include "hexevaluation.h"
+#include "hexsolver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+const int SearchEngine::defaultTableSizeMb;
+const int SearchEngine::maxDepth;
+const int SearchEngine::winScore;
+const int SearchEngine::infinity;
+const int SearchEngine::reductionMinDepth;
+const int SearchEngine::reductionFirstMove;
+const int SearchEngine::futilityMaxDepth;
+const int SearchEngine::futilityMargin;
+const int SearchEngine::nullMoveMinDepth;
+const int SearchEngine::nullMoveMinEmpty;
+//............................................................................................................
+//.......................................... ZobristKeys .....................................................
+//............................................................................................................
+/**
+ * @brief ZobristKeys::ZobristKeys Конструктор класса, заполняет ключи генератором splitmix64.
+ */
+ZobristKeys::ZobristKeys(){
+    uint64_t state = 0x48455858414752ULL;                   // Фиксированное начальное значение.
+    auto next = [&state](){
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for (int p = 0; p < 2; p++){
+        for (int i = 0; i < HexBoard::maxCells; i++){
+            chips[p][i] = next();
+        }
+    }
+    second = next();
+}
+/**
+ * @brief ZobristKeys::key Метод вычисляет ключ позиции.
+ * @param position Позиция.
+ * @return Ключ.
+ */
+uint64_t ZobristKeys::key(Position const& position) const{
+    uint64_t result = position.player == 2 ? second : 0;
+    for (int p = 0; p < 2; p++){
+        position.chips[p].forEach([&](int i){ result ^= chips[p][i]; });
+    }
+    return result;
+}
+/**
+ * @brief ZobristKeys::update Метод вычисляет ключ позиции после хода по ключу позиции до хода.
+ * @param key Ключ позиции до хода.
+ * @param move Ход.
+ * @param player Игрок, сделавший ход.
+ * @param flips Перевернутые фишки противника (результат HexBoard::doMove).
+ * @return Ключ позиции после хода.
+ */
+uint64_t ZobristKeys::update(uint64_t key, Move const& move, int player, Bitboard const& flips) const{
+    int own = player - 1;
+    key ^= second ^ chips[own][move.newPostion];
+    if (move.clearBeginPostion){
+        key ^= chips[own][move.beginPostion];
+    }
+    flips.forEach([&](int i){ key ^= chips[0][i] ^ chips[1][i]; });
+    return key;
+}
+/**
+ * @brief ZobristKeys::pass Метод вычисляет ключ позиции после пропуска хода: меняется только очередь.
+ * @param key Ключ позиции.
+ * @return Ключ позиции с очередью противника.
+ */
+uint64_t ZobristKeys::pass(uint64_t key) const{
+    return key ^ second;
+}
+//............................................................................................................
+//.......................................... TranspositionTable ..............................................
+//............................................................................................................
+/**
+ * @brief TranspositionTable::TranspositionTable Конструктор класса, выделяет таблицу.
+ * @param sizeMb Размер таблицы в мегабайтах, количество записей округляется вниз до степени двойки.
+ */
+TranspositionTable::TranspositionTable(int sizeMb){
+    resize(sizeMb);
+}
+/**
+ * @brief TranspositionTable::clear Метод очищает таблицу.
+ */
+void TranspositionTable::clear(){
+    std::fill(entries.begin(), entries.end(), TranspositionEntry{0, 0, Move{0, 0, false}, -1, exact, 0});
+    generation = 0;
+}
+/**
+ * @brief TranspositionTable::resize Метод выделяет таблицу заданного размера и очищает ее.
+ * @param sizeMb Размер таблицы в мегабайтах, количество записей округляется вниз до степени двойки.
+ */
+void TranspositionTable::resize(int sizeMb){
+    size_t count = 1;
+    while (count * 2 * sizeof(TranspositionEntry) <= size_t(std::max(1, sizeMb)) << 20){
+        count *= 2;
+    }
+    std::vector<TranspositionEntry>(count).swap(entries);   // Освобождение памяти прежней таблицы.
+    mask = count - 1;
+    requestedMb = std::max(1, sizeMb);
+    clear();
+}
+/**
+ * @brief TranspositionTable::sizeMb Метод возвращает заданный размер таблицы.
+ * @return Размер в мегабайтах, не меньше 1.
+ */
+int TranspositionTable::sizeMb() const{
+    return requestedMb;
+}
+/**
+ * @brief TranspositionTable::newSearch Метод начинает новый поиск: записи прошлых поисков остаются,
+ * но уступают место новым.
+ */
+void TranspositionTable::newSearch(){
+    generation++;
+}
+/**
+ * @brief TranspositionTable::probe Метод ищет запись позиции.
+ * @param key Ключ позиции.
+ * @return Запись или nullptr, если позиции нет в таблице.
+ */
+TranspositionEntry const* TranspositionTable::probe(uint64_t key) const{
+    TranspositionEntry const& entry = entries[key & mask];
+    return entry.key == key && entry.depth >= 0 ? &entry : nullptr;
+}
+/**
+ * @brief TranspositionTable::store Метод записывает результат поиска позиции.
+ * @param key Ключ позиции.
+ * @param score Оценка.
+ * @param move Лучший ход.
+ * @param depth Глубина поиска.
+ * @param bound Вид оценки.
+ */
+void TranspositionTable::store(uint64_t key, int score, Move const& move, int depth, Bound bound){
+    TranspositionEntry& entry = entries[key & mask];
+    if (entry.key == key || entry.generation != generation || depth >= entry.depth){
+        entry = TranspositionEntry{key, score, move, int8_t(depth), bound, generation};
+    }
+}
+//............................................................................................................
+//.......................................... SearchEngine ....................................................
+//............................................................................................................
+/**
+ * @brief SearchEngine::SearchEngine Конструктор класса. Оценочная функция по умолчанию - разность фишек.
+ * @param tableSizeMb Размер таблицы транспозиций в мегабайтах.
+ */
+SearchEngine::SearchEngine(int tableSizeMb) : table(tableSizeMb){
+    evaluator = [](Position const& position){
+        int own = position.player - 1;
+        return (position.chips[own].count() - position.chips[1 - own].count()) * Evaluation::scale;
+    };
+}
+/**
+ * @brief SearchEngine::~SearchEngine Деструктор класса.
+ */
+SearchEngine::~SearchEngine(){
+}
+/**
+ * @brief SearchEngine::setEvaluator Метод устанавливает оценочную функцию. Функция вызывается из потока
+ * поиска и возвращает оценку для игрока, который ходит, в единицах Evaluation::scale.
+ * @param function Оценочная функция.
+ */
+void SearchEngine::setEvaluator(Evaluator const& function){
+    evaluator = function;
+}
+/**
+ * @brief SearchEngine::setOptions Метод выбирает приемы выборочного поиска. Вызывается, когда поиск не
+ * идет.
+ * @param options Приемы выборочного поиска.
+ */
+void SearchEngine::setOptions(SearchOptions const& options){
+    this->options = options;
+}
+/**
+ * @brief SearchEngine::analyze Метод ищет позицию с итеративным углублением до остановки или до
+ * ограничения. Если поле отличается от поля прошлого поиска, таблица очищается.
+ * @param board Геометрия игрового поля.
+ * @param position Позиция.
+ * @param limits Ограничения глубины, времени и количества позиций, бюджет решателя.
+ * @param report Функция, получающая результат каждой законченной итерации или доказанный выигрыш.
+ * @param stop Признак остановки, устанавливается другим потоком. Поиск проверяет его каждые 1024
+ * позиции, поэтому заканчивается в течение нескольких микросекунд.
+ * @return Результат последней законченной итерации.
+ */
+SearchInfo SearchEngine::analyze(HexBoard const& board, Position const& position, SearchLimits const& limits,
+                                 Reporter const& report, std::atomic<bool> const& stop){
+    if (board.side() != boardSide || board.blocked() != boardBlocked){
+        table.clear();
+        boardSide = board.side();
+        boardBlocked = board.blocked();
+    }
+    this->board = &board;
+    stopped = &stop;
+    table.newSearch();
+    nodes = 0;
+    nodeLimit = limits.nodes;
+    auto begin = std::chrono::steady_clock::now();
+    timeLimited = limits.time > 0;
+    deadline = begin + std::chrono::milliseconds(limits.time);
+    int depthLimit = limits.depth > 0 ? std::min(limits.depth, int(maxDepth)) : maxDepth;
+    SearchInfo result;
+    if (limits.solverNodes > 0){                            // Доказанный выигрыш заменяет поиск.
+        if (!solver){
+            solver.reset(new ProofSolver());
+        }
+        ProofInfo proof = solver->solve(board, position, limits.solverNodes, stop,
+                                        limits.time > 0 ? std::max(1, limits.time / 2) : 0);
+        if (proof.result == ProofResult::win){
+            result.depth = 1;
+            result.score = winScore - maxDepth;             // Длина выигрыша не известна.
+            result.nodes = proof.nodes;
+            result.time = int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::steady_clock::now() - begin).count());
+            result.line.push_back(proof.move);
+            if (report){
+                report(result);
+            }
+            return result;
+        }
+    }
+    uint64_t key = zobrist.key(position);
+    for (int depth = 1; depth <= depthLimit && !stop; depth++){
+        aborted = false;
+        firstIteration = depth == 1;
+        int score = negamax(position, key, depth, 0, -infinity, infinity, false);
+        if (aborted){                                       // Итерация прервана, ее оценка неверна.
+            break;
+        }
+        result.depth = depth;
+        result.score = score;
+        result.nodes = nodes;
+        result.time = int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now() - begin).count());
+        result.line = principalLine(position, depth);
+        if (report){
+            report(result);
+        }
+        if (result.line.empty() || (nodeLimit && nodes >= nodeLimit)
+                || (timeLimited && std::chrono::steady_clock::now() >= deadline)){
+            break;                                          // Ходов нет или ограничение исчерпано.
+        }
+    }
+    return result;
+}
+/**
+ * @brief SearchEngine::clear Метод очищает таблицу транспозиций. Вызывается, когда поиск не идет.
+ */
+void SearchEngine::clear(){
+    table.clear();
+}
+/**
+ * @brief SearchEngine::setTableSize Метод изменяет размер таблицы транспозиций, если он отличается от
+ * текущего. Вызывается, когда поиск не идет.
+ * @param sizeMb Размер таблицы в мегабайтах.
+ */
+void SearchEngine::setTableSize(int sizeMb){
+    if (std::max(1, sizeMb) != table.sizeMb()){
+        table.resize(sizeMb);
+    }
+}
+/**
+ * @brief SearchEngine::isWin Метод проверяет, означает ли оценка выигрыш или проигрыш.
+ * @param score Оценка.
+ * @return true - оценка получена по конечной позиции.
+ */
+bool SearchEngine::isWin(int score){
+    return std::abs(score) > winScore - 1000;
+}
+//............................................................................................................
+//.......................................... private methods .................................................
+//............................................................................................................
+/**
+ * @brief SearchEngine::negamax Метод поиска негамакс с альфа-бета отсечением и таблицей транспозиций.
+ * Узлы с нулевым окном (вне главного варианта) ищутся выборочно, см. SearchOptions.
+ * @param position Позиция.
+ * @param key Ключ позиции.
+ * @param depth Оставшаяся глубина.
+ * @param ply Количество полуходов от корня.
+ * @param alpha Нижняя граница окна.
+ * @param beta Верхняя граница окна.
+ * @param nullAllowed Разрешение пропуска хода: запрещен два раза подряд и при проверочном поиске.
+ * @return Оценка для игрока, который ходит.
+ */
+int SearchEngine::negamax(Position const& position, uint64_t key, int depth, int ply, int alpha, int beta,
+                          bool nullAllowed){
+    if ((++nodes & 1023) == 0 && (stopped->load(std::memory_order_relaxed)
+            || (!firstIteration && ((nodeLimit && nodes >= nodeLimit)
+                                    || (timeLimited && std::chrono::steady_clock::now() >= deadline))))){
+        aborted = true;
+    }
+    if (aborted){
+        return 0;
+    }
+    MoveList moves;
+    if (board->generateMoves(position, moves) == 0){        // Конец партии.
+        return finalScore(position, ply);
+    }
+    if (depth <= 0){
+        return evaluator(position);
+    }
+    TranspositionEntry const* entry = table.probe(key);
+    Move hashMove = moves[0];
+    if (entry){
+        hashMove = entry->move;
+        if (ply > 0 && entry->depth >= depth){              // В корне нужен ход, а не только оценка.
+            int score = scoreFromTable(entry->score, ply);
+            if (entry->bound == TranspositionTable::exact
+                    || (entry->bound == TranspositionTable::lower && score >= beta)
+                    || (entry->bound == TranspositionTable::upper && score <= alpha)){
+                return score;
+            }
+        }
+    }
+    bool selective = ply > 0 && beta - alpha == 1 && !isWin(alpha) && !isWin(beta);
+    int staticScore = 0;                                    // Статическая оценка узла.
+    if (selective && ((options.nullMove && nullAllowed && depth >= nullMoveMinDepth)
+                      || (options.futility && depth <= futilityMaxDepth))){
+        staticScore = evaluator(position);
+    }
+    if (selective && options.nullMove && nullAllowed && depth >= nullMoveMinDepth && staticScore >= beta
+            && board->emptyCells(position).count() >= nullMoveMinEmpty){
+        Position passed = position;                         // Пропуск хода возможен, только если
+        passed.player = int8_t(3 - position.player);        // у противника есть ходы.
+        if (board->hasMoves(passed, passed.player)){
+            int reduction = depth >= 6 ? 3 : 2;
+            int score = -negamax(passed, zobrist.pass(key), depth - 1 - reduction, ply + 1,
+                                 -beta, -beta + 1, false);
+            if (aborted){
+                return 0;
+            }
+            if (score >= beta){                             // Проверка без пропусков.
+                score = negamax(position, key, depth - reduction, ply, beta - 1, beta, false);
+                if (aborted){
+                    return 0;
+                }
+                if (score >= beta){
+                    return score;
+                }
+            }
+        }
+    }
+    bool pruneFutile = selective && options.futility && depth <= futilityMaxDepth;
+    int futilityBase = staticScore + futilityMargin * depth;
+    orderMoves(position, moves, entry ? &hashMove : nullptr);
+    int alphaBegin = alpha;
+    int best = -infinity;
+    Move bestMove = moves[0];
+    for (int i = 0; i < moves.size; i++){
+        Move const& move = moves[i];
+        Position child = position;
+        Bitboard flips = board->doMove(child, move);
+        if (pruneFutile && i > 0){                          // Ход не изменит разность фишек достаточно.
+            int gain = ((move.clearBeginPostion ? 0 : 1) + 2 * flips.count()) * Evaluation::scale;
+            if (futilityBase + gain <= alpha && board->hasMoves(child, child.player)){
+                best = std::max(best, futilityBase + gain);
+                continue;
+            }
+        }
+        uint64_t childKey = zobrist.update(key, move, position.player, flips);
+        int score;
+        if (i == 0){                                        // Первый ход ищется с полным окном,
+            score = -negamax(child, childKey, depth - 1, ply + 1, -beta, -alpha, true);
+        } else {                                            // остальные - с нулевым.
+            int reduction = 0;
+            if (options.reductions && depth >= reductionMinDepth && i >= reductionFirstMove && !flips.any()){
+                reduction = depth >= 5 && i >= 2 * reductionFirstMove ? 2 : 1;
+            }
+            score = -negamax(child, childKey, depth - 1 - reduction, ply + 1, -alpha - 1, -alpha, true);
+            if (!aborted && score > alpha && (reduction > 0 || score < beta)){
+                score = -negamax(child, childKey, depth - 1, ply + 1, -beta, -alpha, true);
+            }
+        }
+        if (aborted){
+            return 0;
+        }
+        if (score > best){
+            best = score;
+            bestMove = move;
+            if (score > alpha){
+                alpha = score;
+                if (alpha >= beta){                         // Отсечение.
+                    break;
+                }
+            }
+        }
+    }
+    table.store(key, scoreToTable(best, ply), bestMove, depth,
+                best >= beta ? TranspositionTable::lower
+                             : best > alphaBegin ? TranspositionTable::exact : TranspositionTable::upper);
+    return best;
+}
+/**
+ * @brief SearchEngine::finalScore Метод оценивает конечную позицию: выигрыш тем дороже, чем он ближе.
+ * @param position Позиция без ходов.
+ * @param ply Количество полуходов от корня.
+ * @return Оценка для игрока, который ходит.
+ */
+int SearchEngine::finalScore(Position const& position, int ply) const{
+    int own = position.player - 1;
+    int difference = position.chips[own].count() - position.chips[1 - own].count();
+    if (difference > 0){
+        return winScore - ply;
+    }
+    if (difference < 0){
+        return -winScore + ply;
+    }
+    return 0;
+}
+/**
+ * @brief SearchEngine::scoreToTable Метод переводит оценку выигрыша из расстояния от корня в расстояние
+ * от узла: в таблице запись позиции используется на любом полуходе. Остальные оценки не меняются.
+ * @param score Оценка узла.
+ * @param ply Количество полуходов от корня до узла.
+ * @return Оценка для записи в таблицу.
+ */
+int SearchEngine::scoreToTable(int score, int ply){
+    if (!isWin(score)){
+        return score;
+    }
+    return score > 0 ? score + ply : score - ply;
+}
+/**
+ * @brief SearchEngine::scoreFromTable Метод переводит оценку выигрыша из таблицы обратно в расстояние от
+ * корня текущего поиска.
+ * @param score Оценка из таблицы.
+ * @param ply Количество полуходов от корня до узла.
+ * @return Оценка узла.
+ */
+int SearchEngine::scoreFromTable(int score, int ply){
+    if (!isWin(score)){
+        return score;
+    }
+    return score > 0 ? score - ply : score + ply;
+}
+/**
+ * @brief SearchEngine::orderMoves Метод упорядочивает ходы: первым ход из таблицы транспозиций, затем по
+ * убыванию количества фишек противника рядом с конечной ячейкой, ближний ход раньше дальнего.
+ * @param position Позиция.
+ * @param moves Ходы позиции.
+ * @param first Ход из таблицы транспозиций или nullptr.
+ */
+void SearchEngine::orderMoves(Position const& position, MoveList& moves, Move const* first) const{
+    int keys[MoveList::capacity];
+    Bitboard const& opponent = position.chips[2 - position.player];
+    for (int i = 0; i < moves.size; i++){
+        Move const& move = moves[i];
+        keys[i] = (board->nearMask(move.newPostion) & opponent).count() * 2 + (move.clearBeginPostion ? 0 : 1);
+        if (first && move.newPostion == first->newPostion && move.beginPostion == first->beginPostion
+                && move.clearBeginPostion == first->clearBeginPostion){
+            keys[i] = 1000;
+        }
+    }
+    for (int i = 1; i < moves.size; i++){                   // Вставками: ходов немного.
+        Move move = moves[i];
+        int value = keys[i];
+        int j = i;
+        for (; j > 0 && keys[j - 1] < value; j--){
+            moves[j] = moves[j - 1];
+            keys[j] = keys[j - 1];
+        }
+        moves[j] = move;
+        keys[j] = value;
+    }
+}
+/**
+ * @brief SearchEngine::principalLine Метод восстанавливает главный вариант по лучшим ходам таблицы
+ * транспозиций. Ход таблицы проверяется по списку ходов позиции.
+ * @param position Позиция корня.
+ * @param depth Наибольшая длина варианта.
+ * @return Главный вариант.
+ */
+std::vector<Move> SearchEngine::principalLine(Position position, int depth) const{
+    std::vector<Move> line;
+    uint64_t key = zobrist.key(position);
+    while (int(line.size()) < depth){
+        TranspositionEntry const* entry = table.probe(key);
+        MoveList moves;
+        if (!entry || board->generateMoves(position, moves) == 0){
+            break;
+        }
+        auto found = std::find_if(moves.begin(), moves.end(), [&](Move const& move){
+            return move.newPostion == entry->move.newPostion && move.beginPostion == entry->move.beginPostion
+                    && move.clearBeginPostion == entry->move.clearBeginPostion;
+        });
+        if (found == moves.end()){
+            break;
+        }
+        line.push_back(*found);
+        Bitboard flips = board->doMove(position, *found);
+        key = zobrist.update(key, *found, 3 - position.player, flips);
+    }
+    return line;
+}
@@ -0,0 +1,197 @@
+﻿/**
+* @file hexsearch.h
+* @author Oleg2008e28
+* @date 19.10.2026 21:12:37
+* @brief Заголовочный файл класса SearchEngine - поиска с итеративным углублением, альфа-бета отсечением
+* и таблицей транспозиций с ключами Зобриста. Поиск используется режимом анализа: он идет без ограничения
+* глубины до остановки и сообщает глубину, оценку и главный вариант после каждой итерации.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXSEARCH_H
+#define HEXSEARCH_H
+#include "hexboard.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The ZobristKeys class Ключи Зобриста: случайные 64-битные числа для каждой фишки каждого игрока
+ * в каждой ячейке и для очереди хода. Ключ позиции - исключающее ИЛИ ключей ее фишек и очереди хода,
+ * после хода ключ меняется только на ключи поставленной, снятой и перевернутых фишек. Ключи одинаковы
+ * для всех полей, они получаются из фиксированного начального значения.
+ */
+class ZobristKeys{
+public:
+    ZobristKeys();                                      // Конструктор, заполнение ключей.
+    uint64_t key(Position const& position) const;       // Ключ позиции.
+    uint64_t update(uint64_t key, Move const& move,
+                    int player,
+                    Bitboard const& flips) const;       // Ключ позиции после хода.
+    uint64_t pass(uint64_t key) const;                  // Ключ позиции после пропуска хода.
+private:
+    uint64_t chips[2][HexBoard::maxCells];              // Ключи фишек игроков.
+    uint64_t second;                                    // Ключ очереди хода игрока 2.
+};
+//............................................................................................................
+/**
+ * @brief The TranspositionEntry struct Запись таблицы транспозиций.
+ */
+struct TranspositionEntry {
+    uint64_t key;                                       //!Ключ позиции.
+    int32_t score;                                      //!Оценка для игрока, который ходит.
+    Move move;                                          //!Лучший ход.
+    int8_t depth;                                       //!Глубина поиска оценки.
+    uint8_t bound;                                      //!Вид оценки: точная, нижняя или верхняя граница.
+    uint8_t generation;                                 //!Номер поиска, записавшего оценку.
+};
+/**
+ * @brief The TranspositionTable class Таблица транспозиций: результаты поиска позиций по ключу Зобриста.
+ * Запись заменяется, если она записана прошлыми поисками или на меньшую глубину. Таблица не очищается
+ * между поисками, поэтому поиск соседней позиции (после хода или отмены хода) начинается с оценками и
+ * лучшими ходами, найденными раньше.
+ */
+class TranspositionTable{
+public:
+    /**
+     * @brief The Bound enum Вид оценки записи.
+     */
+    enum Bound : uint8_t{
+        exact,                                          //!Точная оценка.
+        lower,                                          //!Нижняя граница (было отсечение).
+        upper                                           //!Верхняя граница (ни один ход не улучшил alpha).
+    };
+    explicit TranspositionTable(int sizeMb);            // Конструктор, размер таблицы в мегабайтах.
+    void clear();                                       // Очистка таблицы.
+    void resize(int sizeMb);                            // Изменение размера таблицы с очисткой.
+    int sizeMb() const;                                 // Размер таблицы в мегабайтах.
+    void newSearch();                                   // Начало нового поиска.
+    TranspositionEntry const* probe(uint64_t key) const;// Поиск записи позиции.
+    void store(uint64_t key, int score, Move const& move,
+               int depth, Bound bound);                 // Запись результата поиска позиции.
+private:
+    std::vector<TranspositionEntry> entries;            // Записи, количество - степень двойки.
+    uint64_t mask;                                      // Маска индекса записи.
+    int requestedMb = 0;                                // Заданный размер таблицы в мегабайтах.
+    uint8_t generation = 0;                             // Номер текущего поиска.
+};
+//............................................................................................................
+/**
+ * @brief The SearchInfo struct Результат итерации поиска.
+ */
+struct SearchInfo {
+    int depth = 0;                                      //!Глубина итерации.
+    int score = 0;                                      //!Оценка для игрока, который ходит.
+    uint64_t nodes = 0;                                 //!Количество позиций с начала поиска.
+    int time = 0;                                       //!Время с начала поиска, мс.
+    std::vector<Move> line;                             //!Главный вариант.
+};
+/**
+ * @brief The SearchLimits struct Ограничения поиска, значение 0 - ограничения нет. Ограничения времени и
+ * количества позиций не прерывают первую итерацию, чтобы у поиска всегда был ход.
+ */
+struct SearchLimits {
+    int depth = 0;                                      //!Наибольшая глубина итерации (не больше maxDepth).
+    int time = 0;                                       //!Время поиска, мс.
+    uint64_t nodes = 0;                                 //!Количество позиций.
+    uint64_t solverNodes = 0;                           //!Бюджет решателя перед поиском, 0 - без решателя.
+};
+/**
+ * @brief The SearchOptions struct Приемы выборочного поиска, каждый включается отдельно.
+ */
+struct SearchOptions {
+    bool reductions = true;                             //!Сокращение глубины поздних ходов без захвата.
+    bool futility = true;                               //!Отсечение у листьев ходов, не достающих до alpha.
+    bool nullMove = true;                               //!Пропуск хода с проверочным поиском.
+};
+class ProofSolver;
+/**
+ * @brief The SearchEngine class Поиск с итеративным углублением.
+ *
+ * Итерация глубины d - поиск негамакс с альфа-бета отсечением на d полуходов. Первым проверяется ход из
+ * таблицы транспозиций, остальные ходы упорядочены по количеству фишек противника рядом с конечной
+ * ячейкой, ближние ходы раньше дальних. Позиция без ходов - конец партии: выигрыш оценивается как
+ * winScore минус количество полуходов до него. В таблице транспозиций оценки выигрыша хранятся от
+ * записанного узла, а не от корня, поэтому верны на любом полуходе. Главный вариант восстанавливается по
+ * лучшим ходам таблицы. Поиск останавливается признаком, который устанавливает другой поток, или ограничениями
+ * SearchLimits; прерванная итерация не сообщается.
+ *
+ * Первый ход узла ищется с полным окном, остальные - с нулевым окном и повторно с полным, если ход
+ * поднял alpha. Узлы с нулевым окном (вне главного варианта) ищутся выборочно (SearchOptions):
+ *   - поздние ходы без захвата ищутся на меньшую глубину, ход, поднявший alpha, ищется заново на полную
+ *     глубину;
+ *   - за один-два полухода до листьев ход пропускается, если статическая оценка, увеличенная на
+ *     изменение разности фишек от хода и запас, не достает до alpha. Ответ противника разность фишек
+ *     только уменьшает, поэтому за полуход до листьев для оценки по фишкам отсечение точное; ход, после
+ *     которого у противника нет ходов, не пропускается - это конец партии;
+ *   - если оценка не ниже beta, игрок пропускает ход и поиск противника на сокращенную глубину должен
+ *     опровергнуть пропуск. Отсечение подтверждается поиском самой позиции на сокращенную глубину без
+ *     пропусков, поэтому позиции, где любой ход хуже пропуска, не теряются. В конце партии, когда пустых
+ *     ячеек мало, пропуск не используется.
+ *
+ * С бюджетом SearchLimits::solverNodes позиция сначала решается ProofSolver: доказанный выигрыш
+ * сообщается сразу с ходом решателя, иначе идет обычный поиск. Решателю отводится не больше половины
+ * времени поиска.
+ */
+class SearchEngine{
+public:
+    typedef std::function<int(Position const&)> Evaluator;       // Оценка для игрока, который ходит.
+    typedef std::function<void(SearchInfo const&)> Reporter;     // Получатель результатов итераций.
+    explicit SearchEngine(int tableSizeMb = defaultTableSizeMb);// Конструктор, размер таблицы.
+    ~SearchEngine();                                    // Деструктор.
+    void setEvaluator(Evaluator const& function);       // Установка оценочной функции.
+    void setOptions(SearchOptions const& options);      // Выбор приемов выборочного поиска.
+    SearchInfo analyze(HexBoard const& board,
+                       Position const& position,
+                       SearchLimits const& limits,
+                       Reporter const& report,
+                       std::atomic<bool> const& stop);  // Поиск до остановки или ограничения.
+    void clear();                                       // Очистка таблицы транспозиций.
+    void setTableSize(int sizeMb);                      // Изменение размера таблицы транспозиций.
+    static bool isWin(int score);                       // Признак оценки выигрыша или проигрыша.
+//............................................................................................................
+public:
+    static const int defaultTableSizeMb = 32;           //!Размер таблицы транспозиций по умолчанию.
+    static const int maxDepth = 64;                     //!Наибольшая глубина итерации.
+    static const int winScore = 1000000;                //!Оценка выигрыша в конечной позиции.
+    static const int infinity = 2000000;                //!Граница окна поиска.
+    static const int reductionMinDepth = 3;             //!Наименьшая глубина сокращения поздних ходов.
+    static const int reductionFirstMove = 3;            //!Номер первого сокращаемого хода.
+    static const int futilityMaxDepth = 2;              //!Наибольшая глубина отсечения у листьев.
+    static const int futilityMargin = 100;              //!Запас отсечения на полуход (фишка).
+    static const int nullMoveMinDepth = 3;              //!Наименьшая глубина пропуска хода.
+    static const int nullMoveMinEmpty = 8;              //!Наименьшее число пустых ячеек для пропуска хода.
+//............................................................................................................
+private:
+    int negamax(Position const& position, uint64_t key,
+                int depth, int ply, int alpha, int beta,
+                bool nullAllowed);                      // Поиск негамакс с альфа-бета отсечением.
+    int finalScore(Position const& position,
+                   int ply) const;                      // Оценка конечной позиции.
+    static int scoreToTable(int score, int ply);        // Оценка выигрыша от узла для таблицы.
+    static int scoreFromTable(int score, int ply);      // Оценка выигрыша из таблицы от корня.
+    void orderMoves(Position const& position,
+                    MoveList& moves,
+                    Move const* first) const;           // Упорядочивание ходов.
+    std::vector<Move> principalLine(Position position,
+                                    int depth) const;   // Главный вариант по таблице транспозиций.
+private:
+    ZobristKeys zobrist;                                // Ключи Зобриста.
+    TranspositionTable table;                           // Таблица транспозиций.
+    std::unique_ptr<ProofSolver> solver;                // Решатель, создается при первом использовании.
+    Evaluator evaluator;                                // Оценочная функция.
+    SearchOptions options;                              // Приемы выборочного поиска.
+    HexBoard const* board = nullptr;                    // Геометрия поля текущего поиска.
+    int boardSide = 0;                                  // Поле, для которого заполнена таблица.
+    Bitboard boardBlocked = Bitboard::empty();
+    std::atomic<bool> const* stopped = nullptr;         // Признак остановки текущего поиска.
+    bool aborted = false;                               // Текущая итерация прервана.
+    uint64_t nodes = 0;                                 // Количество позиций текущего поиска.
+    uint64_t nodeLimit = 0;                             // Ограничение количества позиций, 0 - нет.
+    std::chrono::steady_clock::time_point deadline;     // Время окончания поиска.
+    bool timeLimited = false;                           // Поиск ограничен по времени.
+    bool firstIteration = false;                        // Идет первая итерация, ограничения не действуют.
+};
+#endif // HEXSEARCH_H
@@ -0,0 +1,323 @@
+﻿/**
+* @file hexsolver.cpp
+* @author Oleg2008e28
+* @date 20.10.2026 09:47:03
+* @brief Файл реализации методов классов ProofTable и ProofSolver.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexsolver.h"
+#include <algorithm>
+const int ProofTable::bucketSize;
+const int ProofSolver::defaultTableSizeMb;
+const uint32_t ProofSolver::infinity;
+const int ProofSolver::maxPly;
+//............................................................................................................
+//.......................................... ProofTable ......................................................
+//............................................................................................................
+/**
+ * @brief ProofTable::ProofTable Конструктор класса, выделяет таблицу.
+ * @param sizeMb Размер таблицы в мегабайтах, количество корзин округляется вниз до степени двойки.
+ */
+ProofTable::ProofTable(int sizeMb){
+    resize(sizeMb);
+}
+/**
+ * @brief ProofTable::clear Метод очищает таблицу.
+ */
+void ProofTable::clear(){
+    std::fill(entries.begin(), entries.end(), ProofEntry{0, 0, 0, 0, 0});
+}
+/**
+ * @brief ProofTable::resize Метод выделяет таблицу заданного размера и очищает ее.
+ * @param sizeMb Размер таблицы в мегабайтах.
+ */
+void ProofTable::resize(int sizeMb){
+    size_t buckets = 1;
+    while (buckets * 2 * bucketSize * sizeof(ProofEntry) <= size_t(std::max(1, sizeMb)) << 20){
+        buckets *= 2;
+    }
+    std::vector<ProofEntry>(buckets * bucketSize).swap(entries);
+    mask = buckets - 1;
+    requestedMb = std::max(1, sizeMb);
+    clear();
+}
+/**
+ * @brief ProofTable::sizeMb Метод возвращает заданный размер таблицы.
+ * @return Размер в мегабайтах.
+ */
+int ProofTable::sizeMb() const{
+    return requestedMb;
+}
+/**
+ * @brief ProofTable::probe Метод ищет числа позиции.
+ * @param key Ключ позиции.
+ * @param [out] proof Число доказательства.
+ * @param [out] disproof Число опровержения.
+ * @return true - запись найдена.
+ */
+bool ProofTable::probe(uint64_t key, uint32_t& proof, uint32_t& disproof) const{
+    ProofEntry const* bucket = &entries[(key & mask) * bucketSize];
+    for (int i = 0; i < bucketSize; i++){
+        if (bucket[i].key == key && bucket[i].work != 0){
+            proof = bucket[i].proof;
+            disproof = bucket[i].disproof;
+            return true;
+        }
+    }
+    return false;
+}
+/**
+ * @brief ProofTable::store Метод записывает числа позиции: на место записи той же позиции или записи
+ * корзины с наименьшей работой.
+ * @param key Ключ позиции.
+ * @param proof Число доказательства.
+ * @param disproof Число опровержения.
+ * @param work Работа, затраченная на позицию.
+ */
+void ProofTable::store(uint64_t key, uint32_t proof, uint32_t disproof, uint64_t work){
+    ProofEntry* bucket = &entries[(key & mask) * bucketSize];
+    ProofEntry* target = bucket;
+    for (int i = 0; i < bucketSize; i++){
+        if (bucket[i].key == key){
+            target = &bucket[i];
+            break;
+        }
+        if (bucket[i].work < target->work){
+            target = &bucket[i];
+        }
+    }
+    uint32_t total = uint32_t(std::min<uint64_t>(work, UINT32_MAX - 1)) + 1; // Работа записи не меньше 1.
+    if (target->key == key){
+        total = std::max(total, target->work);
+    }
+    *target = ProofEntry{key, proof, disproof, total, 0};
+}
+//............................................................................................................
+//.......................................... ProofSolver .....................................................
+//............................................................................................................
+/**
+ * @brief ProofSolver::ProofSolver Конструктор класса.
+ * @param tableSizeMb Размер таблицы доказательств в мегабайтах.
+ */
+ProofSolver::ProofSolver(int tableSizeMb) : table(tableSizeMb){
+    uint64_t seed = 0x6A09E667F3BCC908ULL;                  // Ключи сторон не совпадают с ключами фишек.
+    for (uint64_t& key : attackerKeys){
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        key = seed;
+    }
+    frames.resize(maxPly + 1);                              // Ссылки на детей не меняются при углублении.
+}
+/**
+ * @brief ProofSolver::solve Метод решает позицию: доказывает выигрыш игрока, который ходит, затем его
+ * проигрыш. Если поле отличается от поля прошлого решения, таблица очищается.
+ * @param board Геометрия игрового поля.
+ * @param position Позиция.
+ * @param nodeLimit Бюджет раскрытых позиций на оба доказательства, 0 - без ограничения.
+ * @param stop Признак остановки, устанавливается другим потоком.
+ * @param timeLimit Время решения, мс, 0 - без ограничения. Признак и время проверяются каждые 1024
+ * позиции, прерванное решение возвращает "не известно".
+ * @return Результат, выигрывающий ход и количество раскрытых позиций.
+ */
+ProofInfo ProofSolver::solve(HexBoard const& board, Position const& position, uint64_t nodeLimit,
+                             std::atomic<bool> const& stop, int timeLimit){
+    if (board.side() != boardSide || board.blocked() != boardBlocked){
+        table.clear();
+        boardSide = board.side();
+        boardBlocked = board.blocked();
+    }
+    this->board = &board;
+    stopped = &stop;
+    timeLimited = timeLimit > 0;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimit);
+    interrupted = false;
+    nodes = 0;
+    ProofInfo info;
+    int player = position.player;
+    if (!board.hasMoves(position, player)){                 // Конец партии: результат по фишкам.
+        int difference = position.chips[player - 1].count() - position.chips[2 - player].count();
+        info.result = difference > 0 ? ProofResult::win : difference < 0 ? ProofResult::loss
+                                                                         : ProofResult::unknown;
+        return info;
+    }
+    uint64_t half = nodeLimit ? std::max<uint64_t>(1, nodeLimit / 2) : 0;
+    if (prove(position, player, half)){
+        for (Child const& child : frames[0]){               // Ход в ребенка, где противник не
+            if (child.disproof == 0){                       // достигает цели.
+                info.move = child.move;
+                break;
+            }
+        }
+        info.result = ProofResult::win;
+    } else
+    if (!interrupted && (nodeLimit == 0 || nodes < nodeLimit)
+            && prove(position, 3 - player, nodeLimit ? nodeLimit - nodes : 0)){
+        info.result = ProofResult::loss;
+    }
+    info.nodes = nodes;
+    return info;
+}
+/**
+ * @brief ProofSolver::clear Метод очищает таблицу доказательств.
+ */
+void ProofSolver::clear(){
+    table.clear();
+}
+/**
+ * @brief ProofSolver::setTableSize Метод меняет размер таблицы, если он отличается от текущего.
+ * @param sizeMb Размер в мегабайтах.
+ */
+void ProofSolver::setTableSize(int sizeMb){
+    if (sizeMb != table.sizeMb()){
+        table.resize(sizeMb);
+    }
+}
+/**
+ * @brief ProofSolver::resultName Метод возвращает название результата.
+ * @param result Результат.
+ * @return "win", "loss" или "unknown".
+ */
+char const* ProofSolver::resultName(ProofResult result){
+    return result == ProofResult::win ? "win" : result == ProofResult::loss ? "loss" : "unknown";
+}
+//............................................................................................................
+//.......................................... private methods .................................................
+//............................................................................................................
+/**
+ * @brief ProofSolver::prove Метод доказывает выигрыш стороны из позиции.
+ * @param position Позиция.
+ * @param attacker Доказывающая сторона.
+ * @param limit Наибольшее количество раскрытых позиций после уже раскрытых, 0 - без ограничения.
+ * @return true - выигрыш доказан.
+ */
+bool ProofSolver::prove(Position const& position, int attacker, uint64_t limit){
+    this->attacker = attacker;
+    nodeLimit = limit ? nodes + limit : 0;
+    aborted = false;
+    pathKeys.clear();
+    pathChips.clear();
+    uint32_t proof, disproof;
+    search(position, zobrist.key(position), 0, infinity, infinity, proof, disproof);
+    uint32_t won = position.player == attacker ? proof : disproof;// Число доказательства стороны.
+    return !aborted && won == 0;
+}
+/**
+ * @brief ProofSolver::search Метод раскрывает позицию и ищет ее детей, пока числа позиции не достигнут
+ * порогов: каждый раз - ребенка с наименьшим delta с порогами, при которых он остается лучшим.
+ * @param position Позиция.
+ * @param key Ключ позиции.
+ * @param ply Глубина от корня.
+ * @param proofLimit Порог числа доказательства.
+ * @param disproofLimit Порог числа опровержения.
+ * @param [out] proof Число доказательства цели игрока, который ходит.
+ * @param [out] disproof Число опровержения цели.
+ */
+void ProofSolver::search(Position const& position, uint64_t key, int ply, uint32_t proofLimit,
+                         uint32_t disproofLimit, uint32_t& proof, uint32_t& disproof){
+    if ((++nodes & 1023) == 0 && (stopped->load(std::memory_order_relaxed)
+                                   || (timeLimited && std::chrono::steady_clock::now() >= deadline))){
+        interrupted = true;
+    }
+    if (interrupted || (nodeLimit && nodes >= nodeLimit)){
+        aborted = true;
+    }
+    if (ply >= maxPly){                                     // Слишком длинный путь - как повторение.
+        finalNumbers(position, true, proof, disproof);
+        return;
+    }
+    uint64_t nodesBegin = nodes;
+    uint64_t entryKey = key ^ attackerKeys[attacker - 1];
+    int chips = (position.chips[0] | position.chips[1]).count();
+    pathKeys.resize(size_t(ply) + 1);
+    pathChips.resize(size_t(ply) + 1);
+    pathKeys[size_t(ply)] = key;
+    pathChips[size_t(ply)] = chips;
+    std::vector<Child>& children = frames[size_t(ply)];
+    children.clear();
+    MoveList moves;
+    board->generateMoves(position, moves);
+    for (Move const& move : moves){                         // Раскрытие: числа детей из таблицы,
+        Child child;                                        // конечных и повторенных - сразу.
+        child.position = position;
+        Bitboard flips = board->doMove(child.position, move);
+        child.key = zobrist.update(key, move, position.player, flips);
+        child.move = move;
+        child.fixed = true;
+        int childChips = chips + (move.clearBeginPostion ? 0 : 1);
+        if (!board->hasMoves(child.position, child.position.player)){
+            finalNumbers(child.position, false, child.proof, child.disproof);
+        } else
+        if (move.clearBeginPostion && repeated(child.key, childChips, ply)){
+            finalNumbers(child.position, true, child.proof, child.disproof);
+        } else {
+            child.fixed = false;
+            if (!table.probe(child.key ^ attackerKeys[attacker - 1], child.proof, child.disproof)){
+                child.proof = 1;
+                child.disproof = 1;
+            }
+        }
+        children.push_back(child);
+    }
+    while (true){
+        proof = infinity;                                   // phi = min delta детей,
+        disproof = 0;                                       // delta = сумма phi детей.
+        size_t best = 0;
+        uint32_t secondDisproof = infinity;
+        for (size_t i = 0; i < children.size(); i++){
+            Child const& child = children[i];
+            if (child.disproof < proof){
+                secondDisproof = proof;
+                proof = child.disproof;
+                best = i;
+            } else
+            if (child.disproof < secondDisproof){
+                secondDisproof = child.disproof;
+            }
+            disproof = std::min(infinity, disproof + child.proof);
+        }
+        if (proof >= proofLimit || disproof >= disproofLimit || aborted){
+            break;
+        }
+        Child& child = children[best];
+        uint32_t childProofLimit = disproofLimit >= infinity ? infinity
+                                 : std::min<uint64_t>(infinity, uint64_t(disproofLimit) - disproof + child.proof);
+        uint32_t childDisproofLimit = std::min<uint64_t>(proofLimit,                // Порог 1+epsilon.
+                std::max<uint64_t>(uint64_t(secondDisproof) + 1, uint64_t(secondDisproof) * 5 / 4));
+        search(child.position, child.key, ply + 1, childProofLimit, childDisproofLimit,
+               child.proof, child.disproof);
+    }
+    table.store(entryKey, proof, disproof, nodes - nodesBegin);
+}
+/**
+ * @brief ProofSolver::finalNumbers Метод вычисляет числа позиции без ходов или повторенной позиции.
+ * Ничья и повторение - неудача доказывающей стороны и достижение цели защищающейся.
+ * @param position Позиция.
+ * @param repetition Признак повторения (результат - ничья).
+ * @param [out] proof Число доказательства цели игрока, который ходит.
+ * @param [out] disproof Число опровержения цели.
+ */
+void ProofSolver::finalNumbers(Position const& position, bool repetition, uint32_t& proof,
+                               uint32_t& disproof) const{
+    int player = position.player;
+    int difference = repetition ? 0 : position.chips[player - 1].count() - position.chips[2 - player].count();
+    bool reached = difference > 0 || (difference == 0 && player != attacker);
+    proof = reached ? 0 : infinity;
+    disproof = reached ? infinity : 0;
+}
+/**
+ * @brief ProofSolver::repeated Метод проверяет, встречалась ли позиция на пути. Позиции с другим
+ * количеством фишек не сравниваются: количество фишек на поле не убывает.
+ * @param key Ключ позиции.
+ * @param chips Количество фишек позиции.
+ * @param ply Глубина родителя позиции.
+ * @return true - позиция есть на пути.
+ */
+bool ProofSolver::repeated(uint64_t key, int chips, int ply) const{
+    for (int i = ply; i >= 0 && pathChips[size_t(i)] == chips; i--){
+        if (pathKeys[size_t(i)] == key){
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,145 @@
+﻿/**
+* @file hexsolver.h
+* @author Oleg2008e28
+* @date 20.10.2026 09:14:26
+* @brief Заголовочный файл класса ProofSolver - решателя, доказывающего вынужденный выигрыш или проигрыш
+* поиском по числам доказательства в глубину (df-pn) с таблицей транспозиций ограниченного размера.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXSOLVER_H
+#define HEXSOLVER_H
+#include "hexsearch.h"
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The ProofEntry struct Запись таблицы доказательств: числа доказательства и опровержения позиции
+ * для игрока, который ходит, и работа (количество позиций), затраченная на них.
+ */
+struct ProofEntry {
+    uint64_t key;                                       //!Ключ позиции с ключом доказываемой стороны.
+    uint32_t proof;                                     //!Число доказательства цели игрока, который ходит.
+    uint32_t disproof;                                  //!Число опровержения цели.
+    uint32_t work;                                      //!Затраченная работа, 0 - запись пуста.
+    uint32_t reserved;                                  //!Выравнивание.
+};
+/**
+ * @brief The ProofTable class Таблица доказательств ограниченного размера. Записи сгруппированы по
+ * bucketSize в корзину ключа; новая запись вытесняет запись корзины с наименьшей работой, поэтому в
+ * таблице остаются дорогие для повторения результаты, в том числе доказанные позиции.
+ */
+class ProofTable{
+public:
+    explicit ProofTable(int sizeMb);                    // Конструктор, размер таблицы в мегабайтах.
+    void clear();                                       // Очистка таблицы.
+    void resize(int sizeMb);                            // Изменение размера таблицы с очисткой.
+    int sizeMb() const;                                 // Размер таблицы в мегабайтах.
+    bool probe(uint64_t key, uint32_t& proof,
+               uint32_t& disproof) const;               // Поиск записи позиции.
+    void store(uint64_t key, uint32_t proof,
+               uint32_t disproof, uint64_t work);       // Запись чисел позиции.
+//............................................................................................................
+public:
+    static const int bucketSize = 4;                    //!Количество записей в корзине.
+private:
+    std::vector<ProofEntry> entries;                    // Записи, количество корзин - степень двойки.
+    uint64_t mask;                                      // Маска номера корзины.
+    int requestedMb = 0;                                // Заданный размер таблицы в мегабайтах.
+};
+//............................................................................................................
+/**
+ * @brief The ProofResult enum Результат решателя для игрока, который ходит.
+ */
+enum class ProofResult : int8_t {
+    unknown,                                            //!Не доказано в пределах бюджета (или ничья).
+    win,                                                //!Вынужденный выигрыш.
+    loss                                                //!Вынужденный проигрыш.
+};
+/**
+ * @brief The ProofInfo struct Результат решения позиции.
+ */
+struct ProofInfo {
+    ProofResult result = ProofResult::unknown;          //!Результат.
+    Move move = Move{0, 0, false};                      //!Выигрывающий ход (при выигрыше).
+    uint64_t nodes = 0;                                 //!Количество раскрытых позиций.
+};
+/**
+ * @brief The ProofSolver class Решатель по числам доказательства в глубину (df-pn, Nagai) с порогом
+ * 1+epsilon для ребенка (Pawlewicz).
+ *
+ * Позиция решается двумя доказательствами: выигрыш игрока, который ходит, затем - если он опровергнут
+ * или не доказан в половине бюджета - выигрыш противника. В каждом доказательстве у игрока, который
+ * ходит, своя цель: у доказывающей стороны - выигрыш, у защищающейся - не проиграть. Для позиции хранятся
+ * числа доказательства (phi) и опровержения (delta) цели игрока, который ходит: phi позиции - наименьшее
+ * delta детей, delta позиции - сумма phi детей. Партия кончается, когда у игрока, который ходит, нет
+ * ходов; побеждает тот, у кого больше фишек.
+ *
+ * Дальние ходы позволяют повторять позиции. Повторение позиции на пути от корня, как и ничья, считается
+ * неудачей доказывающей стороны. Поэтому доказанный выигрыш или проигрыш верен всегда, а опровержение
+ * может быть неточным - решатель сообщает только выигрыш, проигрыш или "не известно". Повторение
+ * возможно только среди позиций с тем же количеством фишек на поле, поэтому проверяется только часть
+ * пути после последнего ближнего хода.
+ */
+class ProofSolver{
+public:
+    explicit ProofSolver(int tableSizeMb = defaultTableSizeMb);// Конструктор, размер таблицы.
+    ProofInfo solve(HexBoard const& board,
+                    Position const& position,
+                    uint64_t nodeLimit,
+                    std::atomic<bool> const& stop,
+                    int timeLimit = 0);                 // Решение позиции в пределах бюджета и времени.
+    void clear();                                       // Очистка таблицы доказательств.
+    void setTableSize(int sizeMb);                      // Изменение размера таблицы.
+    static char const* resultName(ProofResult result);  // Название результата: win, loss, unknown.
+//............................................................................................................
+public:
+    static const int defaultTableSizeMb = 16;           //!Размер таблицы по умолчанию.
+    static const uint32_t infinity = 0x3FFFFFFF;        //!Бесконечное число доказательства.
+    static const int maxPly = 400;                      //!Наибольшая глубина доказательства.
+//............................................................................................................
+private:
+    /**
+     * @brief The Child struct Ребенок раскрытой позиции и его текущие числа.
+     */
+    struct Child {
+        Position position;                              // Позиция после хода.
+        uint64_t key;                                   // Ключ позиции.
+        Move move;                                      // Ход.
+        uint32_t proof;                                 // Число доказательства цели противника.
+        uint32_t disproof;                              // Число опровержения цели противника.
+        bool fixed;                                     // Числа окончательные: конец партии или повторение.
+    };
+    bool prove(Position const& position, int attacker,
+               uint64_t nodeLimit);                     // Доказательство выигрыша стороны.
+    void search(Position const& position, uint64_t key,
+                int ply, uint32_t proofLimit,
+                uint32_t disproofLimit,
+                uint32_t& proof, uint32_t& disproof);   // Поиск позиции до превышения порогов.
+    void finalNumbers(Position const& position,
+                      bool repetition,
+                      uint32_t& proof,
+                      uint32_t& disproof) const;        // Числа конечной или повторенной позиции.
+    bool repeated(uint64_t key, int chips,
+                  int ply) const;                       // Повторение позиции на пути.
+private:
+    ZobristKeys zobrist;                                // Ключи Зобриста.
+    ProofTable table;                                   // Таблица доказательств.
+    HexBoard const* board = nullptr;                    // Геометрия поля текущего решения.
+    int boardSide = 0;                                  // Поле, для которого заполнена таблица.
+    Bitboard boardBlocked = Bitboard::empty();
+    int attacker = 1;                                   // Доказывающая сторона.
+    uint64_t attackerKeys[2];                           // Ключи доказывающей стороны в ключе записи.
+    std::atomic<bool> const* stopped = nullptr;         // Признак остановки.
+    std::chrono::steady_clock::time_point deadline;     // Время окончания решения.
+    bool timeLimited = false;                           // Решение ограничено по времени.
+    bool interrupted = false;                           // Решение остановлено или время вышло.
+    bool aborted = false;                               // Бюджет исчерпан или решение прервано.
+    uint64_t nodes = 0;                                 // Количество раскрытых позиций.
+    uint64_t nodeLimit = 0;                             // Бюджет текущего доказательства.
+    std::vector<std::vector<Child>> frames;             // Дети позиций пути, по глубине.
+    std::vector<uint64_t> pathKeys;                     // Ключи позиций пути.
+    std::vector<int> pathChips;                         // Количество фишек позиций пути.
+};
+#endif // HEXSOLVER_H
@@ -0,0 +1,177 @@
+﻿/**
+* @file hexsuite.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 13:07:44
+* @brief Файл реализации методов класса TestSuite.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexsuite.h"
+#include <sstream>
+/**
+ * @brief trimmed Функция удаляет пробельные символы в начале и в конце строки.
+ * @param text Строка.
+ * @return Строка без пробельных символов по краям.
+ */
+static std::string trimmed(std::string const& text){
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos){
+        return std::string();
+    }
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief TestSuite::parseLine Метод разбирает строку набора тестовых позиций.
+ * @param [in] line Строка набора.
+ * @param [out] entry Тестовая позиция.
+ * @param [out] error Описание ошибки, если строка ошибочна.
+ * @return true - строка разобрана, false - строка ошибочна.
+ */
+bool TestSuite::parseLine(std::string const& line, SuiteEntry& entry, std::string& error){
+    std::vector<std::string> fields;                        // Позиция и операции.
+    std::istringstream split(line);
+    std::string field;
+    while (std::getline(split, field, ';')){
+        fields.push_back(trimmed(field));
+    }
+    entry = SuiteEntry();
+    if (fields.empty() || !Notation::fromText(fields[0], entry.board, entry.position)){
+        error = "ошибочная запись позиции";
+        return false;
+    }
+    for (size_t i = 1; i < fields.size(); i++){
+        std::istringstream op(fields[i]);
+        std::string name;
+        op >> name;
+        if (name == "id"){
+            entry.id = trimmed(fields[i].substr(2));
+        } else
+        if (name == "bm"){
+            std::string moveText;
+            while (op >> moveText){
+                Move move;
+                if (!Notation::moveFromName(entry.board, entry.position, moveText, move)){
+                    error = "невозможный ход " + moveText;
+                    return false;
+                }
+                entry.bestMoves.push_back(move);
+            }
+        } else
+        if (name == "ce"){
+            if (!(op >> entry.score)){
+                error = "ошибочная оценка";
+                return false;
+            }
+            entry.hasScore = true;
+        } else
+        if (name == "depth"){
+            if (!(op >> entry.depth) || entry.depth < 0){
+                error = "ошибочная глубина";
+                return false;
+            }
+        } else
+        if (name == "perft"){
+            int depth = 0;
+            uint64_t nodes = 0;
+            if (!(op >> depth >> nodes) || depth < 0){
+                error = "ошибочная операция perft";
+                return false;
+            }
+            entry.perft.emplace_back(depth, nodes);
+        }
+    }
+    return true;
+}
+/**
+ * @brief TestSuite::formatLine Метод формирует строку набора тестовых позиций.
+ * @param entry Тестовая позиция.
+ * @return Строка набора.
+ */
+std::string TestSuite::formatLine(SuiteEntry const& entry){
+    std::string line = Notation::toText(entry.board, entry.position);
+    if (!entry.id.empty()){
+        line += "; id " + entry.id;
+    }
+    if (entry.depth > 0){
+        line += "; depth " + std::to_string(entry.depth);
+    }
+    if (!entry.bestMoves.empty()){
+        line += "; bm";
+        for (Move const& move : entry.bestMoves){
+            line += ' ' + Notation::moveName(entry.board, move);
+        }
+    }
+    if (entry.hasScore){
+        line += "; ce " + std::to_string(entry.score);
+    }
+    for (auto const& p : entry.perft){
+        line += "; perft " + std::to_string(p.first) + ' ' + std::to_string(p.second);
+    }
+    return line;
+}
+/**
+ * @brief TestSuite::load Метод читает набор тестовых позиций.
+ * @param [in] stream Поток чтения.
+ * @param [out] entries Тестовые позиции.
+ * @param [out] error Описание первой ошибки с номером строки.
+ * @return true - набор прочитан, false - в наборе есть ошибочная строка.
+ */
+bool TestSuite::load(std::istream& stream, std::vector<SuiteEntry>& entries, std::string& error){
+    entries.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(stream, line)){
+        lineNumber++;
+        line = trimmed(line);
+        if (line.empty() || line[0] == '#'){                // Пустые строки и комментарии.
+            continue;
+        }
+        SuiteEntry entry;
+        if (!parseLine(line, entry, error)){
+            error = "строка " + std::to_string(lineNumber) + ": " + error;
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    return true;
+}
+/**
+ * @brief TestSuite::save Метод записывает набор тестовых позиций.
+ * @param stream Поток записи.
+ * @param entries Тестовые позиции.
+ */
+void TestSuite::save(std::ostream& stream, std::vector<SuiteEntry> const& entries){
+    for (SuiteEntry const& entry : entries){
+        stream << formatLine(entry) << '\n';
+    }
+}
+/**
+ * @brief TestSuite::perft Метод подсчитывает листья дерева ходов заданной глубины. Позиция без ходов
+ * у игрока, который ходит, завершает игру и считается листом.
+ * @param board Геометрия игрового поля.
+ * @param position Позиция.
+ * @param depth Глубина.
+ * @return Количество листьев.
+ */
+uint64_t TestSuite::perft(HexBoard const& board, Position const& position, int depth){
+    if (depth == 0){
+        return 1;
+    }
+    MoveList moves;
+    if (board.generateMoves(position, moves) == 0){
+        return 1;
+    }
+    if (depth == 1){
+        return uint64_t(moves.size);
+    }
+    uint64_t nodes = 0;
+    for (Move const& move : moves){
+        Position next = position;
+        board.doMove(next, move);
+        nodes += perft(board, next, depth - 1);
+    }
+    return nodes;
+}
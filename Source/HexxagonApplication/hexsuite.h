@@ -0,0 +1,62 @@
+﻿/**
+* @file hexsuite.h
+* @author Oleg2008e28
+* @date 19.10.2026 12:52:19
+* @brief Заголовочный файл класса TestSuite - чтения и записи наборов тестовых позиций с ожидаемыми
+* лучшими ходами, оценками и количеством узлов perft. Наборы используются для замеров скорости и
+* проверки поиска на одних и тех же позициях.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXSUITE_H
+#define HEXSUITE_H
+#include "hexnotation.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <utility>
+//............................................................................................................
+/**
+ * @brief The SuiteEntry struct Тестовая позиция набора.
+ */
+struct SuiteEntry {
+    std::string id;                                     //!Название позиции.
+    HexBoard board;                                     //!Геометрия игрового поля.
+    Position position;                                  //!Позиция.
+    std::vector<Move> bestMoves;                        //!Ожидаемые лучшие ходы (любой из них).
+    bool hasScore = false;                              //!Признак заданной оценки.
+    int score = 0;                                      //!Ожидаемая оценка для игрока, который ходит.
+    int depth = 0;                                      //!Глубина поиска, 0 - не задана.
+    std::vector<std::pair<int, uint64_t>> perft;        //!Количество узлов perft по глубинам.
+};
+//............................................................................................................
+/**
+ * @brief The TestSuite class Чтение и запись набора тестовых позиций.
+ *
+ * Файл набора текстовый, одна позиция в строке. Пустые строки и строки, начинающиеся с '#', пропускаются.
+ * Строка начинается с текстовой записи позиции (см. Notation), за ней через ';' следуют операции:
+ *   id <название>           - название позиции;
+ *   bm <ход> [<ход> ...]    - лучшие ходы, верным считается любой из них;
+ *   ce <оценка>             - оценка позиции для игрока, который ходит;
+ *   depth <глубина>         - глубина поиска, на которой заданы bm и ce;
+ *   perft <глубина> <узлы>  - количество листьев дерева ходов заданной глубины.
+ * Неизвестные операции пропускаются. Пример:
+ *   x3o/6/7/4-3/o2-4x/4-3/7/6/x3o x; id start; perft 1 24; perft 2 570
+ * Набор проверяется программой HexxagonTuner --suite <файл>.
+ */
+class TestSuite{
+public:
+    static bool parseLine(std::string const& line,
+                          SuiteEntry& entry,
+                          std::string& error);          // Разбор строки набора.
+    static std::string formatLine(SuiteEntry const& entry);// Запись строки набора.
+    static bool load(std::istream& stream,
+                     std::vector<SuiteEntry>& entries,
+                     std::string& error);               // Чтение набора.
+    static void save(std::ostream& stream,
+                     std::vector<SuiteEntry> const& entries);// Запись набора.
+    static uint64_t perft(HexBoard const& board,
+                          Position const& position,
+                          int depth);                   // Подсчет листьев дерева ходов.
+};
+#endif // HEXSUITE_H
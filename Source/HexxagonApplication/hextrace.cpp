@@ -0,0 +1,276 @@
+﻿/**
+* @file hextrace.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 23:44:06
+* @brief Файл реализации методов класса Trace и счетчиков выделения памяти.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hextrace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+const int Trace::capacity;
+#if defined(HEXTRACE) && defined(HEXXAGON_LIBRARY)
+#error "Трассировка подменяет malloc процесса и не собирается в библиотеке (engine.pri)"
+#endif
+#ifdef HEXTRACE
+//............................................................................................................
+//.......................................... Счетчики выделений ..............................................
+//............................................................................................................
+#if defined(__GNUC__)
+#define HEX_TRACE_TLS __thread __attribute__((tls_model("initial-exec")))
+#else
+#define HEX_TRACE_TLS thread_local
+#endif
+static HEX_TRACE_TLS uint64_t allocationCount = 0;      // Количество выделений памяти потока.
+static HEX_TRACE_TLS uint64_t allocationBytes = 0;      // Объем выделенной потоком памяти.
+#if defined(__GLIBC__)
+// Замена функций выделения памяти glibc: их вызывают и operator new, и контейнеры Qt.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* malloc(size_t size){
+    allocationCount++;
+    allocationBytes += size;
+    return __libc_malloc(size);
+}
+void* calloc(size_t count, size_t size){
+    allocationCount++;
+    allocationBytes += count * size;
+    return __libc_calloc(count, size);
+}
+void* realloc(void* pointer, size_t size){
+    allocationCount++;
+    allocationBytes += size;
+    return __libc_realloc(pointer, size);
+}
+}
+#else
+// Без glibc считаются только выделения operator new.
+void* operator new(size_t size){
+    allocationCount++;
+    allocationBytes += size;
+    if (void* pointer = std::malloc(size ? size : 1)){
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size){
+    return operator new(size);
+}
+void operator delete(void* pointer) noexcept{
+    std::free(pointer);
+}
+void operator delete[](void* pointer) noexcept{
+    std::free(pointer);
+}
+void operator delete(void* pointer, size_t) noexcept{
+    std::free(pointer);
+}
+void operator delete[](void* pointer, size_t) noexcept{
+    std::free(pointer);
+}
+#endif
+//............................................................................................................
+//.......................................... Буфер событий ...................................................
+//............................................................................................................
+/**
+ * @brief The TraceEvent struct Событие трассы.
+ */
+struct TraceEvent {
+    char const* name;                                   //!Название.
+    char phase;                                         //!Вид: X - интервал, i - мгновенное, C - счетчик.
+    int thread;                                         //!Номер потока.
+    int64_t time;                                       //!Время начала, мкс.
+    int64_t duration;                                   //!Длительность интервала или значение счетчика.
+    uint64_t allocations;                               //!Количество выделений памяти интервала.
+    uint64_t bytes;                                     //!Объем выделений интервала.
+};
+static std::mutex traceMutex;                           // Защита буфера событий.
+static TraceEvent* events = nullptr;                    // Буфер событий.
+static int eventCount = 0;                              // Количество записанных событий.
+static int droppedCount = 0;                            // Количество событий, не поместившихся в буфер.
+static std::atomic<bool> recording{false};              // Идет запись событий.
+static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+static std::atomic<int> threadCount{0};                 // Количество потоков, записавших события.
+static HEX_TRACE_TLS int threadNumber = 0;              // Номер потока, 0 - еще не назначен.
+static int mainThread = 0;                              // Номер потока, начавшего запись.
+/**
+ * @brief currentThread Функция возвращает номер текущего потока в трассе.
+ * @return Номер, начиная с 1.
+ */
+static int currentThread(){
+    if (threadNumber == 0){
+        threadNumber = ++threadCount;
+    }
+    return threadNumber;
+}
+/**
+ * @brief record Функция записывает событие в буфер.
+ * @param event Событие.
+ */
+static void record(TraceEvent const& event){
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (eventCount < Trace::capacity){
+        events[eventCount++] = event;
+    } else {
+        droppedCount++;
+    }
+}
+#endif
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief Trace::isEnabled Метод возвращает признак сборки с трассировкой.
+ * @return true - программа собрана с CONFIG+=hextrace.
+ */
+bool Trace::isEnabled(){
+#ifdef HEXTRACE
+    return true;
+#else
+    return false;
+#endif
+}
+/**
+ * @brief Trace::start Метод начинает запись событий, прежние события удаляются.
+ */
+void Trace::start(){
+#ifdef HEXTRACE
+    std::lock_guard<std::mutex> lock(traceMutex);
+    if (!events){
+        events = new TraceEvent[capacity];
+    }
+    eventCount = 0;
+    droppedCount = 0;
+    mainThread = currentThread();
+    recording = true;
+#endif
+}
+/**
+ * @brief Trace::stop Метод заканчивает запись событий.
+ */
+void Trace::stop(){
+#ifdef HEXTRACE
+    recording = false;
+#endif
+}
+/**
+ * @brief Trace::save Метод сохраняет записанные события в формате Chrome Trace Event. Интервалы получают
+ * аргументы allocations и bytes - выделения памяти в потоке интервала.
+ * @param fileName Имя файла.
+ * @return true - файл записан.
+ */
+bool Trace::save(std::string const& fileName){
+#ifdef HEXTRACE
+    std::lock_guard<std::mutex> lock(traceMutex);
+    FILE* file = std::fopen(fileName.c_str(), "w");
+    if (!file){
+        return false;
+    }
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                       "\"args\":{\"name\":\"main\"}}", mainThread);
+    for (int i = 0; i < eventCount; i++){
+        TraceEvent const& event = events[i];
+        std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%lld",
+                     event.name, event.phase, event.thread, (long long)event.time);
+        if (event.phase == 'X'){
+            std::fprintf(file, ",\"dur\":%lld,\"args\":{\"allocations\":%llu,\"bytes\":%llu}}",
+                         (long long)event.duration, (unsigned long long)event.allocations,
+                         (unsigned long long)event.bytes);
+        } else
+        if (event.phase == 'C'){
+            std::fprintf(file, ",\"args\":{\"value\":%lld}}", (long long)event.duration);
+        } else {
+            std::fprintf(file, ",\"s\":\"t\"}");
+        }
+    }
+    std::fprintf(file, "\n],\"otherData\":{\"dropped\":%d}}\n", droppedCount);
+    return std::fclose(file) == 0;
+#else
+    (void)fileName;
+    return false;
+#endif
+}
+/**
+ * @brief Trace::now Метод возвращает время от начала записи.
+ * @return Время, мкс.
+ */
+int64_t Trace::now(){
+#ifdef HEXTRACE
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - origin).count();
+#else
+    return 0;
+#endif
+}
+/**
+ * @brief Trace::complete Метод записывает законченный интервал.
+ * @param name Название интервала.
+ * @param begin Время начала, мкс.
+ * @param allocations Количество выделений памяти в интервале.
+ * @param bytes Объем выделенной памяти.
+ */
+void Trace::complete(char const* name, int64_t begin, uint64_t allocations, uint64_t bytes){
+#ifdef HEXTRACE
+    if (recording.load(std::memory_order_relaxed)){
+        record(TraceEvent{name, 'X', currentThread(), begin, now() - begin, allocations, bytes});
+    }
+#else
+    (void)name; (void)begin; (void)allocations; (void)bytes;
+#endif
+}
+/**
+ * @brief Trace::instant Метод записывает мгновенное событие.
+ * @param name Название события.
+ */
+void Trace::instant(char const* name){
+#ifdef HEXTRACE
+    if (recording.load(std::memory_order_relaxed)){
+        record(TraceEvent{name, 'i', currentThread(), now(), 0, 0, 0});
+    }
+#else
+    (void)name;
+#endif
+}
+/**
+ * @brief Trace::counter Метод записывает значение счетчика.
+ * @param name Название счетчика.
+ * @param value Значение.
+ */
+void Trace::counter(char const* name, int64_t value){
+#ifdef HEXTRACE
+    if (recording.load(std::memory_order_relaxed)){
+        record(TraceEvent{name, 'C', currentThread(), now(), value, 0, 0});
+    }
+#else
+    (void)name; (void)value;
+#endif
+}
+/**
+ * @brief Trace::threadAllocations Метод возвращает количество выделений памяти текущим потоком.
+ * @return Количество выделений с начала работы потока.
+ */
+uint64_t Trace::threadAllocations(){
+#ifdef HEXTRACE
+    return allocationCount;
+#else
+    return 0;
+#endif
+}
+/**
+ * @brief Trace::threadBytes Метод возвращает объем памяти, выделенной текущим потоком.
+ * @return Объем в байтах с начала работы потока.
+ */
+uint64_t Trace::threadBytes(){
+#ifdef HEXTRACE
+    return allocationBytes;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,74 @@
+﻿/**
+* @file hextrace.h
+* @author Oleg2008e28
+* @date 19.10.2026 23:20:41
+* @brief Заголовочный файл трассировки: интервалов выполнения, мгновенных событий и счетчиков с
+* количеством выделений памяти внутри интервала. Трасса сохраняется в формате Chrome Trace Event
+* (chrome://tracing, ui.perfetto.dev). Трассировка включается при сборке: qmake CONFIG+=hextrace, без
+* этого макросы HEX_TRACE_* ничего не делают.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef HEXTRACE_H
+#define HEXTRACE_H
+#include <string>
+#include <cstdint>
+//............................................................................................................
+/**
+ * @brief The Trace class Запись событий трассировки. События записываются только между start и stop в
+ * заранее выделенный буфер, поэтому запись не выделяет память и не искажает счетчики выделений.
+ * Выделения считаются для каждого потока: в glibc - все вызовы malloc, calloc и realloc, в том числе
+ * внутри Qt, на остальных платформах - вызовы operator new.
+ */
+class Trace{
+public:
+    static bool isEnabled();                            // Признак сборки с трассировкой.
+    static void start();                                // Начало записи событий.
+    static void stop();                                 // Окончание записи событий.
+    static bool save(std::string const& fileName);      // Сохранение трассы в формате JSON.
+    static int64_t now();                               // Время от начала записи, мкс.
+    static void complete(char const* name, int64_t begin,
+                         uint64_t allocations,
+                         uint64_t bytes);               // Запись законченного интервала.
+    static void instant(char const* name);              // Запись мгновенного события.
+    static void counter(char const* name,
+                        int64_t value);                 // Запись значения счетчика.
+    static uint64_t threadAllocations();                // Количество выделений памяти потока.
+    static uint64_t threadBytes();                      // Объем выделенной потоком памяти.
+//............................................................................................................
+public:
+    static const int capacity = 1 << 20;                //!Наибольшее количество событий трассы.
+};
+//............................................................................................................
+/**
+ * @brief The TraceScope class Интервал трассировки: от создания объекта до выхода из области видимости.
+ * Выделения памяти интервала включают выделения вложенных интервалов.
+ */
+class TraceScope{
+public:
+    explicit TraceScope(char const* name)
+        : name(name), begin(Trace::now()),
+          allocations(Trace::threadAllocations()), bytes(Trace::threadBytes()){}
+    ~TraceScope(){
+        Trace::complete(name, begin, Trace::threadAllocations() - allocations, Trace::threadBytes() - bytes);
+    }
+    TraceScope(TraceScope const&) = delete;
+    TraceScope& operator=(TraceScope const&) = delete;
+private:
+    char const* name;                                   // Название интервала (строковый литерал).
+    int64_t begin;                                      // Время начала, мкс.
+    uint64_t allocations;                               // Счетчик выделений потока в начале.
+    uint64_t bytes;                                     // Объем выделений потока в начале.
+};
+//............................................................................................................
+#ifdef HEXTRACE
+#define HEX_TRACE_JOIN2(a, b) a##b
+#define HEX_TRACE_JOIN(a, b) HEX_TRACE_JOIN2(a, b)
+#define HEX_TRACE_SCOPE(name) TraceScope HEX_TRACE_JOIN(traceScope, __LINE__)(name)
+#define HEX_TRACE_INSTANT(name) Trace::instant(name)
+#define HEX_TRACE_COUNTER(name, value) Trace::counter(name, int64_t(value))
+#else
+#define HEX_TRACE_SCOPE(name) ((void)0)
+#define HEX_TRACE_INSTANT(name) ((void)0)
+#define HEX_TRACE_COUNTER(name, value) ((void)0)
+#endif
+#endif // HEXTRACE_H
@@ -16,9 +16,14 @@
 #include <QPoint>
 #include <QGradient>
 #include <QMouseEvent>
+#include <QResizeEvent>
+#include <QQueue>
 #include <QTimer>
 #include <QDebug>
+#include <cmath>
 #include "hexxagongame.h"
+#include "chipanimator.h"
+#include "boardrenderer.h"
 
 namespace Ui {
 class HexWidget;
@@ -34,60 +39,48 @@ public:
     ~HexWidget();                                       // Деструктор класса.
 signals:
     void transmitIndex(int index);
+    void animationFinished();                           // Сигнал об окончании анимации хода.
 public slots:
+    void setBoard(HexBoard const& newBoard);            // Слот установки геометрии игрового поля.
     void setField(QVector<int8_t>& newField);           // Слот получения вектора состояния поля.
-    void setMoveCells(QVector<int8_t> &addVec,
-                      QVector<int8_t> &transferVec);    // Передача свободных ходов.
+    void setMoveCells(QVector<int> &addVec,
+                      QVector<int> &transferVec);       // Передача свободных ходов.
     void clearAvailableMove();                          // Очистить вектора подсказок ходов на виджете.
     void makeMove(int beginIndex, int newIndex,
                   int8_t player, bool clearPosition);   // Выполнить ход на виджете.
+public:
+    void setAnimationTime(qint64 time);                 // Перевод анимации хода на заданный момент.
+    qint64 animationDuration() const;                   // Полная длительность анимации текущего хода.
 private slots:
-    void updateMoveChip();
+    void animationTick();                               // Обновление анимации хода по таймеру.
 private:
     void paintEvent(QPaintEvent* event);                // Метод отрисовки всего виджета.
+    void resizeEvent(QResizeEvent* event);              // Метод пересчета геометрии поля при изменении размера.
+    void calculateLayout();                             // Метод вычисления координат центров ячеек поля.
+    int cellAt(QPoint const& pos);                      // Метод определения индекса ячейки по координатам.
+    void flushPendingIndexes();                         // Метод передачи индексов, накопленных во время хода.
+    void finishAnimation();                             // Метод окончания анимации хода.
     void drawItemSlot(int x, int y, int R, int index);  // Метод отрисовки одной ячейки игрового поля.
     void mousePressEvent(QMouseEvent *event);           // Обработчик нажатия мыши.
-    QVector<int8_t> getNearCells(int8_t n);             // Метод вычисления индексов соседних ячеек.
 private:
-    const QVector<int8_t>clearField = {                 // Состояние пустого игрового поля при старте.
-                               0,0,0,0,0,0,0,0,0,0,     // 0-9
-                               0,0,0,0,0,0,0,0,0,0,     // 10-19
-                               0,0,3,0,0,0,0,0,0,3,     // 20-29
-                               0,0,0,0,0,0,0,0,0,3,     // 30-39
-                               0,0,0,0,0,0,0,0,0,0,     // 40-49
-                               0,0,0,0,0,0,0,0,0,0,     // 50-59
-                               0                        // 60
-                             };
+    HexBoard board;                                     // Геометрия игрового поля.
     Ui::HexWidget *ui;                                  // Указатель на объект виджет.
-    QBrush* lightSlotBrush;                             // Указатель на кисть для отрисовки светлого борта.
-    QBrush* normalSlotBrush;                            // Указатель на кисть для основного полигона
-    QBrush* darkSlotBrush;                              // Указатель на кисть для темного борта
-    QBrush* bottomSlotBrush;                            // Указатель на кисть для дна
     QBrush* addSlotBrush;                               // Указатель на кисть выделения ячейки добавления.
     QBrush* stepSlotBrush;                              // Указатель на кисть выделения ячейки перестановки.
     QPainter* painter;                                  // Указатель на объект Painter, для отрисовки виджета.
     QTimer* updater;                                    // Указатель на таймер обновления виджета.
     QVector<int8_t>fieldVec;                            // Вектор состояния игрового поля.
-    QVector<int8_t>addVec;                              // Вектор индексов ходов с добавлением фишки.
-    QVector<int8_t>stepVec;                             // Вектор индексов ходов с перестановкой фишки.
+    QVector<int>addVec;                                 // Вектор индексов ходов с добавлением фишки.
+    QVector<int>stepVec;                                // Вектор индексов ходов с перестановкой фишки.
     QVector<QPoint>cordsVec;                            // Вектор координат центров ячеек поля.
-    int rDetect;                                        // Радиус для определения ячейки указателем мыши.
-    bool drawMoveChip = false;                          // Разрешение отрисовки ходящей фишки.
-    QColor color;                                       // Переменная для цвета движущегося объекта.
-    QPoint center;                                      // Точка центра движущегося объекта.;
-    int ds;                                             // Шаг перемещения при движении.
-    QPoint point_begin;                                 // Точка начала движения объекта.
-    QPoint point_end;                                   // Точка окончания движения объекта.
-    int Rc;                                             // Вычисляемый радиус движущегося объекта.
+    QQueue<int>pendingIndexes;                          // Очередь индексов, выбранных во время хода.
+    const int maxPendingIndexes = 8;                    // Наибольшая длина очереди выбранных индексов.
+    QPoint boardCenter;                                 // Координаты центра центральной ячейки поля.
+    double columnStep = 1;                              // Расстояние между столбцами ячеек по x.
+    double rowStep = 1;                                 // Расстояние между ячейками столбца по y.
+    ChipAnimator* animator;                             // Указатель на объект анимации хода.
+    const int frameInterval = 16;                       // Период обновления виджета во время анимации, мс.
     int R;                                              // Радиус фишки на поле.
-    int nS;                                             // Количество точек перемещения.
-    int dx;                                             // Приращение координаты x на один ход при движении.
-    int dy;                                             // Приращение координаты y на один ход при движении.
-    int S;                                              // Длина отрезка перемещения.
-    int8_t enemy;                                       // Значение противника.
-    int8_t player;                                      // Значение игрока.
-    int newIndex;                                       // Индекс ячейки хода.
-    int counter = 0;                                    // Счетчик шагов перемещения.
     bool avalibleFlag = true;                           // Флаг разрешения посылки сигналов выбора ячейки.
 };
 #endif // HEXWIDGET_H
@@ -20,16 +20,43 @@ Game::Game(QObject *parent): QObject(parent){
     currentIndex = 0;                                           // Текущий индекс.
     gameDepth_1 = 0;                                            // Глубина рекурсии не выбрана.
     gameDepth_2 = 0;                                            // Глубина рекурсии не выбрана.
-    field = clearField;                                         // Загрузка стартового поля.
+    search = new SearchEngine;                                  // Таблица транспозиций анализа.
+    analysisFuture = new QFuture<void>;
+    search->setEvaluator([this](Position const& position){     // Анализ оценивает позиции так же,
+        return evaluatePosition(position, EngineProfile::Evaluator::automatic);// как миниМакс.
+    });
+    for (SearchEngine*& engine : searches){                     // Таблицы поисков компьютеров получают
+        engine = new SearchEngine(1);                           // размер профиля при первом поиске.
+    }
+    setBoard(HexBoard());                                       // Стандартное поле из 61 ячейки.
     future = new QFuture<Move>;                                 // Создание будущего объекта для хода ПК.
     timer = new QTimer(this);                                   // Созидание таймера вычисления хода ПК.
+    mcts = new MctsEngine;                                      // Пул узлов MCTS выделяется один раз.
+    turboFuture = new QFuture<void>;                            // Партия турбо-режима идет в своем потоке,
+    turboTimer = new QTimer(this);                              // поле обновляется по таймеру.
+    connect(turboTimer, SIGNAL(timeout()), this, SLOT(updateTurbo()));
 }
 /**
  * @brief Game::~Game Деструктор класса Game.
  */
 Game::~Game(){
+    analysisEnabled = false;
+    haltAnalysis();                                             // Поток анализа использует объекты игры.
+    moveStop = true;                                            // Так же и потоки хода компьютера
+    future->waitForFinished();                                  // и турбо-режима.
+    turboFuture->waitForFinished();
+    delete turboFuture;
+    delete turboTimer;
+    delete analysisFuture;
+    delete search;
+    for (SearchEngine* engine : searches){
+        delete engine;
+    }
     delete future;                                              // Удаление динамически созданных объектов.
     delete timer;
+    delete mcts;
+    delete network;
+    delete ntuple;
 }
 /**
  * @brief Game::pauseOn Метод ставит на паузу выполнение хода компьютером.
@@ -38,6 +65,7 @@ void Game::pauseOn(){
     if (state == State::witePcMove){
         disconnect(timer, SIGNAL(timeout()),                    // Отключение сигнала таймера от слота
                    this, SLOT(computerMove()));                 // хода компьютера.
+        paused = true;                                          // Окончание анимации хода не выполняет.
     }
 }
 /**
@@ -47,15 +75,23 @@ void Game::pauseOff(){
     if (state == State::witePcMove){
         connect(timer, SIGNAL(timeout()),                       // Подключение сигнала таймера к слоту
                    this, SLOT(computerMove()));                 // хода компьютера.
+        paused = false;
     }
 }
 /**
  * @brief Game::gameReset Метод остановки игры, и подготовки игрового автомата к новой игре.
  */
 void Game::gameReset(){
+    moveStop = true;                        // Остановка потоков хода компьютера и партии турбо-режима:
+    future->waitForFinished();              // миниМакс, поиск и MCTS прерываются, после ожидания потоки
+    turboFuture->waitForFinished();         // больше не используют объекты игры.
+    moveStop = false;
+    turboTimer->stop();
     timer->stop();                          // Остановка таймера ожидания хода ПК при игре против человека.
     disconnect(timer, SIGNAL(timeout()),    // Отключение сигнала таймера от слота хода компьютера.
                this, SLOT(computerMove()));
+    paused = false;                         // Пауза снимается вместе с таймером.
+    moveAnimating = false;                  // Анимация прерывается новым полем.
     modeGame = Mode::none;                  // Режим не определен
     activePlayer = 0;                       // Активный игрок не назначен.
     currentIndex = 0;                       // Текущий индекс.
@@ -65,6 +101,7 @@ void Game::gameReset(){
     state = State::none;                    // Состояние игрового автомата, остановлен.
     emit transmitField(field);              // Сигнал о передаче состояния поля.
     emit clearAvailableMove();              // Сигнал для отмены отображения доступных ходов.
+    restartAnalysis();                      // Анализ отображаемого поля.
 }
 /**
  * @brief Game::getActivePlayer Метод возвращает значение текущего игрока.
@@ -87,6 +124,20 @@ int Game::getDepth_1(){
 int Game::getDepth_2(){
     return gameDepth_2;
 }
+/**
+ * @brief Game::getBoard Метод возвращает геометрию игрового поля.
+ * @return Геометрия игрового поля.
+ */
+HexBoard const& Game::getBoard(){
+    return board;
+}
+/**
+ * @brief Game::isAnalysis Метод возвращает признак режима анализа.
+ * @return true - режим анализа включен.
+ */
+bool Game::isAnalysis(){
+    return analysisEnabled;
+}
 /**
  * @brief Game::getField Метод возвращает текущее состояние игрового поля.
  * @return Состояние игрового поля.
@@ -102,7 +153,230 @@ Game::Mode Game::getModeGame(){
     return modeGame;
 }
 /**
- * @brief Game::start Метод запуска игры.
+ * @brief Game::loadEvaluation Метод загрузки весов оценочной функции, подобранных программой HexxagonTuner.
+ * @param fileName Имя файла весов.
+ * @return true - веса загружены, false - игра не остановлена, файл не открыт или ошибочен.
+ */
+bool Game::loadEvaluation(QString const& fileName){
+    if (state != State::none){                                  // Веса могут использоваться поиском.
+        return false;
+    }
+    Evaluation loaded;
+    if (!loaded.load(fileName.toStdString())){
+        return false;
+    }
+    haltAnalysis();                                             // Веса используются потоком анализа.
+    evaluation = loaded;
+    restartAnalysis();
+    return true;
+}
+/**
+ * @brief Game::loadNetwork Метод загрузки нейросетевой оценочной функции. Сеть используется миниМаксом
+ * вместо весов evaluation, если она обучена для поля с тем же количеством ячеек.
+ * @param fileName Имя файла сети.
+ * @return true - сеть загружена, false - игра не остановлена или файл ошибочен.
+ */
+bool Game::loadNetwork(QString const& fileName){
+    if (state != State::none){                                  // Сеть может использоваться поиском.
+        return false;
+    }
+    Nnue* loaded = new Nnue;
+    if (!loaded->load(fileName.toStdString())){
+        delete loaded;
+        return false;
+    }
+    haltAnalysis();                                             // Сеть используется потоком анализа.
+    delete network;
+    network = loaded;
+    restartAnalysis();
+    return true;
+}
+/**
+ * @brief Game::loadDatabase Метод открытия базы партий. Индекс позиций хранится рядом с файлом партий
+ * с расширением .idx; если его нет или файл партий с тех пор дополнен, индекс строится заново.
+ * @param fileName Имя файла партий.
+ * @param [out] error Описание ошибки.
+ * @return true - база открыта.
+ */
+bool Game::loadDatabase(QString const& fileName, QString& error){
+    std::string recordFile = fileName.toStdString();
+    std::string indexFile = recordFile + ".idx";
+    if (!database.open(recordFile, indexFile)){
+        std::string message;
+        if (!GameDatabase::build(recordFile, indexFile, QThread::idealThreadCount(), message)
+                || !database.open(recordFile, indexFile)){
+            error = message.empty() ? QString("не удалось открыть индекс %1").arg(QString::fromStdString(indexFile))
+                                    : QString::fromStdString(message);
+            return false;
+        }
+    }
+    return true;
+}
+/**
+ * @brief Game::loadNTuple Метод загрузки оценочной функции из n-кортежей, обученной HexxagonTuner. Кортежи
+ * строятся для текущего поля, поэтому поле задается до загрузки. Оценка используется миниМаксом вместо
+ * весов evaluation, пока поле не изменено.
+ * @param fileName Имя файла таблиц.
+ * @return true - таблицы загружены, false - игра не остановлена или файл записан для другого поля.
+ */
+bool Game::loadNTuple(QString const& fileName){
+    if (state != State::none){                                  // Таблицы могут использоваться поиском.
+        return false;
+    }
+    NTupleNetwork* loaded = new NTupleNetwork(board);
+    if (!loaded->load(fileName.toStdString())){
+        delete loaded;
+        return false;
+    }
+    haltAnalysis();                                             // Таблицы используются потоком анализа.
+    delete ntuple;
+    ntuple = loaded;
+    restartAnalysis();
+    return true;
+}
+/**
+ * @brief Game::loadPosition Метод загрузки позиции из текстовой записи (см. Notation). Запись задает
+ * и геометрию поля. Загруженная позиция становится стартовой, игру начинает игрок, указанный в записи.
+ * Позиция загружается только при остановленной игре.
+ * @param text Текстовая запись позиции.
+ * @return true - позиция загружена, false - игра не остановлена или запись ошибочна.
+ */
+bool Game::loadPosition(QString const& text){
+    HexBoard newBoard;
+    Position position;
+    if (state != State::none || !Notation::fromText(text.toStdString(), newBoard, position)){
+        return false;
+    }
+    setStartPosition(newBoard, position);
+    return true;
+}
+/**
+ * @brief Game::packPosition Метод возвращает упакованную запись текущей позиции: 2 бита на ячейку
+ * и игрок, который ходит.
+ * @return Упакованная запись позиции.
+ */
+QByteArray Game::packPosition(){
+    int8_t player = activePlayer ? activePlayer : startPlayer ? startPlayer : 1;
+    std::vector<uint8_t> data = Notation::pack(board, board.positionFromField(field.constData(), player));
+    return QByteArray(reinterpret_cast<char const*>(data.data()), int(data.size()));
+}
+/**
+ * @brief Game::queryDatabase Метод ищет текущую позицию в базе партий. Игрок, который ходит, выбирается
+ * так же, как для анализа.
+ * @param hitLimit Наибольшее количество партий в списке.
+ * @return Результаты партий, прошедших через позицию; пустые, если база не открыта.
+ */
+PositionStats Game::queryDatabase(int hitLimit){
+    int player = activePlayer ? activePlayer : startPlayer ? startPlayer : 1;
+    return database.lookup(board, board.positionFromField(field.constData(), player), size_t(hitLimit));
+}
+/**
+ * @brief Game::savePosition Метод возвращает текстовую запись текущей позиции. Если игра не запущена,
+ * ходит игрок загруженной позиции или первый игрок.
+ * @return Текстовая запись позиции.
+ */
+QString Game::savePosition(){
+    int8_t player = activePlayer ? activePlayer : startPlayer ? startPlayer : 1;
+    return QString::fromStdString(
+                Notation::toText(board, board.positionFromField(field.constData(), player)));
+}
+/**
+ * @brief Game::setAnalysis Метод включает и выключает режим анализа. В режиме анализа отображаемая позиция
+ * ищется в параллельном потоке без ограничения времени, результат каждой итерации передается сигналом
+ * analysisInfo. Поиск перезапускается при каждом изменении позиции; таблица транспозиций сохраняется,
+ * поэтому позиция после хода начинает поиск с уже найденными оценками.
+ * @param enabled true - включить анализ, false - выключить.
+ */
+void Game::setAnalysis(bool enabled){
+    analysisEnabled = enabled;
+    restartAnalysis();
+}
+/**
+ * @brief Game::setBoard Метод установки геометрии игрового поля: стороны и заблокированных ячеек.
+ * Геометрия меняется только при остановленной игре.
+ * @param newBoard Геометрия игрового поля.
+ */
+void Game::setBoard(HexBoard const& newBoard){
+    if (state != State::none){                                  // Во время игры поле не меняется.
+        return;
+    }
+    haltAnalysis();                                             // Поле используется потоком анализа.
+    board = newBoard;
+    clearField.resize(board.cellCount());                       // Пустое и стартовое поля строятся
+    board.fillClearField(clearField.data());                    // по таблицам новой геометрии.
+    startField.resize(board.cellCount());
+    board.fillStartField(startField.data());
+    startPlayer = 0;                                            // Первый ход выбирается при запуске.
+    field = clearField;                                         // Загрузка пустого поля.
+    emit transmitField(field);                                  // Сигнал о передаче состояния поля.
+    restartAnalysis();
+}
+/**
+ * @brief Game::setEngine Метод выбора алгоритма хода компьютера. МиниМакс ищет на глубину, выбранную
+ * при запуске игры, MCTS ищет в течение времени хода компьютера. Остальные параметры профиля
+ * компьютера не меняются.
+ * @param player Номер компьютера (1 или 2). В режиме человек-компьютер используется компьютер 1.
+ * @param engine Алгоритм выбора хода.
+ */
+void Game::setEngine(int player, Engine engine){
+    if (player == 1 || player == 2){
+        profiles[player - 1].algorithm = engine;
+    }
+}
+/**
+ * @brief Game::setProfile Метод установки профиля компьютера: алгоритма, ограничений поиска, количества
+ * потоков, размера таблицы транспозиций и оценочной функции. Профиль действует со следующего хода.
+ * @param player Номер компьютера (1 или 2). В режиме человек-компьютер используется компьютер 1.
+ * @param profile Профиль.
+ */
+void Game::setProfile(int player, EngineProfile const& profile){
+    if (player == 1 || player == 2){
+        profiles[player - 1] = profile;
+    }
+}
+/**
+ * @brief Game::setRecordWriter Метод установки объекта записи партий. Законченные партии передаются
+ * объекту записи вместе с оценками и временем ходов компьютера.
+ * @param writer Объект записи партий, nullptr - партии не записываются.
+ */
+void Game::setRecordWriter(GameRecordWriter* writer){
+    recordWriter = writer;
+}
+/**
+ * @brief Game::appendRecord Метод передает законченную партию объекту записи. После ошибки записи в файл
+ * запись партий отключается, чтобы не продолжать дописывать оборванный файл.
+ */
+void Game::appendRecord(){
+    if (recordWriter && !recordWriter->append(record)){
+        qDebug() << "Ошибка: запись партий остановлена:" << QString::fromStdString(recordWriter->error());
+        recordWriter = nullptr;
+    }
+}
+/**
+ * @brief Game::setRootSearch Метод настройки выбора хода миниМаксом. Точные оценки получают lines лучших
+ * ходов и все ходы, уступающие лучшему не больше margin; ход выбирается случайно среди ходов, уступающих
+ * лучшему не больше margin. Остальные ходы отсекаются границей, полученной по уже оцененным ходам.
+ * @param lines Количество ходов с точной оценкой, не меньше 1.
+ * @param margin Запас оценки в единицах Evaluation::scale, 0 - выбор только среди равных лучших ходов.
+ */
+void Game::setRootSearch(int lines, int margin){
+    rootLines = std::max(1, lines);
+    randomMargin = std::max(0, margin);
+}
+/**
+ * @brief Game::setTurbo Метод включения турбо-режима игры компьютер против компьютера: компьютеры играют
+ * партии одну за другой в параллельном потоке без задержек хода и анимации, поле показывает последнюю
+ * позицию с периодом turboFrameTime, результат партии передается сигналом gameResult без диалогового
+ * окна. Вызывается при остановленной игре, счет партий обнуляется.
+ * @param enabled true - турбо-режим включен.
+ */
+void Game::setTurbo(bool enabled){
+    turbo = enabled;
+    std::fill(std::begin(turboResults), std::end(turboResults), 0);
+}
+/**
+ * @brief Game::start Метод запуска игры. Если у игрока стартовой позиции нет ходов, партия сразу
+ * заканчивается, как после последнего хода.
  * @param beginPlayer Игрок который начинает игру.
  * @param mode Режим игры.
  * @param depth_1 Глубина рекурсии для компьютера 1. (По умолчанию 0. Для игры человек против человека не
@@ -113,23 +387,51 @@ Game::Mode Game::getModeGame(){
  * как глубина рекурсии для компьютера 2.
  */
 void Game::start(int beginPlayer, Mode mode, int depth_1, int depth_2){
-    activePlayer = beginPlayer;                             // Установка текущего игрока.
+    activePlayer = startPlayer ? startPlayer : beginPlayer; // Установка текущего игрока.
     modeGame = mode;                                        // установка режима игры.
-    gameDepth_1 = depth_1;                                  // Установка глубины рекурсии 1.
-    gameDepth_2 = depth_2;                                  // Установка глубины рекурсии 2.
+    gameDepth_1 = profiles[0].depth >= 0 ? profiles[0].depth : depth_1; // Установка глубины рекурсии 1
+    gameDepth_2 = profiles[1].depth >= 0 ? profiles[1].depth : depth_2; // и 2, профиль важнее окна.
     field = startField;                                     // Установка стартового состояния поля.
+    record.begin(board,                                     // Начало записи партии.
+                 board.positionFromField(field.constData(), activePlayer),
+                 mode == Mode::pcVSpc ? gameDepth_1 : -1,
+                 mode == Mode::pcVSpc ? gameDepth_2 : mode == Mode::humanVSpc ? gameDepth_1 : -1);
     emit transmitField(field);                              // Сигнал о передаче состояния поля.
     emit transmitPlayer(activePlayer);                      // Сигнал передачи текущего игрока.
     emit transmitScore(counterChips(1), counterChips(2));   // Сигнал передачи игрового счета.
+    restartAnalysis();                                      // Анализ стартовой позиции.
+    if (findWinner()){                                      // У игрока загруженной позиции нет ходов:
+        return;                                             // партия закончена до первого хода.
+    }
         if (modeGame == Mode::humanVShuman                  // Если режим игры человек - человека,
                 || modeGame == Mode::humanVSpc){            // или человек против компьютера,
             state = State::waitIndex;                       // Автомат в состояние ожидания индекса
         } else                                              // ячейки, выбранной пользователем.
         if (modeGame == Mode::pcVSpc){                      // Если режим работы ПК против ПК,
             state = State::witePcMove;                      // Автомат переходит в режиме ожидания.
-            computerMove();                                 // Запускается выполнение хода компьютера.
+            if (turbo){                                     // В турбо-режиме партия играется в
+                startTurboGame();                           // параллельном потоке целиком.
+            } else {
+                computerMove();                             // Запускается выполнение хода компьютера.
+            }
         }
 }
+/**
+ * @brief Game::unpackPosition Метод загрузки позиции из упакованной записи. Как и loadPosition, задает
+ * геометрию поля и стартовую позицию при остановленной игре.
+ * @param data Упакованная запись позиции.
+ * @return true - позиция загружена, false - игра не остановлена или запись ошибочна.
+ */
+bool Game::unpackPosition(QByteArray const& data){
+    HexBoard newBoard;
+    Position position;
+    std::vector<uint8_t> bytes(data.constBegin(), data.constEnd());
+    if (state != State::none || !Notation::unpack(bytes, newBoard, position)){
+        return false;
+    }
+    setStartPosition(newBoard, position);
+    return true;
+}
 //............................................................................................................
 //........................................ protected methods .................................................
 //............................................................................................................
@@ -139,14 +441,12 @@ void Game::start(int beginPlayer, Mode mode, int depth_1, int depth_2){
  * @param n Индекс ячейки, для которой вычисляются ходы.
  * @return Вектор индексов доступных для хода ячеек.
  */
-QVector<int8_t> Game::getAddMoveCells(QVector<int8_t> const& field, int8_t n) {
-    QVector<int8_t> pV = getNearCells(n);                                           // Вектор для сохранения
-    for (int i = 0; i < field.size(); i++) {                                        // найденных ячеек.
-        if (field[i] != 0) {
-            QVector<int8_t>::iterator it = std::find(pV.begin(), pV.end(), i);      // Итератор для поиска.
-            if (it!= pV.end()) {
-                pV.erase(it);
-            }
+QVector<int> Game::getAddMoveCells(QVector<int8_t> const& field, int n) {
+    HEX_TRACE_SCOPE("Game::getAddMoveCells");
+    QVector<int> pV;                                                // Вектор для сохранения найденных ячеек.
+    for (int a : board.nearCells(n)) {                              // Из соседних ячеек выбираются
+        if (field[a] == 0) {                                        // пустые.
+            pV.push_back(a);
         }
     }
     return pV;
@@ -156,391 +456,16 @@ QVector<int8_t> Game::getAddMoveCells(QVector<int8_t> const& field, int8_t n) {
  * @param n Индекс выбранной ячейки.
  * @return Вектор индексов ячеек для дальнего хода.
  */
-QVector<int8_t> Game::getFarCells(int8_t n) {
-    QVector<int8_t> pV;                     // Вектор индексов ячеек для дальнего хода.
-    int8_t begin_1 = 0;                     // Начальный индекс дальнего слева столбца.
-    int8_t end_1 = 0;                       // Конечный индекс дальнего слева столбца.
-    int8_t a_1 = 0;                         // Смещение 1 для дальнего слева столбца.
-    int8_t b_1 = 0;                         // Смещение 2 для дальнего слева столбца.
-    int8_t c_1 = 0;                         // Смещение 3 для дальнего слева столбца.
-
-    int8_t begin_2 = 0;                     // Начальный индекс ближнего слева столбца.
-    int8_t end_2 = 0;                       // Конечный индекс ближнего слева столбца.
-    int8_t a_2 = 0;                         // Смещение 1 для ближнего слева столбца.
-    int8_t b_2 = 0;                         // Смещение 2 для ближнего слева столбца.
-
-    int8_t begin_3 = 0;                     // Начальный индекс текущего столбца.
-    int8_t end_3 = 0;                       // Конечный индекс текущего столбца.
-
-    int8_t begin_4 = 0;                     // Начальный индекс ближнего справа столбца.
-    int8_t end_4 = 0;                       // Конечный индекс ближнего справа столбца.
-    int8_t a_4 = 0;                         // Смещение 1 для ближнего справа столбца.
-    int8_t b_4 = 0;                         // Смещение 2 для ближнего справа столбца.
-
-    int8_t begin_5 = 0;                     // Начальный индекс дальнего справа столбца.
-    int8_t end_5 = 0;                       // Конечный индекс дальнего справа столбца.
-    int8_t a_5 = 0;                         // Смещение 1 для дальнего справа столбца.
-    int8_t b_5 = 0;                         // Смещение 2 для дальнего справа столбца.
-    int8_t c_5 = 0;                         // Смещение 3 для дальнего справа столбца.
-//............................................................................................................
-    if (n >= 0 && n <= 4) {                 // Если заданная ячейка находится в первом столбце поля.
-        begin_3 = 0;                        // Начальный индекс текущего столбца.
-        end_3 = 4;                          // Конечный индекс текущего столбца.
-        begin_4 = 5;                        // Начальный индекс ближнего справа столбца.
-        end_4 = 10;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 4;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 7;                            // Смещение 2 для ближнего справа столбца.
-        begin_5 = 11;                       // Начальный индекс дальнего справа столбца.
-        end_5 = 17;                         // Конечный индекс дальнего справа столбца.
-        a_5 = 11;                           // Смещение 1 для дальнего справа столбца.
-        b_5 = 12;                           // Смещение 2 для дальнего справа столбца.
-        c_5 = 13;                           // Смещение 3 для дальнего справа столбца.
-    }
-    if (n >= 5 && n <= 10) {                // Если заданная ячейка находится во втором столбце поля.
-        begin_2 = 0;                        // Начальный индекс ближнего слева столбца.
-        end_2 = 4;                          // Конечный индекс ближнего слева столбца.
-        a_2 = -7;                           // Смещение 1 для ближнего слева столбца.
-        b_2 = -4;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 5;                        // Начальный индекс текущего столбца.
-        end_3 = 10;                         // Конечный индекс текущего столбца.
-
-        begin_4 = 11;                       // Начальный индекс ближнего справа столбца.
-        end_4 = 17;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 5;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 8;                            // Смещение 2 для ближнего справа столбца.
-
-        begin_5 = 18;                       // Начальный индекс дальнего справа столбца.
-        end_5 = 25;                         // Конечный индекс дальнего справа столбца.
-        a_5 = 13;                           // Смещение 1 для дальнего справа столбца.
-        b_5 = 14;                           // Смещение 2 для дальнего справа столбца.
-        c_5 = 15;                           // Смещение 3 для дальнего справа столбца.
-    }
-    if (n >= 11 && n <= 17) {               // Если заданная ячейка находится в третьем столбце поля.
-        begin_1 = 0;                        // Начальный индекс дальнего слева столбца.
-        end_1 = 4;                          // Конечный индекс дальнего слева столбца.
-        a_1 = -13;                          // Смещение 1 для дальнего слева столбца.
-        b_1 = -12;                          // Смещение 2 для дальнего слева столбца.
-        c_1 = -11;                          // Смещение 3 для дальнего слева столбца.
-
-        begin_2 = 5;                        // Начальный индекс ближнего слева столбца.
-        end_2 = 10;                         // Конечный индекс ближнего слева столбца.
-        a_2 = -8;                           // Смещение 1 для ближнего слева столбца.
-        b_2 = -5;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 11;                       // Начальный индекс текущего столбца.
-        end_3 = 17;                         // Конечный индекс текущего столбца.
-
-        begin_4 = 18;                       // Начальный индекс ближнего справа столбца.
-        end_4 = 25;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 6;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 9;                            // Смещение 2 для ближнего справа столбца.
-
-        begin_5 = 26;                       // Начальный индекс дальнего справа столбца.
-        end_5 = 34;                         // Конечный индекс дальнего справа столбца.
-        a_5 = 15;                           // Смещение 1 для дальнего справа столбца.
-        b_5 = 16;                           // Смещение 2 для дальнего справа столбца.
-        c_5 = 17;                           // Смещение 3 для дальнего справа столбца.
-    }
-    if (n >= 18 && n <= 25) {               // Если заданная ячейка находится в четвертом столбце поля.
-        begin_1 = 5;                        // Начальный индекс дальнего слева столбца.
-        end_1 = 10;                         // Конечный индекс дальнего слева столбца.
-        a_1 = -15;                          // Смещение 1 для дальнего слева столбца.
-        b_1 = -14;                          // Смещение 2 для дальнего слева столбца.
-        c_1 = -13;                          // Смещение 3 для дальнего слева столбца.
-
-        begin_2 = 11;                       // Начальный индекс ближнего слева столбца.
-        end_2 = 17;                         // Конечный индекс ближнего слева столбца.
-        a_2 = -9;                           // Смещение 1 для ближнего слева столбца.
-        b_2 = -6;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 18;                       // Начальный индекс текущего столбца.
-        end_3 = 25;                         // Конечный индекс текущего столбца.
-
-        begin_4 = 26;                       // Начальный индекс ближнего справа столбца.
-        end_4 = 34;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 7;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 10;                           // Смещение 2 для ближнего справа столбца.
-
-        begin_5 = 35;                       // Начальный индекс дальнего справа столбца.
-        end_5 = 42;                         // Конечный индекс дальнего справа столбца.
-        a_5 = 16;                           // Смещение 1 для дальнего справа столбца.
-        b_5 = 17;                           // Смещение 2 для дальнего справа столбца.
-        c_5 = 18;                           // Смещение 3 для дальнего справа столбца.
-    }
-    if (n >= 26 && n <= 34) {               // Если заданная ячейка находится в пятом столбце поля.
-        begin_1 = 11;                       // Начальный индекс дальнего слева столбца.
-        end_1 = 17;                         // Конечный индекс дальнего слева столбца.
-        a_1 = -17;                          // Смещение 1 для дальнего слева столбца.
-        b_1 = -16;                          // Смещение 2 для дальнего слева столбца.
-        c_1 = -15;                          // Смещение 3 для дальнего слева столбца.
-
-        begin_2 = 18;                       // Начальный индекс ближнего слева столбца.
-        end_2 = 25;                         // Конечный индекс ближнего слева столбца.
-        a_2 = -10;                          // Смещение 1 для ближнего слева столбца.
-        b_2 = -7;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 26;                       // Начальный индекс текущего столбца.
-        end_3 = 34;                         // Конечный индекс текущего столбца.
-
-        begin_4 = 35;                       // Начальный индекс ближнего справа столбца.
-        end_4 = 42;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 7;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 10;                           // Смещение 2 для ближнего справа столбца.
-
-        begin_5 = 43;                       // Начальный индекс дальнего справа столбца.
-        end_5 = 49;                         // Конечный индекс дальнего справа столбца.
-        a_5 = 15;                           // Смещение 1 для дальнего справа столбца.
-        b_5 = 16;                           // Смещение 2 для дальнего справа столбца.
-        c_5 = 17;                           // Смещение 3 для дальнего справа столбца.
-    }
-    if (n >= 35 && n <= 42) {               // Если заданная ячейка находится в шестом столбце поля.
-        begin_1 = 18;                       // Начальный индекс дальнего слева столбца.
-        end_1 = 25;                         // Конечный индекс дальнего слева столбца.
-        a_1 = -18;                          // Смещение 1 для дальнего слева столбца.
-        b_1 = -17;                          // Смещение 2 для дальнего слева столбца.
-        c_1 = -16;                          // Смещение 3 для дальнего слева столбца.
-
-        begin_2 = 26;                       // Начальный индекс ближнего слева столбца.
-        end_2 = 34;                         // Конечный индекс ближнего слева столбца.
-        a_2 = -10;                          // Смещение 1 для ближнего слева столбца.
-        b_2 = -7;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 35;                       // Начальный индекс текущего столбца.
-        end_3 = 42;                         // Конечный индекс текущего столбца.
-
-        begin_4 = 43;                       // Начальный индекс ближнего справа столбца.
-        end_4 = 49;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 6;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 9;                            // Смещение 2 для ближнего справа столбца.
-
-        begin_5 = 50;                       // Начальный индекс дальнего справа столбца.
-        end_5 = 55;                         // Конечный индекс дальнего справа столбца.
-        a_5 = 13;                           // Смещение 1 для дальнего справа столбца.
-        b_5 = 14;                           // Смещение 2 для дальнего справа столбца.
-        c_5 = 15;                           // Смещение 3 для дальнего справа столбца.
-    }
-    if (n >= 43 && n <= 49) {               // Если заданная ячейка находится в седьмом столбце поля.
-        begin_1 = 26;                       // Начальный индекс дальнего слева столбца.
-        end_1 = 34;                         // Конечный индекс дальнего слева столбца.
-        a_1 = -17;                          // Смещение 1 для дальнего слева столбца.
-        b_1 = -16;                          // Смещение 2 для дальнего слева столбца.
-        c_1 = -15;                          // Смещение 3 для дальнего слева столбца.
-
-        begin_2 = 35;                       // Начальный индекс ближнего слева столбца.
-        end_2 = 42;                         // Конечный индекс ближнего слева столбца.
-        a_2 = -9;                           // Смещение 1 для ближнего слева столбца.
-        b_2 = -6;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 43;                       // Начальный индекс текущего столбца.
-        end_3 = 49;                         // Конечный индекс текущего столбца.
-
-        begin_4 = 50;                       // Начальный индекс ближнего справа столбца.
-        end_4 = 55;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 5;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 8;                            // Смещение 2 для ближнего справа столбца.
-
-        begin_5 = 56;                       // Начальный индекс дальнего справа столбца.
-        end_5 = 60;                         // Конечный индекс дальнего справа столбца.
-        a_5 = 11;                           // Смещение 1 для дальнего справа столбца.
-        b_5 = 12;                           // Смещение 2 для дальнего справа столбца.
-        c_5 = 13;                           // Смещение 3 для дальнего справа столбца.
-    }
-    if (n >= 50 && n <= 55) {               // Если заданная ячейка находится в восьмом столбце поля.
-        begin_1 = 35;                       // Начальный индекс дальнего слева столбца.
-        end_1 = 42;                         // Конечный индекс дальнего слева столбца.
-        a_1 = -15;                          // Смещение 1 для дальнего слева столбца.
-        b_1 = -14;                          // Смещение 2 для дальнего слева столбца.
-        c_1 = -13;                          // Смещение 3 для дальнего слева столбца.
-
-        begin_2 = 43;                       // Начальный индекс ближнего слева столбца.
-        end_2 = 49;                         // Конечный индекс ближнего слева столбца.
-        a_2 = -8;                           // Смещение 1 для ближнего слева столбца.
-        b_2 = -5;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 50;                       // Начальный индекс текущего столбца.
-        end_3 = 55;                         // Конечный индекс текущего столбца.
-
-        begin_4 = 56;                       // Начальный индекс ближнего справа столбца.
-        end_4 = 60;                         // Конечный индекс ближнего справа столбца.
-        a_4 = 4;                            // Смещение 1 для ближнего справа столбца.
-        b_4 = 7;                            // Смещение 2 для ближнего справа столбца.
-    }
-    if (n >= 56 && n <= 60) {               // Если заданная ячейка находится в девятом столбце поля.
-        begin_1 = 43;                       // Начальный индекс дальнего слева столбца.
-        end_1 = 49;                         // Конечный индекс дальнего слева столбца.
-        a_1 = -13;                          // Смещение 1 для дальнего слева столбца.
-        b_1 = -12;                          // Смещение 2 для дальнего слева столбца.
-        c_1 = -11;                          // Смещение 3 для дальнего слева столбца.
-
-        begin_2 = 50;                       // Начальный индекс ближнего слева столбца.
-        end_2 = 55;                         // Конечный индекс ближнего слева столбца.
-        a_2 = -7;                           // Смещение 1 для ближнего слева столбца.
-        b_2 = -4;                           // Смещение 2 для ближнего слева столбца.
-
-        begin_3 = 56;                       // Начальный индекс текущего столбца.
-        end_3 = 60;                         // Конечный индекс текущего столбца.
-    }
-
-    if (begin_1 != end_1) {                                                     // Вычисление ячеек в дальнем
-        if (n + a_1 >= begin_1 && n + a_1 <= end_1)  pV.push_back(n + a_1);     // левом столбце
-        if (n + b_1 >= begin_1 && n + b_1 <= end_1)  pV.push_back(n + b_1);     // (если он есть).
-        if (n + c_1 >= begin_1 && n + c_1 <= end_1)  pV.push_back(n + c_1);
-    }
-    if (begin_2 != end_2) {                                                     // Вычисление ячеек в ближнем
-        if (n + a_2 >= begin_2 && n + a_2 <= end_2)  pV.push_back(n + a_2);     // левом столбце (если он есть).
-        if (n + b_2 >= begin_2 && n + b_2 <= end_2)  pV.push_back(n + b_2);
-    }
-    if (begin_3 != end_3) {                                                     // Вычисление ячеек в текущем
-        if (n - 2 >= begin_3) pV.push_back(n - 2);                              // столбце.
-        if (n + 2 <= end_3) pV.push_back(n + 2);
-    }
-    if (begin_4 != end_4) {                                                     // Вычисление ячеек в ближнем
-        if (n + a_4 >= begin_4 && n + a_4 <= end_4)  pV.push_back(n + a_4);     // правом столбце
-        if (n + b_4 >= begin_4 && n + b_4 <= end_4)  pV.push_back(n + b_4);     // (если он есть).
-    }
-    if (begin_5 != end_5) {                                                     // Вычисление ячеек в дальнем
-        if (n + a_5 >= begin_5 && n + a_5 <= end_5)  pV.push_back(n + a_5);     // правом столбце
-        if (n + b_5 >= begin_5 && n + b_5 <= end_5)  pV.push_back(n + b_5);     // (если он есть).
-        if (n + c_5 >= begin_5 && n + c_5 <= end_5)  pV.push_back(n + c_5);
-    }
-    return pV;
+QVector<int> Game::getFarCells(int n) {
+    return QVector<int>::fromStdVector(board.farCells(n));  // Ячейки берутся из таблицы соседства поля.
 }
 /**
  * @brief Game::getNearCells Метод определяет индексы ячеек для ближнего хода.
  * @param n Индекс выбранной ячейки.
  * @return  Вектор индексов ячеек для ближнего хода.
  */
-QVector<int8_t> Game::getNearCells(int8_t n) {
-    QVector<int8_t> pV;                     // Вектор индексов ячеек для ближнего хода.
-    int8_t begin_1 = 0;                     // Начальный индекс левого столбца.
-    int8_t end_1 = 0;                       // Конечный индекс левого столбца.
-    int8_t a_1 = 0;                         // Смещение 1 для левого столбца.
-    int8_t b_1 = 0;                         // Смещение 2 для левого столбца.
-
-    int8_t begin_2 = 0;                     // Начальный индекс текущего столбца.
-    int8_t end_2 = 0;                       // Конечный индекс текущего столбца.
-
-    int8_t begin_3 = 0;                     // Начальный индекс правого столбца.
-    int8_t end_3 = 0;                       // Конечный индекс правого столбца.
-    int8_t a_3 = 0;                         // Смещение 1 для правого столбца.
-    int8_t b_3 = 0;                         // Смещение 2 для правого столбца.
-//............................................................................................................
-    if (n >= 0 && n <= 4) {                 // Если заданная ячейка находится в первом столбце поля.
-        begin_2 = 0;                        // Начальный индекс текущего столбца.
-        end_2 = 4;                          // Конечный индекс текущего столбца.
-        begin_3 = 5;                        // Начальный индекс правого столбца.
-        end_3 = 10;                         // Конечный индекс правого столбца.
-        a_3 = 5;                            // Смещение 1 для правого столбца.
-        b_3 = 6;                            // Смещение 2 для правого столбца.
-    }
-    if (n >= 5 && n <= 10) {                // Если заданная ячейка находится во втором столбце поля.
-        begin_1 = 0;                        // Начальный индекс левого столбца.
-        end_1 = 4;                          // Конечный индекс левого столбца.
-        a_1 = -6;                           // Смещение 1 для левого столбца.
-        b_1 = -5;                           // Смещение 2 для левого столбца.
-        begin_2 = 5;                        // Начальный индекс текущего столбца.
-        end_2 = 10;                         // Конечный индекс текущего столбца.
-        begin_3 = 11;                       // Начальный индекс правого столбца.
-        end_3 = 17;                         // Конечный индекс правого столбца.
-        a_3 = 6;                            // Смещение 1 для правого столбца.
-        b_3 = 7;                            // Смещение 2 для правого столбца.
-    }
-    if (n >= 11 && n <= 17) {               // Если заданная ячейка находится в третьем столбце поля.
-        begin_1 = 5;                        // Начальный индекс левого столбца.
-        end_1 = 10;                         // Конечный индекс левого столбца.
-        a_1 = -7;                           // Смещение 1 для левого столбца.
-        b_1 = -6;                           // Смещение 2 для левого столбца.
-        begin_2 = 11;                       // Начальный индекс текущего столбца.
-        end_2 = 17;                         // Конечный индекс текущего столбца.
-        begin_3 = 18;                       // Начальный индекс правого столбца.
-        end_3 = 25;                         // Конечный индекс правого столбца.
-        a_3 = 7;                            // Смещение 1 для правого столбца.
-        b_3 = 8;                            // Смещение 2 для правого столбца.
-    }
-    if (n >= 18 && n <= 25) {               // Если заданная ячейка находится в четвертом столбце поля.
-        begin_1 = 11;                       // Начальный индекс левого столбца.
-        end_1 = 17;                         // Конечный индекс левого столбца.
-        a_1 = -8;                           // Смещение 1 для левого столбца.
-        b_1 = -7;                           // Смещение 2 для левого столбца.
-        begin_2 = 18;                       // Начальный индекс текущего столбца.
-        end_2 = 25;                         // Конечный индекс текущего столбца.
-        begin_3 = 26;                       // Начальный индекс правого столбца.
-        end_3 = 34;                         // Конечный индекс правого столбца.
-        a_3 = 8;                            // Смещение 1 для правого столбца.
-        b_3 = 9;                            // Смещение 2 для правого столбца.
-    }
-
-    if (n >= 26 && n <= 34) {               // Если заданная ячейка находится в пятом столбце поля.
-        begin_1 = 18;                       // Начальный индекс левого столбца.
-        end_1 = 25;                         // Конечный индекс левого столбца.
-        a_1 = -9;                           // Смещение 1 для левого столбца.
-        b_1 = -8;                           // Смещение 2 для левого столбца.
-        begin_2 = 26;                       // Начальный индекс текущего столбца.
-        end_2 = 34;                         // Конечный индекс текущего столбца.
-        begin_3 = 35;                       // Начальный индекс правого столбца.
-        end_3 = 42;                         // Конечный индекс правого столбца.
-        a_3 = 8;                            // Смещение 1 для правого столбца.
-        b_3 = 9;                            // Смещение 2 для правого столбца.
-    }
-    if (n >= 35 && n <= 42) {               // Если заданная ячейка находится в шестом столбце поля.
-        begin_1 = 26;                       // Начальный индекс левого столбца.
-        end_1 = 34;                         // Конечный индекс левого столбца.
-        a_1 = -9;                           // Смещение 1 для левого столбца.
-        b_1 = -8;                           // Смещение 2 для левого столбца.
-        begin_2 = 35;                       // Начальный индекс текущего столбца.
-        end_2 = 42;                         // Конечный индекс текущего столбца.
-        begin_3 = 43;                       // Начальный индекс правого столбца.
-        end_3 = 49;                         // Конечный индекс правого столбца.
-        a_3 = 7;                            // Смещение 1 для правого столбца.
-        b_3 = 8;                            // Смещение 2 для правого столбца.
-    }
-    if (n >= 43 && n <= 49) {               // Если заданная ячейка находится в седьмом столбце поля.
-        begin_1 = 35;                       // Начальный индекс левого столбца.
-        end_1 = 42;                         // Конечный индекс левого столбца.
-        a_1 = -8;                           // Смещение 1 для левого столбца.
-        b_1 = -7;                           // Смещение 2 для левого столбца.
-        begin_2 = 43;                       // Начальный индекс текущего столбца.
-        end_2 = 49;                         // Конечный индекс текущего столбца.
-        begin_3 = 50;                       // Начальный индекс правого столбца.
-        end_3 = 55;                         // Конечный индекс правого столбца.
-        a_3 = 6;                            // Смещение 1 для правого столбца.
-        b_3 = 7;                            // Смещение 2 для правого столбца.
-    }
-    if (n >= 50 && n <= 55) {               // Если заданная ячейка находится в восьмом столбце поля.
-        begin_1 = 43;                       // Начальный индекс левого столбца.
-        end_1 = 49;                         // Конечный индекс левого столбца.
-        a_1 = -7;                           // Смещение 1 для левого столбца.
-        b_1 = -6;                           // Смещение 2 для левого столбца.
-        begin_2 = 50;                       // Начальный индекс текущего столбца.
-        end_2 = 55;                         // Конечный индекс текущего столбца.
-        begin_3 = 56;                       // Начальный индекс правого столбца.
-        end_3 = 60;                         // Конечный индекс правого столбца.
-        a_3 = 5;                            // Смещение 1 для правого столбца.
-        b_3 = 6;                            // Смещение 2 для правого столбца.
-    }
-    if (n >= 56 && n <= 60) {               // Если заданная ячейка находится в девятом столбце поля.
-        begin_1 = 50;                       // Начальный индекс левого столбца.
-        end_1 = 55;                         // Конечный индекс левого столбца.
-        a_1 = -6;                           // Смещение 1 для левого столбца.
-        b_1 = -5;                           // Смещение 2 для левого столбца.
-        begin_2 = 56;                       // Начальный индекс текущего столбца.
-        end_2 = 60;                         // Конечный индекс текущего столбца.
-    }
-
-    if (begin_1 != end_1) {                                                     // Вычисление ячеек в левом
-        if (n + a_1 >= begin_1 && n + a_1 <= end_1)  pV.push_back(n + a_1);     // столбце (если он есть).
-        if (n + b_1 >= begin_1 && n + b_1 <= end_1)  pV.push_back(n + b_1);
-    }
-    if (begin_2 != end_2) {                                                     // Вычисление ячеек в текущем
-        if (n - 1 >= begin_2) pV.push_back(n - 1);                              // столбце.
-        if (n + 1 <= end_2) pV.push_back(n + 1);
-    }
-    if (begin_3 != end_3) {                                                     // Вычисление ячеек в правом
-        if (n + a_3 >= begin_3 && n + a_3 <= end_3)  pV.push_back(n + a_3);     // столбце (если он есть).
-        if (n + b_3 >= begin_3 && n + b_3 <= end_3)  pV.push_back(n + b_3);
-    }
-    return pV;
+QVector<int> Game::getNearCells(int n) {
+    return QVector<int>::fromStdVector(board.nearCells(n)); // Ячейки берутся из таблицы соседства поля.
 }
 /**
  * @brief Game::getTransferMoveCells Метод возвращает индексы ячеек доступных для выполнения дальнего хода.
@@ -548,23 +473,34 @@ QVector<int8_t> Game::getNearCells(int8_t n) {
  * @param n Индекс ячейки, для которой вычисляются ходы.
  * @return Вектор индексов доступных для хода ячеек.
  */
-QVector<int8_t> Game::getTransferMoveCells(QVector<int8_t> const& field, int8_t n) {
-    QVector<int8_t> pV = getFarCells(n);                        // Вектор для сохранения найденных ячеек.
-    QVector<int8_t>::iterator it;                               // Итератор для выполнения алгоритма поиска.
-    for (int i = 0; i < field.size(); i++) {                    // Перебор всех ячеек игрового поля,
-        if (field[i] != 0) {                                    // и если ячейка не пустая, ее индекс
-            QVector<int8_t>::iterator it                        // находится в векторе pV,
-                    = std::find(pV.begin(), pV.end(), i);       // он удаляется.
-            if (it != pV.end()) {
-                pV.erase(it);
-            }
+QVector<int> Game::getTransferMoveCells(QVector<int8_t> const& field, int n) {
+    HEX_TRACE_SCOPE("Game::getTransferMoveCells");
+    QVector<int> pV;                                                // Вектор для сохранения найденных ячеек.
+    for (int a : board.farCells(n)) {                               // Из ячеек через одну выбираются
+        if (field[a] == 0) {                                        // пустые.
+            pV.push_back(a);
         }
     }
-    return pV;                                                  // Оставшиеся индексы пустых ячеек возвращается.
+    return pV;
 }
 //............................................................................................................
 //......................................... private methods ..................................................
 //............................................................................................................
+/**
+ * @brief Game::analyze Метод анализа позиции, выполняется в параллельном потоке до остановки или до
+ * наибольшей глубины поиска.
+ * @param position Позиция.
+ */
+void Game::analyze(Position position){
+    HEX_TRACE_SCOPE("Game::analyze");
+    search->analyze(board, position, SearchLimits(), [this](SearchInfo const& info){
+        QStringList line;
+        for (Move const& move : info.line){
+            line << QString::fromStdString(Notation::moveName(board, move));
+        }
+        emit analysisInfo(info.depth, info.score, line.join(" "));  // Сигнал доставляется в поток окна.
+    }, analysisStop);
+}
 /**
  * @brief Game::changePlayer Метод меняет игроков.
  */
@@ -576,6 +512,7 @@ void Game::changePlayer(){
          qDebug()<<"Ошибка: Неправильный номер игрока!";        // Проверка игрока (для отладки).
          exit(-1);
      }
+     restartAnalysis();                                         // Анализ позиции после хода.
  }
 /**
  * @brief Game::checkMoves Метод проверяет наличие ходов игрока.
@@ -583,33 +520,45 @@ void Game::changePlayer(){
  * @return
  */
 bool Game::checkMoves(int8_t player){
-    QVector<int8_t> addVec;                         // Вектор для хранения индексов ячеек для ближнего хода.
-    QVector<int8_t> stepVec;                        // Вектор для хранения индексов ячеек для дальнего хода.
-    for (int8_t i = 0; i < field.size(); i++) {     // Перебор всех ячеек в поисках фишки игрока.
-      if (field[i] == player) {                     // Если фишка игрока найдена.
-          stepVec = getTransferMoveCells(field, i); // Получаем  вектор свободных ячеек для дальних ходов.
-          addVec = getAddMoveCells(field, i);       // Получение вектора свободных ячеек для ближних ходов.
-          if (!addVec.empty()||!stepVec.empty()){
-              return true;                          // Если один из векторов не пустой, то ход есть.
-          }
-      }
+    Position position = board.positionFromField(field.constData(), player);
+    return board.hasMoves(position, player);        // Проверка по таблицам соседства поля.
+}
+/**
+ * @brief Game::batchEvaluation Метод выбирает линейную оценку для пакетной оценки листьев, если checkScore
+ * без аккумулятора сети оценивает позиции ею и она зависит только от количества фишек.
+ * @param evaluator Оценочная функция профиля.
+ * @return Оценка или nullptr, если листья оцениваются по одному.
+ */
+Evaluation const* Game::batchEvaluation(EngineProfile::Evaluator evaluator) {
+    if (evaluator == EngineProfile::Evaluator::material){
+        return &materialEvaluation;
     }
-    return false;                                   // Если оба вектора всегда пустые, ходов нет.
+    if (evaluator != EngineProfile::Evaluator::weights && ntuple && ntuple->matches(board)){
+        return nullptr;
+    }
+    return evaluation.isMaterialOnly() ? &evaluation : nullptr;
 }
 /**
  * @brief Game::checkScore Оценочная функция игры "Гексогон".
- * @param field Конфигурация игрового поля.
+ * @param position Битовая позиция.
+ * @param accumulator Аккумулятор нейросети для позиции, nullptr - оценка по n-кортежам или весам evaluation.
+ * @param evaluator Оценочная функция профиля. Незагруженные сеть и n-кортежи заменяются весами.
  * @param player Игрок, для которого выполняется вычисление оценочной функции.
- * @return Разница между количеством фишек игрока и противника.
+ * @return Оценка позиции для игрока, Evaluation::scale - одна фишка. При весах по умолчанию оценка
+ * пропорциональна разнице между количеством фишек игрока и противника.
  */
-int Game::checkScore(QVector<int8_t> const& field, int player) {
-    int counter = 0;                                    // Разница в количестве фишек игрока и противника.
-    int enemy = getOpponent(player);                    // Вычисление значения противника.
-    for (auto a : field) {                              // Перебор всех позиций игрового поля.
-        if (a == player) counter++;                     // Если обнаружена фишка игрока +1.
-        if (a == enemy) counter--;                      // Если обнаружена фишка противника -1.
+int Game::checkScore(Position const& position, NnueAccumulator const* accumulator,
+                     EngineProfile::Evaluator evaluator, int player) {
+    if (accumulator){
+        return network->evaluate(*accumulator, position.player, player);
+    }
+    if (evaluator == EngineProfile::Evaluator::material){
+        return (position.chips[player - 1].count() - position.chips[2 - player].count()) * Evaluation::scale;
     }
-    return counter;                                     // Возвращается разница.
+    if (evaluator != EngineProfile::Evaluator::weights && ntuple && ntuple->matches(board)){
+        return ntuple->evaluate(position, player);
+    }
+    return evaluation.evaluate(board, position, player);
 }
 /**
  * @brief Game::counterChips Метод выполняет подсчет количества фишек указанного игрока.
@@ -630,6 +579,7 @@ int Game::counterChips(int8_t player){
  * @param index Индекс ячейки игрового поля, для которого выполняется поиск.
  */
 void Game::createAvailableMove(int index){
+    HEX_TRACE_SCOPE("Game::createAvailableMove");
     currentIndex = index;                               // Сохранение текущего индекса в поле.
     addMoveCells =
             getAddMoveCells(field, index);              // Получения индексов ячеек для ходов с добавлением.
@@ -643,19 +593,42 @@ void Game::createAvailableMove(int index){
  * @param field Состояние игрового поля.
  * @param move Ход игрока, упакованный в структуру.
  */
-void Game::doMove(QVector<int8_t>& field, Move &move) {
+void Game::doMove(QVector<int8_t>& field, Move const& move) {
     int player = field[move.beginPostion];              // Игрок делающий ход, на в исходной позиции.
     int enemy = getOpponent(player);                    // Вычисление противника.
     if (move.clearBeginPostion) {                      // Если ход с очисткой начальной позиции,
         field[move.beginPostion] = 0;                   // очищаем ее.
     }
     field[move.newPostion] = player;                    // Устанавливаем фишку в новую позицию.
-    QVector<int8_t> tmpArountCells =
-            getNearCells(move.newPostion);              // Вектор ячеек вокруг новой позиции.
-    for (auto a : tmpArountCells) {                     // Если вокруг фишки есть противник,
+    for (int a : board.nearCells(move.newPostion)) {    // Если вокруг фишки есть противник,
         if (field[a] == enemy) field[a] = player;       // его фишки перекрашиваются.
     }
 }
+/**
+ * @brief Game::doMove Метод выполнения хода на битовой позиции. Очередь переходит к противнику.
+ * @param position Битовая позиция.
+ * @param move Ход игрока, который должен сделать ход.
+ * @return Перевернутые фишки противника.
+ */
+Bitboard Game::doMove(Position& position, Move const& move) {
+    return board.doMove(position, move);
+}
+/**
+ * @brief Game::evaluatePosition Метод оценивает позицию без аккумулятора сети, для поиска с итеративным
+ * углублением. Сеть используется так же, как миниМаксом.
+ * @param position Битовая позиция.
+ * @param evaluator Оценочная функция профиля.
+ * @return Оценка для игрока, который ходит.
+ */
+int Game::evaluatePosition(Position const& position, EngineProfile::Evaluator evaluator){
+    if ((evaluator == EngineProfile::Evaluator::automatic || evaluator == EngineProfile::Evaluator::nnue)
+            && network && network->cells() == board.cellCount()){
+        NnueAccumulator accumulator;
+        network->refresh(position, accumulator);
+        return network->evaluate(accumulator, position.player, position.player);
+    }
+    return checkScore(position, nullptr, evaluator, position.player);
+}
 /**
  * @brief Game::findWinner Метод ищет победителя, и если находит, выдает сообщение и останавливает игру.
  * @return Наличие победителя, если найден - true, если нет false.
@@ -664,37 +637,11 @@ bool Game::findWinner(){
     if (checkMoves(activePlayer)){                              // Если для активного игрока есть ходы
         return false;                                           // игра продолжается.
     }
-    QString mess = "Игра закончена в ничью.";                   // Сорока сообщение.
-    if (modeGame == Mode::humanVShuman){                        // Если режим игра человек против человека,
-        int humanScore_1 = counterChips(humanPlayer_1);         // пересчет фишек первого игрока,
-        int humanScore_2 = counterChips(humanPlayer_2);         // пересчет фишек второго игрока.
-        if (humanScore_1 > humanScore_2){                       // Если у первого фишек больше,
-           mess="Игрок номер один выиграл!";                    // он выиграл.
-        }
-        else if (humanScore_1 < humanScore_2){                  // Если больше у второго,
-           mess="Игрок номер два выиграл!";                     // выиграл второй.
-        }
-    }
-    if (modeGame == Mode::humanVSpc){                           // Если режим игры человек против компьютера,
-        int humanScore = counterChips(humanPlayer);             // пересчет фишек игрока(человека),
-        int computerScore = counterChips(computerPlayer);       // пересчет фишек компьютера.
-        if (humanScore > computerScore){                        // Если у игрока фишек больше,
-           mess="Поздравляю, Вы выиграли!";                     // игрок выиграл.
-        }
-        else if (humanScore < computerScore){                   // Если у компьютера фишек больше,
-           mess="Увы, компьютер выиграл!";                      // компьютер выиграл.
-        }
-    }
-    if (modeGame == Mode::pcVSpc){                              // Если режим игры компьютер против компьютера,
-        int computerScore_1 = counterChips(computerPlayer_1);   // пересчет фишек компьютера 1,
-        int computerScore_2 = counterChips(computerPlayer_2);   // пересчет фишек компьютера 2.
-        if (computerScore_1 > computerScore_2){                 // Если фишек компьютера 1 больше,
-           mess="Компьютер номер один выиграл!";                // Компьютер 1 победил.
-        }
-        else if (computerScore_1 < computerScore_2){            // Если фишек компьютера 2 больше,
-           mess="Компьютер номер два выиграл!";                 // победил компьютер 2.
-        }
-    }
+    int chips_1 = counterChips(1);                              // Результат партии для записи.
+    int chips_2 = counterChips(2);
+    record.result = int8_t(chips_1 > chips_2 ? 1 : chips_1 < chips_2 ? 2 : 0);
+    appendRecord();
+    QString mess = winnerMessage();                             // Сообщение о результате.
     QMessageBox msgBox;                                         // Объект диалогового окна сообщения.
     msgBox.setText(mess);                                       // Установка текста сообщения.
     msgBox.setIcon(QMessageBox::Information);                   // Установка иконки сообщения.
@@ -704,30 +651,13 @@ bool Game::findWinner(){
     return true;                                                // Победитель найден.
 }
 /**
- * @brief Game::generateMoves Функция генерации возможных ходов игрока.
- * @param [in] field Состояние игрового поля.
- * @param [out] moves Вектор для сохранения доступных ходов.
- * @param player Игрок, для которого определяются ходы.
+ * @brief Game::generateMoves Функция генерации возможных ходов игрока, который должен сделать ход.
+ * @param [in] position Битовая позиция.
+ * @param [out] moves Список для сохранения доступных ходов.
  * @return Наличие возможных ходов, true - ход есть, false - ходов нет.
  */
-bool Game::generateMoves(QVector<int8_t> const& field, QVector<Move>& moves, int player) {
-    QVector<int8_t> addVec;                            // Вектор индексов соседних ячеек, доступных для хода.
-    QVector<int8_t> stepVec;                           // Вектор индексов дальних ячеек, доступных для хода.
-    moves.clear();                                     // Очистка вектора возможных ходов.
-    for (int8_t i = 0; i < field.size(); i++) {        // Перебор всех ячеек в поисках фишки игрока.
-        if (field[i] == player) {                      // Если фишка игрока найдена.
-            stepVec = getTransferMoveCells(field, i);  // Заполнение векторов соседних ячеек данными.
-            addVec = getAddMoveCells(field, i);        // Заполнение векторов дальних ячеек данными.
-            for (auto a : addVec) {                    // Поиск возможных ходов в ближние ячейки.
-                moves.push_back(Move{i, a, false});    // Добавление хода в вектор доступных ходов.
-            }
-            for (auto a : stepVec) {                   // Поиск возможных ходов в дальние ячейки.
-                moves.push_back(Move{i, a, true});     // Добавление хода в вектор доступных ходов.
-            }
-        }
-    }
-    if (moves.empty()) return false;                    // Если вектор доступных ходов пуст,
-    return true;                                        // возвращается false, если в нем что то есть - true.
+bool Game::generateMoves(Position const& position, MoveList& moves) {
+    return board.generateMoves(position, moves) > 0;    // Если ходов нет, возвращается false.
 }
 /**
  * @brief Game::getOpponent Метод возвращает значение противника.
@@ -742,6 +672,15 @@ int8_t Game::getOpponent(int8_t player){
     }
     return opponent;                                            // Возврат значения противника.
 }
+/**
+ * @brief Game::haltAnalysis Метод останавливает поиск анализа и дожидается окончания потока. Вызывается
+ * перед изменением объектов, которые использует поиск.
+ */
+void Game::haltAnalysis(){
+    analysisStop = true;
+    analysisFuture->waitForFinished();
+    analysisStop = false;
+}
 /**
  * @brief Game::indexMaxItem Метод поиска наибольшего элемента в массиве.
  * @param Vec Вектор входных данных.
@@ -765,16 +704,22 @@ int Game::indexMaxItem(QVector<int> const& Vec){
  * @brief Game::makeComputerMove Метод выполняет ход компьютера после завершения поиска хода.
  */
 void Game::makeComputerMove(){
+    HEX_TRACE_SCOPE("Game::makeComputerMove");
     Move move = future->result();                           // Объект будущего возвращает значение хода.
+    record.addMove(board, move, computerScore, computerTime);// Ход записывается с оценкой и временем.
     doMove(field, move);                                    // Выполняется ход.
+    moveAnimating = true;                                   // До сигнала виджета об окончании анимации.
     emit makeMove(move.beginPostion,                        // Отправка согнала о необходимости сделать ход.
                   move.newPostion, activePlayer,            // Может быть принят графическим виджетом.
                   move.clearBeginPostion);
 }
 /**
- * @brief Game::miniMax Функция оценки ходов методом миниМакса с альфа-бета отсечением.
- * @param field Состояние игрового поля.
- * @param player Игрок, который должен выполнить ход.
+ * @brief Game::miniMax Функция оценки ходов методом миниМакса с альфа-бета отсечением. Выбирает узел
+ * miniMaxNode по игроку, который ходит, и по тому, максимизирует ли он оценку, дальше узлы вызывают
+ * друг друга без проверок во время выполнения.
+ * @param position Битовая позиция, в ней же игрок, который должен выполнить ход.
+ * @param accumulator Аккумулятор нейросети для позиции, nullptr - сеть не используется.
+ * @param evaluator Оценочная функция профиля.
  * @param masterPlayer Игрок в отношении которого определяется оценка.
  * @param depth Глубина рекурсии алгоритма.
  * @param level Текущий уровень рекурсии (по умолчанию равен 0, не требует изменения).
@@ -782,105 +727,378 @@ void Game::makeComputerMove(){
  * @param beta Коэффициент бета (по умолчанию равен максимальному int, не требует изменения).
  * @return Значение оценочной функции для выбранного хода, относительно игрока masterPlayer.
  */
-int Game::miniMax(QVector<int8_t> const& field, int player, int masterPlayer,
-                  int depth, int level, int alpha, int beta) {
-    if (depth == level) {                                   // Если достигнута заданная глубина рекурсии.
-        return checkScore(field, masterPlayer);             // Возвращаем оценку.
-    }
-    int enemy = getOpponent(player);                        // Вычисление значения противника.
-    int score = level % 2 == 0 ? INT_MAX : INT_MIN;         // Если уровень минимизирующий, то score
-                                                            // максимальное если уровень максимизирующий,
-                                                            // score минимальное.
-//....................... Создание всевозможные ходов, которые могут быть сыграны. ............................
-    QVector<Move>moves;                                     // Вектор для хранения всевозможных ходов игрока.
-    if (!generateMoves(field, moves, player)) {             // Если ходов нету,
-        score = checkScore(field, masterPlayer);            // считаем оценку позиции.
-        if (score > 0) {                                    // Если счет в пользу masterPlayer,
-            return INT_MAX;                                 // это победа и значение функции максимально.
-        }                                                   // Если проигрыш или ничья,
-        else return INT_MIN;                                //значение функции минимально.
-    }
-//................................ Рекурсивная проверка всех найденных ходов. .................................
-    for (auto i = 0; i < moves.size(); i++) {               // Перебор всех ходов.
-        if (alpha < beta) {                                 // Проверка условия альфа-бета.
-            QVector<int8_t> tmpField = field;               // Временное поле для отогревания хода.
-            doMove(tmpField, moves[i]);                     // Выполнение хода на игроком поле.
-            int result = miniMax(tmpField, enemy,
-                                 masterPlayer, depth,
-                                 level + 1, alpha, beta);   // Рекурсивный запуск алгоритма миниМакса.
-//........................ Вычисление алфа и бэта, выбор предпочтительной оценки. ............................
-            if (level % 2 == 0) {                           // Если уровень минимизации результата,
-                if (result < score) score = result;         // выбираем наименьшую оценку
-                if (beta > result) beta = result;           // и определяем бету как наименьшую оценку из
-            }                                               // уже просчитанных ветвей дерева.
-            else {                                          // Если уровень максимизации результата,
-                if (result > score) score = result;         // выбираем наибольшую оценку
-                if (alpha < result) alpha = result;         // и определяем альфу как наибольшую оценку из
-            }                                               // уже просчитанных ветвей дерева.
+int Game::miniMax(Position const& position, NnueAccumulator const* accumulator,
+                  EngineProfile::Evaluator evaluator,
+                  int masterPlayer, int depth, int level, int alpha, int beta) {
+    int remaining = depth - level;                          // Оставшаяся глубина.
+    if (remaining <= 0) {                                   // Если достигнута заданная глубина рекурсии.
+        return checkScore(position, accumulator, evaluator,
+                          masterPlayer);                    // Возвращаем оценку.
+    }
+    bool maximizing = position.player == masterPlayer;      // Ходит masterPlayer - оценка максимизируется.
+    if (position.player == 1) {
+        return maximizing ? miniMaxNode<1, true>(position, accumulator, evaluator, remaining, alpha, beta)
+                          : miniMaxNode<1, false>(position, accumulator, evaluator, remaining, alpha, beta);
+    }
+    return maximizing ? miniMaxNode<2, true>(position, accumulator, evaluator, remaining, alpha, beta)
+                      : miniMaxNode<2, false>(position, accumulator, evaluator, remaining, alpha, beta);
+}
+/**
+ * @brief Game::miniMaxNode Узел миниМакса: игрок, который ходит, и направление оценки известны при
+ * компиляции, поэтому в цикле по ходам нет проверок игрока и уровня. Дети узла с оставшейся глубиной 1
+ * оцениваются сразу, без вызова узла; при оценке по фишкам - все вместе, одним проходом
+ * Evaluation::evaluateMoves. После остановки игры (moveStop) узлы сразу возвращают 0.
+ * @tparam Side Игрок, который ходит (1 или 2).
+ * @tparam Maximizing true - ходит игрок, для которого вычисляется оценка, оценка максимизируется.
+ * @param position Битовая позиция.
+ * @param accumulator Аккумулятор нейросети для позиции, nullptr - сеть не используется.
+ * @param evaluator Оценочная функция профиля.
+ * @param remaining Оставшаяся глубина, не меньше 1.
+ * @param alpha Коэффициент альфа.
+ * @param beta Коэффициент бета.
+ * @return Значение оценочной функции относительно игрока, для которого вычисляется оценка.
+ */
+template<int Side, bool Maximizing>
+int Game::miniMaxNode(Position const& position, NnueAccumulator const* accumulator,
+                      EngineProfile::Evaluator evaluator, int remaining, int alpha, int beta) {
+    if (moveStop.load(std::memory_order_relaxed)) {         // Остановка игры: оценка не используется.
+        return 0;
+    }
+    const int master = Maximizing ? Side : 3 - Side;        // Игрок, для которого вычисляется оценка.
+    MoveList moves;                                         // Список всевозможных ходов игрока.
+    if (!board.generateMovesFor<Side>(position, moves)) {   // Если ходов нету, партия окончена,
+        int difference = position.chips[master - 1].count() // результат решает только счет.
+                - position.chips[2 - master].count();
+        return difference > 0 ? INT_MAX : INT_MIN;
+    }
+    int score = Maximizing ? INT_MIN : INT_MAX;
+    Evaluation const* batch = remaining == 1 && !accumulator ? batchEvaluation(evaluator) : nullptr;
+    if (batch) {                                            // Пакетная оценка листьев.
+        int scores[MoveList::capacity];
+        batch->evaluateMoves(board, position, moves, master, scores);
+        for (int i = 0; i < moves.size; i++) {
+            if (Maximizing) {
+                score = std::max(score, scores[i]);
+                alpha = std::max(alpha, scores[i]);
+            } else {
+                score = std::min(score, scores[i]);
+                beta = std::min(beta, scores[i]);
+            }
+            if (alpha >= beta) {
+                break;
+            }
+        }
+        return score;
+    }
+    for (Move const& move : moves) {                        // Перебор всех ходов.
+        Position child = position;                          // Временная позиция для отыгрывания хода.
+        NnueAccumulator childAccumulator;                   // Аккумулятор сети после хода.
+        Bitboard flips = board.doMoveFor<Side>(child, move);// Выполнение хода, очередь противника.
+        if (accumulator) {                                  // Аккумулятор меняется только на столбцы
+            childAccumulator = *accumulator;                // поставленной, снятой и перевернутых фишек.
+            network->update(childAccumulator, move, Side, flips);
+        }
+        NnueAccumulator const* next = accumulator ? &childAccumulator : nullptr;
+        int result = remaining == 1
+                ? checkScore(child, next, evaluator, master)
+                : miniMaxNode<3 - Side, !Maximizing>(child, next, evaluator, remaining - 1, alpha, beta);
+        if (Maximizing) {                                   // Наибольшая оценка поднимает альфу,
+            score = std::max(score, result);
+            alpha = std::max(alpha, result);
+        } else {                                            // наименьшая опускает бету.
+            score = std::min(score, result);
+            beta = std::min(beta, result);
         }
-        else {                                              // Если условие альфа-бета не выполняется,
+        if (alpha >= beta) {                                // Условие альфа-бета не выполняется,
             break;                                          // просчет ходов на уровне заканчивается.
         }
     }
-//.......................... Возвращается результат оценки на текущем уровне. .................................
     return score;
 }
 /**
- * @brief Game::selectComputerMove Метод выполняет выбор хода для компьютера.
- * @param field Текущее состояние игрового поля.
- * @param player Номер игрока для которого производится вычисление.
+ * @brief Game::playTurboGame Метод играет партию турбо-режима в параллельном потоке: ходы выбираются
+ * алгоритмами профилей без задержек и записываются в запись партии, после каждого хода позиция
+ * передается потоку интерфейса через turboPosition. Партия заканчивается, когда у игрока, который ходит,
+ * нет ходов, или по признаку moveStop.
+ * @param position Стартовая позиция.
+ */
+void Game::playTurboGame(Position position){
+    HEX_TRACE_SCOPE("Game::playTurboGame");
+    while (!moveStop && board.hasMoves(position, position.player)){
+        Move move = selectMove(position);
+        if (moveStop){                                              // Прерванный поиск мог не найти хода.
+            break;
+        }
+        record.addMove(board, move, computerScore, computerTime);
+        board.doMove(position, move);
+        QMutexLocker locker(&turboMutex);
+        turboPosition = position;
+        turboPly++;
+    }
+}
+/**
+ * @brief Game::profileIndex Метод возвращает номер профиля компьютера, который ходит за игрока.
+ * @param player Игрок, который ходит.
+ * @return 0 - профиль компьютера 1 (и компьютера в режиме человек-компьютер), 1 - компьютера 2.
+ */
+int Game::profileIndex(int player){
+    return modeGame == Mode::pcVSpc && player == computerPlayer_2 ? 1 : 0;
+}
+/**
+ * @brief Game::restartAnalysis Метод перезапускает анализ отображаемой позиции, если режим анализа включен.
+ * Ходит активный игрок, без игры - игрок загруженной позиции или игрок 1.
+ */
+void Game::restartAnalysis(){
+    haltAnalysis();
+    if (!analysisEnabled){
+        return;
+    }
+    int player = activePlayer ? activePlayer : startPlayer ? startPlayer : 1;
+    Position position = board.positionFromField(field.constData(), player);
+    *analysisFuture = QtConcurrent::run(this, &Game::analyze, position);
+}
+/**
+ * @brief Game::selectComputerMove Метод выполняет выбор хода для компьютера. Ходы корня проверяются по
+ * убыванию количества захватываемых фишек. Каждый ход ищется с нижней границей окна: оценкой, хуже
+ * которой ход не нужен, - rootLines-й лучшей точной оценкой, уменьшенной на randomMargin. Ход, не
+ * превысивший границу, отсекается без точной оценки. При rootLines больше 1 лучшие ходы с оценками
+ * передаются сигналом rootMovesInfo. Остановка игры (moveStop) прерывает поиск.
+ * @param position Текущая битовая позиция, в ней же игрок, для которого производится вычисление.
  * @param depth Глубина алгоритма поиска решения.
- * @return Наиболее оптимальный ход.
+ * @param evaluator Оценочная функция профиля.
+ * @return Случайный ход из ходов, уступающих лучшему не больше randomMargin; после остановки - пустой ход.
  */
-Game::Move Game::selectComputerMove(QVector<int8_t>& field, int player, int depth) {
-    int enemy = getOpponent(player);
+Move Game::selectComputerMove(Position position, int depth, EngineProfile::Evaluator evaluator) {
+    HEX_TRACE_SCOPE("Game::selectComputerMove");
+    QElapsedTimer clock;                                            // Отсчет времени выбора хода.
+    clock.start();
+    int player = position.player;                                   // Игрок, для которого выбирается ход.
 //..................... Создание всевозможных ходов, которые может отыграть компьютер. ........................
-    QVector<Move>moves;                                             // Вектор всевозможных ходов игрока.
-    if (!generateMoves(field, moves, player)) {
+    MoveList moves;                                                 // Список всевозможных ходов игрока.
+    if (!generateMoves(position, moves)) {
         return Move{0,0,0};
     }
 //.................................. Проверка ходов алгоритмом миниМакса. ....................................
-    QVector<int> score;                                             // Вектор для хранения оценок ходов.
+    bool useNetwork = network && network->cells() == board.cellCount()  // Сеть обучена для этого поля
+            && (evaluator == EngineProfile::Evaluator::automatic        // и выбрана профилем.
+                || evaluator == EngineProfile::Evaluator::nnue);
+    NnueAccumulator rootAccumulator;                                // Аккумулятор сети для позиции.
+    if (useNetwork) {
+        network->refresh(position, rootAccumulator);
+    }
+    Bitboard const& enemy = position.chips[2 - player];             // Сначала ходы, захватывающие больше
+    std::stable_sort(moves.begin(), moves.end(),                    // фишек, ближние раньше дальних: они
+                     [&](Move const& x, Move const& y){             // быстрее поднимают границу.
+        int captureX = (board.nearMask(x.newPostion) & enemy).count() * 2 + !x.clearBeginPostion;
+        int captureY = (board.nearMask(y.newPostion) & enemy).count() * 2 + !y.clearBeginPostion;
+        return captureX > captureY;
+    });
+    int lines = std::max(1, rootLines);
+    QVector<RootScore> exact;                                       // Точные оценки по убыванию.
     for (auto &a : moves) {
-        QVector<int8_t> tmpField = field;                           // Временно поле для отыгрыша хода.
-        doMove(tmpField, a);
-        score.push_back(miniMax(tmpField, enemy, player, depth));   // Запуск алгоритма миниМакса.
+        int alpha = INT_MIN;                                        // Граница: хуже lines-го лучшего хода
+        if (exact.size() >= lines) {                                // и дальше от лучшего, чем на запас.
+            long long bound = std::min<long long>(exact[lines - 1].score,
+                                                  (long long)exact[0].score - randomMargin);
+            alpha = int(std::max<long long>(bound - 1, INT_MIN));
+        }
+        Position tmpPosition = position;                            // Временная позиция для отыгрыша хода.
+        NnueAccumulator tmpAccumulator = rootAccumulator;
+        Bitboard flips = doMove(tmpPosition, a);
+        if (useNetwork) {
+            network->update(tmpAccumulator, a, player, flips);
+        }
+        int result = miniMax(tmpPosition,
+                             useNetwork ? &tmpAccumulator : nullptr, evaluator,
+                             player, depth, 0, alpha, INT_MAX);     // Запуск алгоритма миниМакса.
+        if (moveStop) {                                             // Остановка игры: оценка прерванного
+            return Move{0,0,0};                                     // поиска неверна, ход не нужен.
+        }
+        if (alpha == INT_MIN || result > alpha) {                   // Оценка точная, иначе это лишь
+            int i = exact.size();                                   // верхняя граница и ход отсекается.
+            while (i > 0 && exact[i - 1].score < result) {
+                i--;
+            }
+            exact.insert(i, RootScore{a, result});
+        }
     }
 //............................. Случайный выбор одного из наиболее выгодных ходов. ...........................
-    auto it = std::max_element(score.begin(),score.end());          // Поиск значения максимальной оценки.
-    int maxItem = *it;                                              // Получение значения по итератору.
-    QVector<int>indexMaxItem;                                       // Индексы ходов с максимальной оценкой.
-    for (int i = 0; i<score.size(); i++){                           // Заполнение вектора индексами
-        if (score[i] == maxItem){                                   // ходов с максимальной оценкой.
-            indexMaxItem.push_back(i);
-        }
+    int candidates = 1;                                             // Ходы, уступающие лучшему не больше
+    while (candidates < exact.size()                                // запаса, идут в начале вектора.
+           && (long long)exact[candidates].score >= (long long)exact[0].score - randomMargin) {
+        candidates++;
     }
     srand(time(NULL));                                              // Настройка генератора случайных чисел.
-    int randIndexMove = indexMaxItem[rand()%indexMaxItem.size()];   // Получение индекса выбранного хода.
-    return moves[randIndexMove];                                    // Возврат выбранного выгодного хода.
+    RootScore chosen = exact[rand() % candidates];                  // Получение выбранного хода.
+    if (lines > 1) {                                                // Лучшие ходы с оценками (multi-PV)
+        QStringList best;                                           // передаются в поток окна.
+        for (RootScore const& root : exact.mid(0, lines)) {
+            QString value = root.score == INT_MAX ? "выигрыш" : root.score == INT_MIN ? "проигрыш"
+                          : QString::number(double(root.score) / Evaluation::scale, 'f', 2);
+            if (root.score > 0 && root.score != INT_MAX) value.prepend('+');
+            best << QString::fromStdString(Notation::moveName(board, root.move)) + " " + value;
+        }
+        emit rootMovesInfo(QString("Лучшие ходы игрока %1: %2").arg(player).arg(best.join(", ")));
+    }
+    computerScore = chosen.score;                                   // Оценка и время хода для записи
+    computerTime = int(clock.elapsed());                            // партии, читаются после окончания потока.
+    return chosen.move;                                             // Возврат выбранного выгодного хода.
 }
 /**
- * @brief Game::startComputerMove Метод запускает вычисление хода компьютера в параллельном потоке.
+ * @brief Game::selectMctsMove Метод выполняет выбор хода для компьютера методом MCTS.
+ * @param position Текущая битовая позиция, в ней же игрок, для которого производится вычисление.
+ * @param profile Профиль компьютера: время поиска (0 - время хода по умолчанию), количество итераций
+ * и потоков (0 - все ядра).
+ * @return Ход с наибольшим количеством проходов.
  */
-void Game::startComputerMove(){
-    int gameDepth;                                                  // Глубина рекурсии алгоритма миниМакса.
-    if (modeGame == Mode::humanVSpc){                               // Если человек против компьютера,
-        gameDepth = gameDepth_1;                                    // Берется глубина рекурсии первого ПК.
-    } else                                                          // Иначе,
-    if (modeGame == Mode::pcVSpc){                                  // если ПК играет сам с собой,
-        if (activePlayer == computerPlayer_1){                      // для каждого ПК принимается
-            gameDepth = gameDepth_1;                                // своя глубина рекурсии
-        } else                                                      // соответственно.
-        if (activePlayer == computerPlayer_2){
-            gameDepth = gameDepth_2;
-        }
+Move Game::selectMctsMove(Position position, EngineProfile profile) {
+    HEX_TRACE_SCOPE("Game::selectMctsMove");
+    QElapsedTimer clock;                                            // Отсчет времени выбора хода.
+    clock.start();
+    Move move = mcts->search(board, position, profile.time > 0 ? profile.time : timeOutComputerMove,
+                             profile.threads > 0 ? profile.threads : QThread::idealThreadCount(),
+                             profile.nodes, &moveStop);
+    HEX_TRACE_COUNTER("mcts iterations", mcts->iterations());
+    computerScore = int((mcts->bestValue() * 2 - 1) * 1000);        // Доля побед в промилле от -1000
+    computerTime = int(clock.elapsed());                            // до 1000 для записи партии.
+    return move;
+}
+/**
+ * @brief Game::selectMove Метод выбирает ход компьютера алгоритмом его профиля. Вызывается в
+ * параллельном потоке.
+ * @param position Текущая битовая позиция, в ней же игрок, для которого производится вычисление.
+ * @return Ход.
+ */
+Move Game::selectMove(Position position){
+    int index = profileIndex(position.player);
+    EngineProfile const& profile = profiles[index];
+    if (profile.algorithm == Engine::mcts){                         // MCTS ищет все время хода.
+        return selectMctsMove(position, profile);
+    }
+    if (profile.algorithm == Engine::search){
+        return selectSearchMove(position, profile);
     }
+    return selectComputerMove(position, index == 0 ? gameDepth_1 : gameDepth_2, profile.evaluator);
+}
+/**
+ * @brief Game::selectSearchMove Метод выполняет выбор хода для компьютера поиском с итеративным
+ * углублением. У каждого компьютера своя таблица транспозиций размера профиля, она сохраняется между
+ * ходами.
+ * @param position Текущая битовая позиция, в ней же игрок, для которого производится вычисление.
+ * @param profile Профиль компьютера: глубина, время и количество позиций. Без ограничений глубины и
+ * количества позиций поиск идет время хода по умолчанию.
+ * @return Первый ход главного варианта.
+ */
+Move Game::selectSearchMove(Position position, EngineProfile profile) {
+    HEX_TRACE_SCOPE("Game::selectSearchMove");
+    QElapsedTimer clock;                                            // Отсчет времени выбора хода.
+    clock.start();
+    SearchEngine* engine = searches[position.player - 1];
+    engine->setTableSize(profile.hash);
+    SearchOptions options;                                          // Выборочный поиск профиля.
+    options.reductions = profile.reductions;
+    options.futility = profile.futility;
+    options.nullMove = profile.nullMove;
+    engine->setOptions(options);
+    engine->setEvaluator([this, profile](Position const& node){
+        return evaluatePosition(node, profile.evaluator);
+    });
+    SearchLimits limits;
+    limits.depth = std::max(0, profile.depth);
+    limits.nodes = uint64_t(std::max<int64_t>(0, profile.nodes));
+    limits.solverNodes = uint64_t(profile.solverNodes);
+    limits.time = profile.time > 0 ? profile.time
+                                   : limits.depth == 0 && limits.nodes == 0 ? timeOutComputerMove : 0;
+    SearchInfo info = engine->analyze(board, position, limits, SearchEngine::Reporter(),
+                                      moveStop);                    // Ход прерывается остановкой игры.
+    HEX_TRACE_COUNTER("search nodes", info.nodes);
+    computerScore = info.score;                                     // Оценка и время хода для записи
+    computerTime = int(clock.elapsed());                            // партии.
+    if (info.line.empty()){                                         // Ходов нет.
+        return Move{0,0,0};
+    }
+    return info.line.front();
+}
+/**
+ * @brief Game::setStartPosition Метод установки стартовой позиции вместе с геометрией поля.
+ * @param newBoard Геометрия игрового поля.
+ * @param position Стартовая позиция.
+ */
+void Game::setStartPosition(HexBoard const& newBoard, Position const& position){
+    setBoard(newBoard);
+    board.fieldFromPosition(position, startField.data());       // Стартовое поле по позиции.
+    startPlayer = position.player;
+    field = startField;
+    emit transmitField(field);                                  // Сигнал о передаче состояния поля.
+    restartAnalysis();
+}
+/**
+ * @brief Game::startComputerMove Метод запускает вычисление хода компьютера в параллельном потоке. В
+ * режиме компьютер-компьютер ход следующего игрока ищется, пока виджет показывает предыдущий, и
+ * выполняется, как только закончены и поиск, и анимация: задержки нет, таймер только проверяет поиск.
+ * Против человека ход показывается не раньше задержки профиля.
+ */
+void Game::startComputerMove(){
+    HEX_TRACE_SCOPE("Game::startComputerMove");
+    EngineProfile const* profile = &profiles[profileIndex(activePlayer)];// Профиль компьютера.
+    Position position = board.positionFromField(field.constData(), activePlayer);
     // Запускается метод вычисления хода в параллельном потоке.
-    *future = QtConcurrent::run(this, &Game::selectComputerMove, field, activePlayer, gameDepth);
-    timer->start(timeOutComputerMove);                              // Задержка для вычисления хода.
+    *future = QtConcurrent::run(this, &Game::selectMove, position);
+    timer->start(modeGame == Mode::pcVSpc ? pollComputerMove        // Задержка для вычисления хода.
+                                          : profile->time > 0 ? profile->time : timeOutComputerMove);
     state = State::witePcMove;                                      // Автомат в режим ожидания хода ПК.
     connect(timer, SIGNAL(timeout()), this, SLOT(computerMove()));  // Слот обработки вычисления хода.
 }
+/**
+ * @brief Game::startTurboGame Метод запускает партию турбо-режима с текущего поля в параллельном потоке
+ * и таймер отображения ее позиций.
+ */
+void Game::startTurboGame(){
+    Position position = board.positionFromField(field.constData(), activePlayer);
+    turboPosition = position;                                       // Поток партии еще не запущен.
+    turboPly = 0;
+    shownPly = 0;
+    *turboFuture = QtConcurrent::run(this, &Game::playTurboGame, position);
+    turboTimer->start(turboFrameTime);
+}
+/**
+ * @brief Game::winnerMessage Метод составляет сообщение о результате законченной партии для режима игры.
+ * @return Текст сообщения.
+ */
+QString Game::winnerMessage(){
+    QString mess = "Игра закончена в ничью.";                   // Строка сообщения.
+    if (modeGame == Mode::humanVShuman){                        // Если режим игра человек против человека,
+        int humanScore_1 = counterChips(humanPlayer_1);         // пересчет фишек первого игрока,
+        int humanScore_2 = counterChips(humanPlayer_2);         // пересчет фишек второго игрока.
+        if (humanScore_1 > humanScore_2){                       // Если у первого фишек больше,
+           mess="Игрок номер один выиграл!";                    // он выиграл.
+        }
+        else if (humanScore_1 < humanScore_2){                  // Если больше у второго,
+           mess="Игрок номер два выиграл!";                     // выиграл второй.
+        }
+    }
+    if (modeGame == Mode::humanVSpc){                           // Если режим игры человек против компьютера,
+        int humanScore = counterChips(humanPlayer);             // пересчет фишек игрока(человека),
+        int computerScore = counterChips(computerPlayer);       // пересчет фишек компьютера.
+        if (humanScore > computerScore){                        // Если у игрока фишек больше,
+           mess="Поздравляю, Вы выиграли!";                     // игрок выиграл.
+        }
+        else if (humanScore < computerScore){                   // Если у компьютера фишек больше,
+           mess="Увы, компьютер выиграл!";                      // компьютер выиграл.
+        }
+    }
+    if (modeGame == Mode::pcVSpc){                              // Если режим игры компьютер против компьютера,
+        int computerScore_1 = counterChips(computerPlayer_1);   // пересчет фишек компьютера 1,
+        int computerScore_2 = counterChips(computerPlayer_2);   // пересчет фишек компьютера 2.
+        if (computerScore_1 > computerScore_2){                 // Если фишек компьютера 1 больше,
+           mess="Компьютер номер один выиграл!";                // Компьютер 1 победил.
+        }
+        else if (computerScore_1 < computerScore_2){            // Если фишек компьютера 2 больше,
+           mess="Компьютер номер два выиграл!";                 // победил компьютер 2.
+        }
+    }
+    return mess;
+}
 //............................................................................................................
 //........................................... public slots ...................................................
 //............................................................................................................
@@ -889,6 +1107,7 @@ void Game::startComputerMove(){
  * @param index Индекс ячейки поля, полученный от графического виджета.
  */
 void Game::makeGame(int index){
+    HEX_TRACE_SCOPE("Game::makeGame");
 //.......................................... Состояние ожидания ..............................................
     if (state == State::none){                                  //Ничего не делаем, пока автомат не запущен.
         return;
@@ -910,7 +1129,7 @@ void Game::makeGame(int index){
         }
         else{                                                   // Если выбрано любое другое поле.
                 Move move;
-                QVector<int8_t>::iterator itAddMove =           // Поиск выбранного поля для хода в области
+                QVector<int>::iterator itAddMove =              // Поиск выбранного поля для хода в области
                         std::find(addMoveCells.begin(),         // доступных ближних ходов.
                                   addMoveCells.end(), index);   // Итератор для поиска ближних ходов.
                 if (itAddMove != addMoveCells.end()){           // Если поле находится в области ближних
@@ -919,7 +1138,7 @@ void Game::makeGame(int index){
                     move.clearBeginPostion = false;            // фишки и надо ли очистить начальную позицию.
                 }
                 else {                                          // Если ход не найден в области ближних ходов,
-                    QVector<int8_t>::iterator itTransferMove =  // Поиск выбранного поля для хода в области
+                    QVector<int>::iterator itTransferMove =     // Поиск выбранного поля для хода в области
                      std::find(transferMoveCells.begin(),       // доступных дальних ходов.
                               transferMoveCells.end(), index);  // Итератор для поиска дальних ходов.
                     if (itTransferMove !=
@@ -933,8 +1152,10 @@ void Game::makeGame(int index){
                         return;                                 // выбора фишки человеком. Выход из метода.
                     }
                 }
+                record.addMove(board, move);                    // Ход человека записывается без оценки.
                 doMove(field, move);                            // Полученный ход выполняется.
                 emit clearAvailableMove();                      // Сигнал отмены отображения доступных ходов.
+                moveAnimating = true;                           // Ответ компьютера ждет анимации хода.
                 emit makeMove(move.beginPostion,
                               move.newPostion,
                               activePlayer,
@@ -951,6 +1172,17 @@ void Game::makeGame(int index){
         }
     }
 }
+/**
+ * @brief Game::moveAnimated Метод получает сигнал виджета об окончании анимации хода. Если в режиме
+ * компьютер-компьютер ход уже найден, он выполняется сразу, не дожидаясь таймера.
+ */
+void Game::moveAnimated(){
+    moveAnimating = false;
+    if (modeGame == Mode::pcVSpc && state == State::witePcMove && !paused
+            && timer->isActive() && future->isFinished()){
+        computerMove();
+    }
+}
 //............................................................................................................
 //........................................... private slots ...................................................
 //............................................................................................................
@@ -962,8 +1194,9 @@ void Game::computerMove(){
          startComputerMove();                              // Запускается выполнение хода.
      }
      else{
-         if(future->isRunning()){                          // Если вычисление хода ПК еще не окончено
-             timer->start(50);                             // Таймер перезапускается с меньшей выдержкой.
+         if(future->isRunning() || moveAnimating){         // Если вычисление хода ПК еще не окончено
+             HEX_TRACE_INSTANT("Game::computerMove wait"); // или показывается прошлый ход,
+             timer->start(pollComputerMove);               // таймер перезапускается с меньшей выдержкой.
              return;                                       // Функция не меняет состояние игрового автомата.
          }
          else{                                             // Если вычисление закончено, выполняется ход.
@@ -982,3 +1215,40 @@ void Game::computerMove(){
          }
      }
 }
+/**
+ * @brief Game::updateTurbo Метод показывает последнюю позицию партии турбо-режима: промежуточные позиции
+ * между срабатываниями таймера пропускаются. Когда партия закончена, результат записывается, передается
+ * сигналом gameResult и начинается следующая партия.
+ */
+void Game::updateTurbo(){
+    bool finished = turboFuture->isFinished();                      // Позиция после окончания партии -
+    Position position;                                              // последняя.
+    int ply;
+    {
+        QMutexLocker locker(&turboMutex);
+        position = turboPosition;
+        ply = turboPly;
+    }
+    if (ply != shownPly){                                           // Поле обновляется без анимации хода.
+        shownPly = ply;
+        board.fieldFromPosition(position, field.data());
+        activePlayer = position.player;
+        emit transmitField(field);
+        emit transmitPlayer(activePlayer);
+        emit transmitScore(counterChips(1), counterChips(2));
+        restartAnalysis();
+    }
+    if (!finished || moveStop){
+        return;
+    }
+    turboTimer->stop();
+    int chips_1 = counterChips(1);                                  // Результат партии для записи.
+    int chips_2 = counterChips(2);
+    record.result = int8_t(chips_1 > chips_2 ? 1 : chips_1 < chips_2 ? 2 : 0);
+    appendRecord();
+    turboResults[record.result]++;
+    emit gameResult(QString("%1 Партий: %2, побед компьютера 1: %3, компьютера 2: %4, ничьих: %5.")
+                    .arg(winnerMessage()).arg(turboResults[0] + turboResults[1] + turboResults[2])
+                    .arg(turboResults[1]).arg(turboResults[2]).arg(turboResults[0]));
+    start(computerPlayer_1, modeGame, gameDepth_1, gameDepth_2);   // Следующая партия.
+}
@@ -12,12 +12,33 @@
 #include <QMessageBox>
 #include <QDebug>
 #include <QObject>
+#include <QMutex>
 #include <QThread>
+#include <QElapsedTimer>
 #include <QtConcurrent/QtConcurrent>
 #include <QRadialGradient>
 #include <climits>
 #include <algorithm>
 #include <ctime>
+#include "hexboard.h"
+#include "hexnotation.h"
+#include "gamerecord.h"
+#include "gamedatabase.h"
+#include "hexevaluation.h"
+#include "hexmcts.h"
+#include "hexnnue.h"
+#include "hexntuple.h"
+#include "hexsearch.h"
+#include "hexprofile.h"
+#include "hextrace.h"
+//............................................................................................................
+/**
+ * @brief The RootScore struct Ход компьютера с точной оценкой миниМакса.
+ */
+struct RootScore {
+    Move move;                                          //!Ход.
+    int score;                                          //!Оценка для игрока, сделавшего ход.
+};
 //............................................................................................................
 class Game : public QObject{
     Q_OBJECT
@@ -31,6 +52,7 @@ public:
         humanVSpc,                                      //!Компьютер против компьютера.
         pcVSpc
     };
+    typedef EngineProfile::Algorithm Engine;            //!Алгоритмы выбора хода компьютера.
 private:
     /**
      * @brief The State enum Возможние состояния игрового автомата.
@@ -42,14 +64,6 @@ private:
         pcMove,                                         //!Игрок против компьютера.
         witePcMove                                      //!Состояние ожидания хода компьютера.
     };
-    /**
-     * @brief The Move struct Объект для хранения хода.
-     */
-    struct Move {
-        int8_t beginPostion;                            //!Текущая позиция фишки.
-        int8_t newPostion;                              //!Новая позиция фишки.
-        bool clearBeginPostion;                        //!Очистка начальной позиции true-очистить, false-нет.
-    };
 //............................................................................................................
 public:
 explicit Game(QObject *parent = nullptr);               // Конструктор класса Game.
@@ -60,43 +74,93 @@ explicit Game(QObject *parent = nullptr);               // Конструкто
     int getActivePlayer();                              // Метод возвращает значение текущего игрока.
     int getDepth_1();                                   // Метод возвращает глубину рекурсии 1.
     int getDepth_2();                                   // Метод возвращает глубины рекурсии 2.
+    HexBoard const& getBoard();                         // Метод возвращает геометрию игрового поля.
+    bool isAnalysis();                                  // Метод возвращает признак режима анализа.
     QVector<int8_t> getField();                         // Метод возвращает текущее состояние игрового поля.
     Mode getModeGame();                                 // Метод возвращает режима игры.
+    bool loadDatabase(QString const& fileName,
+                      QString& error);                  // Метод открытия базы партий.
+    bool loadEvaluation(QString const& fileName);       // Метод загрузки весов оценочной функции.
+    bool loadNetwork(QString const& fileName);          // Метод загрузки нейросетевой оценочной функции.
+    bool loadNTuple(QString const& fileName);           // Метод загрузки оценки из n-кортежей.
+    bool loadPosition(QString const& text);             // Метод загрузки позиции из текстовой записи.
+    QByteArray packPosition();                          // Метод возвращает упакованную запись позиции.
+    PositionStats queryDatabase(int hitLimit);          // Метод поиска текущей позиции в базе партий.
+    QString savePosition();                             // Метод возвращает текстовую запись позиции.
+    void setAnalysis(bool enabled);                     // Метод включения режима анализа.
+    void setBoard(HexBoard const& newBoard);            // Метод установки геометрии игрового поля.
+    void setEngine(int player, Engine engine);          // Метод выбора алгоритма хода компьютера.
+    void setProfile(int player,
+                    EngineProfile const& profile);      // Метод установки профиля компьютера.
+    void setRecordWriter(GameRecordWriter* writer);     // Метод установки объекта записи партий.
+    void setRootSearch(int lines, int margin);          // Метод настройки выбора хода миниМаксом.
+    void setTurbo(bool enabled);                        // Метод включения турбо-режима компьютеров.
     void start(int beginPlayer, Mode mode,
                int depth_1=0, int depth_2=0);           // Метод запуска игры.
+    bool unpackPosition(QByteArray const& data);        // Метод загрузки позиции из упакованной записи.
 //............................................................................................................
 protected:
-    QVector<int8_t>
+    QVector<int>
     getAddMoveCells(QVector<int8_t> const& field,
-                    int8_t n);                          // Метод определяет доступные ячейки для ближнего хода.
-    QVector<int8_t> getFarCells(int8_t n);              // Метод определяет индексы ячеек для дальнего хода.
-    QVector<int8_t> getNearCells(int8_t n);             // Метод определяет индексы ячеек для ближнего хода.
-    QVector<int8_t>
+                    int n);                             // Метод определяет доступные ячейки для ближнего хода.
+    QVector<int> getFarCells(int n);                    // Метод определяет индексы ячеек для дальнего хода.
+    QVector<int> getNearCells(int n);                   // Метод определяет индексы ячеек для ближнего хода.
+    QVector<int>
     getTransferMoveCells(QVector<int8_t> const& field,
-                         int8_t n);                     // Метод определяет доступные ячейки для дальнего хода.
+                         int n);                        // Метод определяет доступные ячейки для дальнего хода.
 //............................................................................................................
 private:
+    void analyze(Position position);                    // Метод анализа позиции в параллельном потоке.
+    void appendRecord();                                // Метод записи законченной партии.
     void changePlayer();                                // Метод смены игрока.
     bool checkMoves(int8_t player);                     // Метод проверяет наличие ходов игрока.
-    int checkScore(QVector<int8_t> const& field,
+    Evaluation const*
+    batchEvaluation(EngineProfile::Evaluator evaluator);// Оценка для пакетной оценки листьев.
+    int checkScore(Position const& position,
+                   NnueAccumulator const* accumulator,
+                   EngineProfile::Evaluator evaluator,
                    int player);                         // Оценочная функция игры "Гексогон".
     int counterChips(int8_t player);                    // Метод выполняет подсчет фишек указанного игрока.
     void createAvailableMove(int index);                // Метод определения доступных ходов для человека.
-    void doMove(QVector<int8_t>& field, Move &move);    // Выполнение хода по структуре Move.
+    void doMove(QVector<int8_t>& field,
+                Move const& move);                      // Выполнение хода по структуре Move на поле.
+    Bitboard doMove(Position& position,
+                    Move const& move);                  // Выполнение хода на битовой позиции.
+    int evaluatePosition(Position const& position,
+                         EngineProfile::Evaluator evaluator);// Оценка для игрока, который ходит.
     bool findWinner();                                  // Метод поиска победителя.
-    bool generateMoves(QVector<int8_t> const& field,
-                       QVector<Move>& moves,
-                       int player);                     // Метод генерации ходов игрока.
+    bool generateMoves(Position const& position,
+                       MoveList& moves);                // Метод генерации ходов игрока, который ходит.
     int8_t getOpponent(int8_t player);                  // Метод возвращает значение противника.
+    void haltAnalysis();                                // Метод останавливает поиск анализа.
     int indexMaxItem(QVector<int> const& Vec);          // Метод поиска наибольшего элемента в массиве.
     void makeComputerMove();                            // Метод выполняющий найденный ход компьютера.
-    int miniMax(QVector<int8_t>const& field, int player, // Метод оценки ходов методом миниМакса с
-               int masterPlayer, int depth, int level=0, // альфа-бета отсечением.
+    void playTurboGame(Position position);              // Метод партии турбо-режима в параллельном потоке.
+    int profileIndex(int player);                       // Метод возвращает номер профиля компьютера.
+    void restartAnalysis();                             // Метод перезапускает анализ текущей позиции.
+    int miniMax(Position const& position,               // Метод оценки ходов методом миниМакса с
+               NnueAccumulator const* accumulator,      // альфа-бета отсечением.
+               EngineProfile::Evaluator evaluator,
+               int masterPlayer, int depth, int level=0,
                int alpha=INT_MIN, int beta = INT_MAX);
-    Move selectComputerMove(QVector<int8_t>& field,
-                            int player, int depth);     // Метод выполняет выбор хода для компьютера.
+    template<int Side, bool Maximizing>
+    int miniMaxNode(Position const& position,
+                    NnueAccumulator const* accumulator,
+                    EngineProfile::Evaluator evaluator,
+                    int remaining, int alpha, int beta);// Узел миниМакса игрока Side.
+    Move selectComputerMove(Position position, int depth,
+                            EngineProfile::Evaluator evaluator);// Метод выполняет выбор хода для компьютера.
+    Move selectMctsMove(Position position,
+                        EngineProfile profile);         // Метод выбора хода компьютера методом MCTS.
+    Move selectMove(Position position);                 // Метод выбора хода алгоритмом профиля игрока.
+    Move selectSearchMove(Position position,
+                          EngineProfile profile);       // Метод выбора хода итеративным углублением.
+    void setStartPosition(HexBoard const& newBoard,
+                          Position const& position);    // Метод установки стартовой позиции.
     void startComputerMove();                           // Метод запускает вычисление хода компьютера в
                                                         // параллельном потоке.
+    void startTurboGame();                              // Метод запускает партию турбо-режима.
+    QString winnerMessage();                            // Метод составляет сообщение о результате партии.
 //..........................................................................................................
 signals:
     void clearAvailableMove();                          // Сигнал для отмены отображения доступных ходов.
@@ -104,17 +168,23 @@ signals:
     void makeMove(int currentPosition, int newPosition,
                   int8_t player, bool clearCurrentPos); // Сигнал графическому виджету сделать ход.
     void transmitField(QVector<int8_t>& field);         // Сигнал о передаче состояния поля.
-    void transmitMoveCells(QVector<int8_t>&addMoveCells,
-                    QVector<int8_t> &transferMoveCells);// Сигнал передачи виджету доступных ходов.
+    void transmitMoveCells(QVector<int>&addMoveCells,
+                    QVector<int> &transferMoveCells);   // Сигнал передачи виджету доступных ходов.
     void transmitPlayer(int8_t activePlayer);           // Сигнал передачи текущего игрока.
     void transmitScore(int score_1, int score_2);       // Сигнал передачи игрового счета.
+    void analysisInfo(int depth, int score,
+                      QString line);                    // Сигнал передачи результата итерации анализа.
+    void gameResult(QString message);                   // Сигнал о результате партии турбо-режима.
+    void rootMovesInfo(QString lines);                  // Сигнал передачи лучших ходов миниМакса (multi-PV).
 //..........................................................................................................
 public slots:
     void makeGame(int index);                           // Метод игрового режима Человек-Человек,
                                                         // и человек компьютер.
+    void moveAnimated();                                // Метод получения сигнала об окончании анимации.
 private slots:
     void computerMove();                                // Метод выполняет ход компьютера
                                                         // (полный ход, от начала до конца).
+    void updateTurbo();                                 // Метод отображения партии турбо-режима.
 //..........................................................................................................
 public:
     static const int8_t humanPlayer_1 = 1;              //!Номер первого игрока в режиме человек-человек.
@@ -126,35 +196,54 @@ public:
 //..........................................................................................................
 private:
     State state = State::none;                          // Состояние игрового автомата.
+    HexBoard board;                                     // Геометрия игрового поля.
+    Evaluation evaluation;                              // Оценочная функция.
+    Evaluation materialEvaluation;                      // Веса по умолчанию: оценка по разности фишек.
+    MctsEngine* mcts;                                   // Поиск Монте-Карло по дереву.
+    Nnue* network = nullptr;                            // Нейросетевая оценка, nullptr - оценка evaluation.
+    NTupleNetwork* ntuple = nullptr;                    // Оценка из n-кортежей, nullptr - оценка evaluation.
+    SearchEngine* search;                               // Поиск режима анализа.
+    SearchEngine* searches[2];                          // Поиски компьютеров 1 и 2 со своими таблицами.
+    QFuture<void>* analysisFuture;                      // Поток анализа.
+    std::atomic<bool> analysisStop{false};              // Признак остановки поиска анализа.
+    bool analysisEnabled = false;                       // Режим анализа включен.
+    EngineProfile profiles[2];                          // Профили компьютеров 1 и 2.
     QVector<int8_t>field;                               // Вектор для хранения состояния игрового поля.
-    QVector<int8_t> addMoveCells;                       // Вектор для хранения ближних ходов.
-    QVector<int8_t> transferMoveCells;                  // Вектор для хранения дальних ходов.
+    QVector<int> addMoveCells;                          // Вектор для хранения ближних ходов.
+    QVector<int> transferMoveCells;                     // Вектор для хранения дальних ходов.
     Mode modeGame = Mode::none;                         // Режим игры.
     int8_t activePlayer = 0;                            // Текущий игрок.
+    int8_t startPlayer = 0;                             // Игрок, который ходит в загруженной позиции,
+                                                        // 0 - игрок выбирается при запуске игры.
     int currentIndex = 0;                               // Текущий индекс игровой позиции.
     int gameDepth_1 = 0;                                // Глубина рекурсии для ПК 1.
     int gameDepth_2 = 0;                                // Глубина рекурсии для ПК 2.
     QFuture<Move>* future;                              // Переменная передачи хода из второго потока.
     QTimer* timer;                                      // Таймер для задержки вычисления хода компьютера.
     const int timeOutComputerMove = 1000;               // Время для вычисления хода компьютера.
-    const QVector<int8_t>startField = {                 // Состояние игрового поля при старте.
-                               1,0,0,0,2,0,0,0,0,0,     // 0-9
-                               0,0,0,0,0,0,0,0,0,0,     // 10-19
-                               0,0,3,0,0,0,2,0,0,3,     // 20-29
-                               0,0,0,0,1,0,0,0,0,3,     // 30-39
-                               0,0,0,0,0,0,0,0,0,0,     // 40-49
-                               0,0,0,0,0,0,1,0,0,0,     // 50-59
-                               2                        // 60
-                             };
-    const QVector<int8_t>clearField = {                 // Состояние пустого игрового поля при старте.
-                               0,0,0,0,0,0,0,0,0,0,     // 0-9
-                               0,0,0,0,0,0,0,0,0,0,     // 10-19
-                               0,0,3,0,0,0,0,0,0,3,     // 20-29
-                               0,0,0,0,0,0,0,0,0,3,     // 30-39
-                               0,0,0,0,0,0,0,0,0,0,     // 40-49
-                               0,0,0,0,0,0,0,0,0,0,     // 50-59
-                               0                        // 60
-                             };
+    const int pollComputerMove = 50;                    // Период проверки окончания вычисления хода, мс.
+    bool moveAnimating = false;                         // Виджет еще показывает последний ход.
+    bool paused = false;                                // Ход компьютера на паузе.
+    std::atomic<bool> moveStop{false};                  // Признак прерывания хода компьютера.
+    bool turbo = false;                                 // Турбо-режим: компьютеры играют без задержек и
+                                                        // анимации, поле показывает последнюю позицию.
+    QFuture<void>* turboFuture;                         // Поток партии турбо-режима.
+    QTimer* turboTimer;                                 // Таймер отображения партии турбо-режима.
+    const int turboFrameTime = 40;                      // Период отображения позиции турбо-режима, мс.
+    QMutex turboMutex;                                  // Защита последней позиции турбо-режима.
+    Position turboPosition;                             // Последняя позиция партии турбо-режима.
+    int turboPly = 0;                                   // Количество ходов партии турбо-режима.
+    int shownPly = 0;                                   // Количество ходов отображенной позиции.
+    int turboResults[3] = {0, 0, 0};                    // Ничьи и победы компьютеров 1 и 2 турбо-режима.
+    QVector<int8_t>startField;                          // Состояние игрового поля при старте.
+    QVector<int8_t>clearField;                          // Состояние пустого игрового поля при старте.
+    GameRecord record;                                  // Запись текущей партии.
+    GameRecordWriter* recordWriter = nullptr;           // Объект записи партий, nullptr - не записывать.
+    GameDatabase database;                              // База партий для поиска позиций.
+    int computerScore = 0;                              // Оценка последнего хода компьютера.
+    int computerTime = 0;                               // Время выбора последнего хода компьютера, мс.
+    int rootLines = 1;                                  // Количество ходов с точной оценкой (multi-PV).
+    int randomMargin = 0;                               // Запас оценки для случайного выбора хода.
 };
 //..........................................................................................................
 #endif // GAME_H
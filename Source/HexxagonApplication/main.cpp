@@ -1,10 +1,166 @@
 #include "mainwindow.h"
 #include <QApplication>
+#include <QCommandLineParser>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    QCommandLineParser parser;                                  // Параметры геометрии игрового поля.
+    parser.addHelpOption();
+    QCommandLineOption sideOption("side",
+            "Количество ячеек на стороне поля (по умолчанию 5).", "n");
+    QCommandLineOption blockedOption("blocked",
+            "Индексы заблокированных ячеек через запятую или none.", "cells");
+    QCommandLineOption positionOption("position",
+            "Стартовая позиция в текстовой записи, например \"x3o/6/7/4-3/o2-4x/4-3/7/6/x3o x\".", "text");
+    parser.addOption(sideOption);
+    parser.addOption(blockedOption);
+    QCommandLineOption recordOption("record",
+            "Файл, в который дописываются сыгранные партии.", "file");
+    QCommandLineOption weightsOption("weights",
+            "Файл весов оценочной функции, подобранных HexxagonTuner.", "file");
+    parser.addOption(positionOption);
+    parser.addOption(recordOption);
+    QCommandLineOption engine1Option("engine-1",
+            "Алгоритм компьютера 1: minimax (по умолчанию), search или mcts.", "name");
+    QCommandLineOption engine2Option("engine-2",
+            "Алгоритм компьютера 2: minimax (по умолчанию), search или mcts.", "name");
+    QCommandLineOption networkOption("network",
+            "Файл нейросетевой оценочной функции (используется вместо весов), например записанный "
+            "HexxagonTuner --nnue-material.", "file");
+    parser.addOption(weightsOption);
+    QCommandLineOption ntupleOption("ntuple",
+            "Файл оценочной функции из n-кортежей, обученной HexxagonTuner --td-games.", "file");
+    parser.addOption(networkOption);
+    parser.addOption(ntupleOption);
+    parser.addOption(engine1Option);
+    parser.addOption(engine2Option);
+    QCommandLineOption multiPvOption("multipv",
+            "Количество ходов миниМакса с точной оценкой, больше 1 - ходы показываются в окне "
+            "(по умолчанию 1).", "n", "1");
+    QCommandLineOption marginOption("random-margin",
+            "Случайный выбор среди ходов, уступающих лучшему не больше заданной оценки (100 - фишка).",
+            "score", "0");
+    parser.addOption(multiPvOption);
+    parser.addOption(marginOption);
+    QCommandLineOption profilesOption("profiles",
+            "Файл профилей компьютеров (алгоритм, глубина, время, позиции, потоки, таблица, оценка).", "file");
+    QCommandLineOption profile1Option("profile-1", "Профиль компьютера 1 из файла профилей.", "name");
+    QCommandLineOption profile2Option("profile-2", "Профиль компьютера 2 из файла профилей.", "name");
+    parser.addOption(profilesOption);
+    parser.addOption(profile1Option);
+    parser.addOption(profile2Option);
+    QCommandLineOption traceOption("trace",
+            "Файл трассы в формате Chrome Trace Event (сборка с CONFIG+=hextrace).", "file");
+    parser.addOption(traceOption);
+    QCommandLineOption databaseOption("database",
+            "Файл партий для поиска текущей позиции; индекс <файл>.idx строится при необходимости.", "file");
+    parser.addOption(databaseOption);
+    parser.process(a);
     MainWindow w;
+    if (parser.isSet(sideOption) || parser.isSet(blockedOption)){
+        int side = parser.isSet(sideOption) ? parser.value(sideOption).toInt()
+                                            : HexBoard::standardSide;
+        if (side < 2 || side > HexBoard::maxSide()){            // Размер поля ограничен размером Bitboard,
+            qDebug() << "Ошибка: сторона поля должна быть от 2 до" // для больших полей нужна сборка
+                     << HexBoard::maxSide()                     // с большим HEXBOARD_WORDS.
+                     << "(HEXBOARD_WORDS =" << HEXBOARD_WORDS << ")";
+            return -1;
+        }
+        HexBoard board(side);                                   // Стандартная раскладка блоков.
+        if (parser.isSet(blockedOption)){
+            std::vector<int> blocked;
+            for (QString const& cell : parser.value(blockedOption).split(',', QString::SkipEmptyParts)){
+                if (cell != "none") blocked.push_back(cell.toInt());
+            }
+            board = HexBoard(side, blocked);
+        }
+        w.setBoard(board);
+    }
+    if (parser.isSet(positionOption)                            // Позиция задает и геометрию поля.
+            && !w.loadPosition(parser.value(positionOption))){
+        qDebug() << "Ошибка: неверная запись позиции" << parser.value(positionOption);
+        return -1;
+    }
+    if (parser.isSet(weightsOption) && !w.loadEvaluation(parser.value(weightsOption))){
+        qDebug() << "Ошибка: неверный файл весов" << parser.value(weightsOption);
+        return -1;
+    }
+    if (parser.isSet(networkOption) && !w.loadNetwork(parser.value(networkOption))){
+        qDebug() << "Ошибка: неверный файл сети" << parser.value(networkOption);
+        return -1;
+    }
+    if (parser.isSet(ntupleOption) && !w.loadNTuple(parser.value(ntupleOption))){
+        qDebug() << "Ошибка: неверный файл n-кортежей" << parser.value(ntupleOption);
+        return -1;
+    }
+    QCommandLineOption const* engineOptions[2] = {&engine1Option, &engine2Option};
+    for (int player = 1; player <= 2; player++){                // Алгоритмы хода компьютеров.
+        QString name = parser.value(*engineOptions[player - 1]);
+        if (name == "mcts"){
+            w.setEngine(player, Game::Engine::mcts);
+        } else
+        if (name == "search"){
+            w.setEngine(player, Game::Engine::search);
+        } else
+        if (!name.isEmpty() && name != "minimax"){
+            qDebug() << "Ошибка: неизвестный алгоритм" << name;
+            return -1;
+        }
+    }
+    w.setRootSearch(parser.value(multiPvOption).toInt(), parser.value(marginOption).toInt());
+    if (parser.isSet(profilesOption)){                          // Профили компьютеров.
+        QString error;
+        if (!w.loadProfiles(parser.value(profilesOption), error)){
+            qDebug() << "Ошибка: неверный файл профилей:" << error;
+            return -1;
+        }
+    }
+    QCommandLineOption const* profileOptions[2] = {&profile1Option, &profile2Option};
+    for (int player = 1; player <= 2; player++){
+        if (parser.isSet(*profileOptions[player - 1])
+                && !w.selectProfile(player, parser.value(*profileOptions[player - 1]))){
+            qDebug() << "Ошибка: нет профиля" << parser.value(*profileOptions[player - 1]);
+            return -1;
+        }
+    }
+    if (parser.isSet(databaseOption)){                          // База партий.
+        QString error;
+        if (!w.loadDatabase(parser.value(databaseOption), error)){
+            qDebug() << "Ошибка: база партий:" << error;
+            return -1;
+        }
+    }
+    GameRecordWriter* recordWriter = nullptr;                   // Запись сыгранных партий.
+    if (parser.isSet(recordOption)){
+        recordWriter = new GameRecordWriter(parser.value(recordOption).toStdString());
+        if (!recordWriter->isOpen()){
+            qDebug() << "Ошибка: не удалось открыть файл партий" << parser.value(recordOption);
+            delete recordWriter;
+            return -1;
+        }
+        w.setRecordWriter(recordWriter);
+    }
+    if (parser.isSet(traceOption)){                             // Трассировка до выхода из программы.
+        if (!Trace::isEnabled()){
+            qDebug() << "Ошибка: программа собрана без трассировки (CONFIG+=hextrace)";
+            return -1;
+        }
+        Trace::start();
+    }
     w.show();
-    return a.exec();
+    int result = a.exec();
+    if (parser.isSet(traceOption)){
+        Trace::stop();
+        if (!Trace::save(parser.value(traceOption).toStdString())){
+            qDebug() << "Ошибка: не удалось записать трассу" << parser.value(traceOption);
+        }
+    }
+    w.setRecordWriter(nullptr);
+    if (recordWriter && !recordWriter->flush()){                // Запись оставшихся партий на диск.
+        qDebug() << "Ошибка:" << QString::fromStdString(recordWriter->error());
+        result = result ? result : -1;
+    }
+    delete recordWriter;
+    return result;
 }
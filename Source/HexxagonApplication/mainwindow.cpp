@@ -21,14 +21,16 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
             game, SLOT(makeGame(int)));                         // выбранной пользователем.
     connect(game, SIGNAL(transmitField(QVector<int8_t>&)),      // Передача состояния игрового поля
             ui->widget, SLOT(setField(QVector<int8_t>&)));      // виджету.
-    connect(game, SIGNAL(transmitMoveCells(QVector<int8_t>&,    // Передача виджету индексов ячеек,
-                                           QVector<int8_t>&)),  // доступных для выполнения хода.
-            ui->widget, SLOT(setMoveCells(QVector<int8_t>&,
-                                          QVector<int8_t>&)));
+    connect(game, SIGNAL(transmitMoveCells(QVector<int>&,       // Передача виджету индексов ячеек,
+                                           QVector<int>&)),     // доступных для выполнения хода.
+            ui->widget, SLOT(setMoveCells(QVector<int>&,
+                                          QVector<int>&)));
     connect(game, SIGNAL(clearAvailableMove()),                 // Передача сигнала очистки выделения
             ui->widget, SLOT(clearAvailableMove()));            // доступных для хода ячеек.
     connect(game, SIGNAL(makeMove(int,int,int8_t,bool)),
             ui->widget, SLOT(makeMove(int,int,int8_t,bool)));
+    connect(ui->widget, SIGNAL(animationFinished()),            // Ход компьютера, найденный во время
+            game, SLOT(moveAnimated()));                        // анимации, выполняется сразу после нее.
 //.................. Объединенные сигналы и слоты класса игры и главного окна приложения .....................
     connect(game, SIGNAL(transmitScore(int,int)),
             this, SLOT(updateScore(int,int)));
@@ -36,22 +38,161 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
             this, SLOT(updatePlayer(int8_t)));
     connect(game, SIGNAL(gameOver()),
             this, SLOT(on_buttonStop_clicked()));
+    connect(game, SIGNAL(analysisInfo(int,int,QString)),        // Результаты анализа приходят из потока
+            this, SLOT(updateAnalysis(int,int,QString)));       // поиска через очередь событий.
+    connect(game, SIGNAL(gameResult(QString)),                  // Результаты партий турбо-режима не
+            ui->labelTurbo, SLOT(setText(QString)));            // останавливают игру.
+    connect(game, SIGNAL(rootMovesInfo(QString)),               // Лучшие ходы миниМакса приходят из
+            ui->labelRootMoves, SLOT(setText(QString)));        // потока хода через очередь событий.
+    connect(game, SIGNAL(transmitField(QVector<int8_t>&)),      // Поиск позиции в базе партий
+            this, SLOT(updateDatabase()));                      // после каждого изменения поля
+    connect(game, SIGNAL(transmitPlayer(int8_t)),               // и смены игрока.
+            this, SLOT(updateDatabase()));
 //............................................................................................................
     ui->labelIconPlayer->setFixedWidth(40);                     // Установка размеров иконки
     ui->labelIconPlayer->setFixedHeight(40);                    // отображения игрока.
-    updater = new QTimer(this);                                 // Создание таймера обновления.
-    updater->start(30);                                         // Таймаут обновления 30 mS.
-    connect(updater, SIGNAL(timeout()), SLOT(update()));        // Связь таймера с методом обновления.
+    ui->labelDatabase->setVisible(false);                       // Видна после открытия базы партий.
+    ui->labelTurbo->setVisible(false);                          // Видна в турбо-режиме.
+    ui->labelRootMoves->setVisible(false);                      // Видна при выводе нескольких ходов.
 }
 /**
  * @brief MainWindow::~MainWindow Деструктор класса главного окна.
  */
 MainWindow::~MainWindow(){
-    delete updater;
     delete painter;
     delete game;
     delete ui;
 }
+/**
+ * @brief MainWindow::loadEvaluation Метод загрузки весов оценочной функции компьютера.
+ * @param fileName Имя файла весов.
+ * @return true - веса загружены.
+ */
+bool MainWindow::loadEvaluation(QString const& fileName){
+    return game->loadEvaluation(fileName);
+}
+/**
+ * @brief MainWindow::loadNetwork Метод загрузки нейросетевой оценочной функции компьютера.
+ * @param fileName Имя файла сети.
+ * @return true - сеть загружена.
+ */
+bool MainWindow::loadNetwork(QString const& fileName){
+    return game->loadNetwork(fileName);
+}
+/**
+ * @brief MainWindow::loadDatabase Метод открытия базы партий для поиска текущей позиции.
+ * @param fileName Имя файла партий.
+ * @param [out] error Описание ошибки.
+ * @return true - база открыта.
+ */
+bool MainWindow::loadDatabase(QString const& fileName, QString& error){
+    if (!game->loadDatabase(fileName, error)){
+        return false;
+    }
+    ui->labelDatabase->setVisible(true);
+    updateDatabase();
+    return true;
+}
+/**
+ * @brief MainWindow::loadNTuple Метод загрузки оценочной функции компьютера из n-кортежей.
+ * @param fileName Имя файла таблиц.
+ * @return true - таблицы загружены.
+ */
+bool MainWindow::loadNTuple(QString const& fileName){
+    return game->loadNTuple(fileName);
+}
+/**
+ * @brief MainWindow::loadPosition Метод загрузки стартовой позиции из текстовой записи вместе с геометрией
+ * игрового поля.
+ * @param text Текстовая запись позиции.
+ * @return true - позиция загружена, false - запись ошибочна.
+ */
+bool MainWindow::loadPosition(QString const& text){
+    on_buttonStop_clicked();                                    // Позиция загружается только без игры.
+    if (!game->loadPosition(text)){
+        return false;
+    }
+    ui->widget->setBoard(game->getBoard());                     // Виджет получает новую геометрию
+    QVector<int8_t> field = game->getField();                   // и загруженную позицию.
+    ui->widget->setField(field);
+    return true;
+}
+/**
+ * @brief MainWindow::setBoard Метод установки геометрии игрового поля для игры и графического виджета.
+ * @param board Геометрия игрового поля.
+ */
+void MainWindow::setBoard(HexBoard const& board){
+    on_buttonStop_clicked();                                    // Геометрия меняется только без игры.
+    game->setBoard(board);
+    ui->widget->setBoard(board);
+}
+/**
+ * @brief MainWindow::setEngine Метод выбора алгоритма хода компьютера.
+ * @param player Номер компьютера (1 или 2).
+ * @param engine Алгоритм выбора хода.
+ */
+void MainWindow::setEngine(int player, Game::Engine engine){
+    if (player == 1 || player == 2){
+        defaultProfiles[player - 1].algorithm = engine;
+    }
+    game->setEngine(player, engine);
+}
+/**
+ * @brief MainWindow::loadProfiles Метод загрузки профилей компьютеров. Профили добавляются в списки
+ * панелей уровня, первый элемент списка - уровень, выбранный радиокнопками.
+ * @param fileName Имя файла профилей.
+ * @param [out] error Описание ошибки.
+ * @return true - профили загружены.
+ */
+bool MainWindow::loadProfiles(QString const& fileName, QString& error){
+    std::string message;
+    if (!EngineProfiles::load(fileName.toStdString(), profiles, message)){
+        error = QString::fromStdString(message);
+        return false;
+    }
+    QComboBox* combos[2] = {ui->comboProfile_1, ui->comboProfile_2};
+    for (QComboBox* combo : combos){
+        combo->clear();
+        combo->addItem("По уровню");
+        for (EngineProfile const& profile : profiles){
+            combo->addItem(QString::fromStdString(profile.name));
+        }
+        combo->setVisible(!profiles.empty());
+    }
+    return true;
+}
+/**
+ * @brief MainWindow::selectProfile Метод выбора профиля компьютера в списке.
+ * @param player Номер компьютера (1 или 2).
+ * @param name Название профиля.
+ * @return true - профиль найден.
+ */
+bool MainWindow::selectProfile(int player, QString const& name){
+    QComboBox* combo = player == 1 ? ui->comboProfile_1 : ui->comboProfile_2;
+    int index = combo->findText(name);
+    if ((player != 1 && player != 2) || index <= 0){
+        return false;
+    }
+    combo->setCurrentIndex(index);
+    return true;
+}
+/**
+ * @brief MainWindow::setRecordWriter Метод установки объекта записи сыгранных партий.
+ * @param writer Объект записи партий, nullptr - партии не записываются.
+ */
+void MainWindow::setRecordWriter(GameRecordWriter* writer){
+    game->setRecordWriter(writer);
+}
+/**
+ * @brief MainWindow::setRootSearch Метод настройки выбора хода миниМаксом. Если ходов с точной оценкой
+ * больше одного, они показываются в окне после каждого хода компьютера.
+ * @param lines Количество ходов с точной оценкой.
+ * @param margin Запас оценки для случайного выбора хода.
+ */
+void MainWindow::setRootSearch(int lines, int margin){
+    game->setRootSearch(lines, margin);
+    ui->labelRootMoves->setVisible(lines > 1);
+}
 /**
  * @brief MainWindow::on_buttonStart_clicked Обработчик нажатия кнопки запуска игры.
  */
@@ -91,12 +232,23 @@ void MainWindow::on_buttonStart_clicked(){
         gameMode = Game::Mode::pcVSpc;
         player = Game::computerPlayer_1;
     }
-    game->start(player, gameMode, gameDepth_1, gameDepth_2);    // Запуск игры с вычисленными параметрами.
-    ui->groupMode->setDisabled(true);                           // перевод в неактивное состояние элементов
+    QComboBox* combos[2] = {ui->comboProfile_1, ui->comboProfile_2};
+    for (int i = 0; i < 2; i++){                                // Профили компьютеров: выбранный в списке
+        int index = combos[i]->currentIndex();                  // или заданный параметрами запуска.
+        game->setProfile(i + 1, index > 0 ? profiles[size_t(index - 1)] : defaultProfiles[i]);
+    }
+    bool turbo = gameMode == Game::Mode::pcVSpc && ui->checkTurbo->isChecked();
+    game->setTurbo(turbo);                                      // Счет партий турбо-режима виден до
+    ui->labelTurbo->clear();                                    // следующего запуска.
+    ui->labelRootMoves->clear();
+    ui->labelTurbo->setVisible(turbo);
+    ui->groupMode->setDisabled(true);                           // Перевод в неактивное состояние элементов
     ui->groupDepth_1->setDisabled(true);                        // управления главного окна программы на
     ui->groupDepth_2->setDisabled(true);                        // время игры.
     ui->buttonStart->setDisabled(true);
     ui->buttonStop->setEnabled(true);
+    game->start(player, gameMode, gameDepth_1, gameDepth_2);    // Запуск игры после блокировки: партия без
+                                                                // ходов сразу возвращает элементы gameOver.
 }
 /**
  * @brief MainWindow::on_buttonStop_clicked Обработчик нажатия кнопки останова игры.
@@ -120,6 +272,16 @@ void MainWindow::on_buttonStop_clicked(){
     ui->lineEditScore_1->clear();                               // и счета.
     ui->lineEditScore_2->clear();
     game->gameReset();                                          // Остановка игры.
+    updateIconPlayer();                                         // Иконка игрока больше не отображается.
+}
+/**
+ * @brief MainWindow::on_checkAnalysis_toggled Обработчик флажка режима анализа: движок ищет отображаемую
+ * позицию, пока флажок установлен.
+ * @param checked Если флажок установлен, параметр = true.
+ */
+void MainWindow::on_checkAnalysis_toggled(bool checked){
+    ui->labelAnalysis->clear();
+    game->setAnalysis(checked);
 }
 /**
  * @brief MainWindow::on_radioHumanVsHuman_toggled Обработчик переключения радиокнопки "Человек-Человек".
@@ -129,6 +291,7 @@ void MainWindow::on_radioHumanVsHuman_toggled(bool checked){
     if (checked==true){
         ui->groupDepth_1->setDisabled(true);
         ui->groupDepth_2->setDisabled(true);
+        ui->checkTurbo->setDisabled(true);
         ui->labelScore_1->setText("Игрок 1:");
         ui->labelScore_2->setText("Игрок 2:");
     }
@@ -141,6 +304,7 @@ void MainWindow::on_radioHumanVsComputer_toggled(bool checked){
     if (checked==true){
         ui->groupDepth_1->setEnabled(true);
         ui->groupDepth_2->setDisabled(true);
+        ui->checkTurbo->setDisabled(true);
         ui->labelScore_1->setText("Игрок:");
         ui->labelScore_2->setText("Компьютер:");
     }
@@ -153,6 +317,7 @@ void MainWindow::on_radioComputerVsComputer_toggled(bool checked){
     if (checked==true){
         ui->groupDepth_1->setEnabled(true);
         ui->groupDepth_2->setEnabled(true);
+        ui->checkTurbo->setEnabled(true);                       // Турбо-режим только для игры компьютеров.
         ui->labelScore_1->setText("Компьютер 1:");
         ui->labelScore_2->setText("Компьютер 2:");
     }
@@ -166,6 +331,47 @@ void MainWindow::updateScore(int score_1, int score_2){
     ui->lineEditScore_1->setText(QString::number(score_1));
     ui->lineEditScore_2->setText(QString::number(score_2));
 }
+/**
+ * @brief MainWindow::updateAnalysis Метод отображения результата итерации анализа.
+ * @param depth Глубина итерации.
+ * @param score Оценка для игрока, который ходит.
+ * @param line Главный вариант.
+ */
+void MainWindow::updateAnalysis(int depth, int score, QString line){
+    if (!game->isAnalysis()){                                   // Результат остановленного анализа.
+        return;
+    }
+    QString value;
+    if (SearchEngine::isWin(score)){                            // Конец партии найден поиском.
+        value = score > 0 ? "выигрыш" : "проигрыш";
+    } else {
+        value = QString::number(double(score) / Evaluation::scale, 'f', 2);
+        if (score > 0) value.prepend('+');
+    }
+    ui->labelAnalysis->setText(QString("Глубина %1, оценка %2\n%3").arg(depth).arg(value)
+                               .arg(line.isEmpty() ? "нет ходов" : line));
+}
+/**
+ * @brief MainWindow::updateDatabase Метод отображения результатов партий базы, прошедших через текущую
+ * позицию, и первых из этих партий.
+ */
+void MainWindow::updateDatabase(){
+    if (ui->labelDatabase->isHidden()){                         // База не открыта.
+        return;
+    }
+    PositionStats stats = game->queryDatabase(databaseHits);
+    if (stats.games == 0){
+        ui->labelDatabase->setText("Позиции нет в базе партий");
+        return;
+    }
+    QStringList games;
+    for (DatabaseHit const& hit : stats.hits){
+        games << QString("%1 (ход %2)").arg(hit.game + 1).arg(hit.ply + 1);
+    }
+    ui->labelDatabase->setText(QString("Партий в базе: %1, побед 1: %2, побед 2: %3, ничьих: %4\nПартии: %5")
+                               .arg(stats.games).arg(stats.wins[0]).arg(stats.wins[1]).arg(stats.draws)
+                               .arg(games.join(", ")));
+}
 /**
  * @brief MainWindow::updatePlayer Метод отображения активного игрока.
  * @param player Игрок, чей ход выполняется.
@@ -197,6 +403,14 @@ void MainWindow::updatePlayer(int8_t player){
         }
     }
     ui->lineEditPlayer->setText(mess);
+    updateIconPlayer();                                         // Перерисовка иконки нового игрока.
+}
+/**
+ * @brief MainWindow::updateIconPlayer Метод перерисовки иконки активного игрока. Окно перерисовывается
+ * только при смене игрока, а не по таймеру.
+ */
+void MainWindow::updateIconPlayer(){
+    update(QRect(ui->labelIconPlayer->pos(), ui->labelIconPlayer->size()));
 }
 /**
  * @brief MainWindow::mainWindowResize Метод установки размера окна.
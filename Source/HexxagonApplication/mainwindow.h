@@ -23,20 +23,39 @@ class MainWindow : public QMainWindow{
 public:
     explicit MainWindow(QWidget *parent = 0);                   // Конструктор класса главного окна.
     ~MainWindow();                                              // Деструктор класса главного окна.
+    bool loadDatabase(QString const& fileName,
+                      QString& error);                          // Метод открытия базы партий.
+    bool loadEvaluation(QString const& fileName);               // Метод загрузки весов оценочной функции.
+    bool loadNetwork(QString const& fileName);                  // Метод загрузки нейросетевой оценки.
+    bool loadNTuple(QString const& fileName);                   // Метод загрузки оценки из n-кортежей.
+    bool loadPosition(QString const& text);                     // Метод загрузки позиции из текстовой записи.
+    bool loadProfiles(QString const& fileName,
+                      QString& error);                          // Метод загрузки профилей компьютеров.
+    bool selectProfile(int player, QString const& name);        // Метод выбора профиля компьютера.
+    void setBoard(HexBoard const& board);                       // Метод установки геометрии игрового поля.
+    void setEngine(int player, Game::Engine engine);            // Метод выбора алгоритма хода компьютера.
+    void setRecordWriter(GameRecordWriter* writer);             // Метод установки объекта записи партий.
+    void setRootSearch(int lines, int margin);                  // Метод настройки выбора хода миниМаксом.
 private slots:
     void on_buttonStart_clicked();                              // Обработчик нажатия кнопки запуска игры.
     void on_buttonStop_clicked();                               // Обработчик нажатия кнопки останова игры.
+    void on_checkAnalysis_toggled(bool checked);                // Обработчик флажка режима анализа.
     void mainWindowResize();                                    // Метод установки размера окна.
     void updateScore(int score_1, int score_2);                 // Метод установки счета в окошки отображения.
+    void updateAnalysis(int depth, int score, QString line);    // Метод отображения результата анализа.
+    void updateDatabase();                                      // Метод отображения партий из базы.
     void updatePlayer(int8_t player);                           // Метод отображения активного игрока.
     void on_radioHumanVsHuman_toggled(bool checked);            // Обработчик радиокнопки "Человек-Человек".
     void on_radioHumanVsComputer_toggled(bool checked);         // Обработчик радиокнопки "Человек-Компьютер".
     void on_radioComputerVsComputer_toggled(bool checked);      // Обработчик радиокнопки "Компьютер-Компьютер".
     void paintEvent(QPaintEvent* event);
+    void updateIconPlayer();                                    // Метод перерисовки иконки активного игрока.
 private:
     Ui::MainWindow *ui;                                         // указатель на главное окно.
     Game* game;                                                 // Указатель на класс игры.
     QPainter* painter;                                          // Указатель на класс рисовальщика.
-    QTimer* updater;                                            // Указатель на таймер обновления окна.
+    std::vector<EngineProfile> profiles;                        // Профили из файла профилей.
+    EngineProfile defaultProfiles[2];                           // Профили компьютеров без выбора в списке.
+    const int databaseHits = 5;                                 // Количество партий базы в подписи.
 };
 #endif // MAINWINDOW_H
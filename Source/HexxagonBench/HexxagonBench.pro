@@ -0,0 +1,33 @@
+#-------------------------------------------------
+#
+# Измерение времени отрисовки игрового поля HexWidget без окна.
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = HexxagonBench
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+# Счетчики выделений памяти на кадр считаются только в сборке с трассировкой: qmake CONFIG+=hextrace.
+# Без нее столбцы allocs и bytes отчета - прочерки, а время кадра не включает учет выделений.
+
+include(../HexxagonApplication/engine.pri)
+
+SOURCES += \
+    ../HexxagonApplication/boardrenderer.cpp \
+    ../HexxagonApplication/chipanimator.cpp \
+    ../HexxagonApplication/hexwidget.cpp \
+    main.cpp
+
+HEADERS  += \
+    ../HexxagonApplication/boardrenderer.h \
+    ../HexxagonApplication/chipanimator.h \
+    ../HexxagonApplication/hexwidget.h
+
+FORMS    += \
+    ../HexxagonApplication/hexwidget.ui
@@ -0,0 +1,195 @@
+/**
+* @file main.cpp
+* @author Oleg2008e28
+* @date 24.10.2026 09:12:37
+* @brief Программа HexxagonBench: время отрисовки кадра игрового поля HexWidget без окна для нескольких
+* размеров виджета, состояний поля и с анимацией хода. Выделения памяти на кадр считаются в сборке
+* с CONFIG+=hextrace.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexwidget.h"
+#include "hextrace.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QImage>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @brief The BenchState struct Состояние поля, на котором измеряется отрисовка, и ход для анимации.
+ */
+struct BenchState {
+    QString name;                                               // Название состояния.
+    QVector<int8_t> field;                                      // Состояние поля.
+    QVector<int> addCells;                                      // Подсказки ближних ходов.
+    QVector<int> stepCells;                                     // Подсказки дальних ходов.
+    Move move;                                                  // Ход с наибольшим захватом.
+    int8_t player;                                              // Игрок, который ходит.
+};
+
+/**
+ * @brief makeState Функция строит состояние поля после случайных ходов со стартовой позиции.
+ * @param board Геометрия поля.
+ * @param name Название состояния.
+ * @param plies Количество случайных ходов.
+ * @param hints Признак подсказок ходов одной фишки, как после ее выбора мышью.
+ * @return Состояние поля.
+ */
+static BenchState makeState(HexBoard const& board, QString const& name, int plies, bool hints){
+    std::mt19937 random(uint32_t(plies) + 1);                   // Состояния одинаковы при каждом запуске.
+    int8_t cells[HexBoard::maxCells];
+    board.fillStartField(cells);
+    Position position = board.positionFromField(cells, 1);
+    MoveList moves;
+    for (int ply = 0; ply < plies && board.generateMoves(position, moves) > 0; ply++){
+        Position next = position;
+        board.doMove(next, moves[int(random() % uint32_t(moves.size))]);
+        if (!board.hasMoves(next, next.player)){                // Партия не заканчивается.
+            break;
+        }
+        position = next;
+    }
+    BenchState state;
+    state.name = name;
+    state.field.resize(board.cellCount());
+    board.fieldFromPosition(position, state.field.data());
+    state.player = position.player;
+    board.generateMoves(position, moves);
+    int bestFlips = -1;
+    for (Move const& move : moves){                             // Анимация с наибольшим числом переворотов.
+        Position child = position;
+        int flips = board.doMove(child, move).count();
+        if (flips > bestFlips){
+            bestFlips = flips;
+            state.move = move;
+        }
+    }
+    if (hints){
+        int chip = state.move.beginPostion;
+        for (int cell : board.nearCells(chip)){
+            if (state.field[cell] == 0) state.addCells.push_back(cell);
+        }
+        for (int cell : board.farCells(chip)){
+            if (state.field[cell] == 0) state.stepCells.push_back(cell);
+        }
+    }
+    return state;
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")){        // Отрисовка без окна и без дисплея.
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication a(argc, argv);
+    QCommandLineParser parser;                                  // Параметры измерения.
+    parser.setApplicationDescription("Время отрисовки кадра игрового поля HexWidget без окна: среднее, "
+                                     "99-й процентиль и выделения памяти на кадр.");
+    parser.addHelpOption();
+    QCommandLineOption framesOption("frames", "Количество измеряемых кадров каждого случая.", "n", "300");
+    QCommandLineOption sizesOption("sizes", "Размеры виджета через запятую.", "list",
+                                   "480x360,800x600,1280x960,1920x1080,2560x1440");
+    QCommandLineOption sideOption("side", "Количество ячеек на стороне поля.", "n",
+                                  QString::number(HexBoard::standardSide));
+    parser.addOption(framesOption);
+    parser.addOption(sizesOption);
+    parser.addOption(sideOption);
+    parser.process(a);
+    int frames = std::max(1, parser.value(framesOption).toInt());
+    int side = parser.value(sideOption).toInt();
+    if (side < 2 || side > HexBoard::maxSide()){
+        qDebug() << "Ошибка: сторона поля должна быть от 2 до" << HexBoard::maxSide();
+        return -1;
+    }
+    QVector<QSize> sizes;
+    for (QString const& text : parser.value(sizesOption).split(',', QString::SkipEmptyParts)){
+        QStringList parts = text.split('x');
+        QSize size(parts.value(0).toInt(), parts.value(1).toInt());
+        if (parts.size() != 2 || size.width() < 16 || size.height() < 16){
+            qDebug() << "Ошибка: неверный размер" << text;
+            return -1;
+        }
+        sizes.push_back(size);
+    }
+    HexBoard board(side);
+    std::vector<BenchState> states;
+    states.push_back(makeState(board, "start", 0, false));
+    states.push_back(makeState(board, "middle", 30, false));
+    states.push_back(makeState(board, "hints", 30, true));
+    states.push_back(makeState(board, "end", 1000, false));
+    const int warmupFrames = 10;                                // Кадры до измерения: кэши и шрифты.
+    const int frameStep = 16;                                   // Шаг времени анимации между кадрами, мс.
+    std::cout << QString("%1 %2 %3 %4 %5 %6 %7")                 // Отчет - в стандартный вывод,
+                 .arg("size", -10).arg("state", -7).arg("anim", -5) // ошибки - в qDebug.
+                 .arg("mean, us", 9).arg("p99, us", 9).arg("allocs", 7).arg("bytes", 9)
+                 .toStdString() << std::endl;
+    for (QSize const& size : sizes){
+        HexWidget widget;
+        widget.setBoard(board);
+        widget.resize(size);
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        for (BenchState const& state : states){
+            for (int animated = 0; animated < 2; animated++){
+                QVector<int8_t> field = state.field;
+                QVector<int> addCells = state.addCells;
+                QVector<int> stepCells = state.stepCells;
+                auto restart = [&](){                           // Поле до хода и начало анимации.
+                    widget.setField(field);
+                    widget.setMoveCells(addCells, stepCells);
+                    if (animated){
+                        widget.makeMove(state.move.beginPostion, state.move.newPostion, state.player,
+                                        state.move.clearBeginPostion);
+                    }
+                };
+                restart();
+                qint64 duration = std::max<qint64>(frameStep, widget.animationDuration());
+                std::vector<qint64> times;
+                times.reserve(size_t(frames));
+                uint64_t allocations = 0;
+                uint64_t bytes = 0;
+                QElapsedTimer clock;
+                for (int frame = -warmupFrames; frame < frames; frame++){
+                    if (animated){                              // Кадры проходят всю анимацию хода,
+                        qint64 time = qint64(frame + warmupFrames) * frameStep % duration;
+                        if (time < frameStep && frame > -warmupFrames){
+                            restart();                          // затем ход повторяется.
+                        }
+                        widget.setAnimationTime(time);
+                    }
+                    uint64_t allocationsBegin = Trace::threadAllocations();
+                    uint64_t bytesBegin = Trace::threadBytes();
+                    clock.start();
+                    widget.render(&image);
+                    qint64 elapsed = clock.nsecsElapsed();
+                    if (frame >= 0){
+                        times.push_back(elapsed);
+                        allocations += Trace::threadAllocations() - allocationsBegin;
+                        bytes += Trace::threadBytes() - bytesBegin;
+                    }
+                }
+                std::sort(times.begin(), times.end());
+                double mean = 0.0;
+                for (qint64 time : times){
+                    mean += time;
+                }
+                mean /= times.size() * 1000.0;
+                double p99 = times[size_t(std::ceil(times.size() * 0.99)) - 1] / 1000.0;
+                std::cout << QString("%1 %2 %3 %4 %5 %6 %7")
+                             .arg(QString("%1x%2").arg(size.width()).arg(size.height()), -10)
+                             .arg(state.name, -7).arg(animated ? "yes" : "no", -5)
+                             .arg(mean, 9, 'f', 1).arg(p99, 9, 'f', 1)
+                             .arg(Trace::isEnabled() ? QString::number(double(allocations) / frames, 'f', 1)
+                                                     : QString("-"), 7)
+                             .arg(Trace::isEnabled() ? QString::number(double(bytes) / frames, 'f', 0)
+                                                     : QString("-"), 9)
+                             .toStdString() << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Разделяемая библиотека с C-интерфейсом для пакетной генерации ходов, оценки и поиска.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+
+TARGET = hexxagon
+TEMPLATE = lib
+CONFIG += shared hide_symbols
+VERSION = 1.0.0
+DEFINES += HEXXAGON_LIBRARY
+
+include(../HexxagonApplication/engine.pri)
+
+SOURCES += \
+    hexxagonapi.cpp
+
+HEADERS  += \
+    hexxagonapi.h
@@ -0,0 +1,361 @@
+﻿/**
+* @file hexxagonapi.cpp
+* @author Oleg2008e28
+* @date 20.10.2026 01:02:48
+* @brief Файл реализации C-интерфейса библиотеки HexxagonLibrary над ядром игры: HexBoard, Evaluation,
+* Notation и SearchEngine.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "hexxagonapi.h"
+#include "hexboard.h"
+#include "hexevaluation.h"
+#include "hexnotation.h"
+#include "hexsearch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+/**
+ * @brief The hex_engine struct Движок библиотеки. Исключения C++ не выходят за пределы интерфейса.
+ */
+struct hex_engine {
+    explicit hex_engine(HexBoard const& board) : board(board){}
+    HexBoard board;                                     // Геометрия игрового поля.
+    Evaluation evaluation;                              // Веса линейной оценки.
+    bool material = false;                              // Оценка разностью фишек вместо весов.
+    int threads = 1;                                    // Количество потоков пакетных функций.
+    int tableSizeMb = 16;                               // Размер таблицы транспозиций потока, МБ.
+    std::vector<std::unique_ptr<SearchEngine>> searches;// Поиски потоков, создаются при первом поиске.
+};
+//............................................................................................................
+//.......................................... Вспомогательные функции ........................................
+//............................................................................................................
+/**
+ * @brief threadCount Функция вычисляет количество потоков.
+ * @param requested Заданное количество, 0 и меньше - все ядра.
+ * @return Количество потоков, не меньше 1.
+ */
+static int threadCount(int requested){
+    return requested > 0 ? requested : std::max(1, int(std::thread::hardware_concurrency()));
+}
+/**
+ * @brief parallelFor Функция выполняет задачу для индексов 0..count-1 в потоках движка. Индексы
+ * выдаются порциями по chunk, вызывающий поток работает как поток 0. Если поток не создан, его работу
+ * выполняют остальные.
+ * @param engine Движок.
+ * @param count Количество индексов.
+ * @param chunk Размер порции.
+ * @param task Задача: номер потока и индекс.
+ */
+static void parallelFor(hex_engine const* engine, size_t count, size_t chunk,
+                        std::function<void(int, size_t)> const& task){
+    size_t chunks = (count + chunk - 1) / chunk;
+    int workers = int(std::min<size_t>(size_t(engine->threads), chunks));
+    std::atomic<size_t> next{0};
+    auto worker = [&](int thread){
+        for (size_t begin; (begin = next.fetch_add(chunk)) < count; ){
+            size_t end = std::min(count, begin + chunk);
+            for (size_t i = begin; i < end; i++){
+                task(thread, i);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < workers; t++){
+        try {
+            pool.emplace_back(worker, t);
+        } catch (...){                                      // Поток не создан.
+            break;
+        }
+    }
+    worker(0);
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+}
+/**
+ * @brief evaluatePosition Функция оценивает позицию оценочной функцией движка.
+ * @param engine Движок.
+ * @param position Позиция.
+ * @return Оценка для игрока, который ходит.
+ */
+static int evaluatePosition(hex_engine const* engine, Position const& position){
+    if (engine->material){
+        int own = position.player - 1;
+        return (position.chips[own].count() - position.chips[1 - own].count()) * Evaluation::scale;
+    }
+    return engine->evaluation.evaluate(engine->board, position, position.player);
+}
+/**
+ * @brief legalMove Функция проверяет ход игрока, который ходит, и переводит его во внутреннюю запись.
+ * Ближний ход можно задать из любой соседней фишки игрока.
+ * @param board Геометрия поля.
+ * @param position Позиция.
+ * @param from Ход интерфейса.
+ * @param [out] move Ход.
+ * @return true - ход возможен.
+ */
+static bool legalMove(HexBoard const& board, Position const& position, hex_move const& from, Move& move){
+    if (from.from < 0 || from.from >= board.cellCount() || from.to < 0 || from.to >= board.cellCount()
+            || !position.chips[position.player - 1].test(from.from) || !board.emptyCells(position).test(from.to)){
+        return false;
+    }
+    Bitboard const& targets = from.jump ? board.farMask(from.from) : board.nearMask(from.from);
+    if (!targets.test(from.to)){
+        return false;
+    }
+    move = Move{from.from, from.to, from.jump != 0};
+    return true;
+}
+/**
+ * @brief apiMove Функция переводит ход в запись интерфейса.
+ * @param move Ход.
+ * @return Ход интерфейса.
+ */
+static hex_move apiMove(Move const& move){
+    return hex_move{move.beginPostion, move.newPostion, move.clearBeginPostion ? 1 : 0};
+}
+//............................................................................................................
+//.......................................... Движок ..........................................................
+//............................................................................................................
+int hex_api_version(void){
+    return HEX_API_VERSION;
+}
+hex_engine* hex_engine_create(int side, int const* blocked, int blocked_count, int threads){
+    if (side < 2 || side > HexBoard::maxSide() || (blocked && blocked_count < 0)){
+        return nullptr;
+    }
+    try {
+        HexBoard board(side);                               // Стандартная раскладка блоков.
+        if (blocked){
+            std::vector<int> cells(blocked, blocked + blocked_count);
+            for (int cell : cells){
+                if (cell < 0 || cell >= board.cellCount()) return nullptr;
+            }
+            board = HexBoard(side, cells);
+        }
+        hex_engine* engine = new hex_engine(board);
+        engine->threads = threadCount(threads);
+        return engine;
+    } catch (...){
+        return nullptr;
+    }
+}
+void hex_engine_destroy(hex_engine* engine){
+    delete engine;
+}
+int hex_engine_set_threads(hex_engine* engine, int threads){
+    if (!engine){
+        return HEX_ERROR_ARGUMENT;
+    }
+    engine->threads = threadCount(threads);
+    return HEX_OK;
+}
+int hex_engine_set_table_size(hex_engine* engine, int size_mb){
+    if (!engine || size_mb <= 0){
+        return HEX_ERROR_ARGUMENT;
+    }
+    engine->tableSizeMb = size_mb;
+    engine->searches.clear();                               // Таблицы создаются заново при поиске.
+    return HEX_OK;
+}
+int hex_engine_set_evaluator(hex_engine* engine, int evaluator){
+    if (!engine || (evaluator != HEX_EVALUATOR_MATERIAL && evaluator != HEX_EVALUATOR_WEIGHTS)){
+        return HEX_ERROR_ARGUMENT;
+    }
+    engine->material = evaluator == HEX_EVALUATOR_MATERIAL;
+    for (std::unique_ptr<SearchEngine>& search : engine->searches){
+        search->clear();                                    // Оценки таблиц от другой функции.
+    }
+    return HEX_OK;
+}
+int hex_engine_load_weights(hex_engine* engine, char const* file_name){
+    if (!engine || !file_name){
+        return HEX_ERROR_ARGUMENT;
+    }
+    try {
+        if (!engine->evaluation.load(file_name)){
+            return HEX_ERROR_FILE;
+        }
+    } catch (...){
+        return HEX_ERROR_MEMORY;
+    }
+    for (std::unique_ptr<SearchEngine>& search : engine->searches){
+        search->clear();
+    }
+    return HEX_OK;
+}
+int hex_cell_count(hex_engine const* engine){
+    return engine ? engine->board.cellCount() : HEX_ERROR_ARGUMENT;
+}
+size_t hex_packed_size(hex_engine const* engine){
+    return engine ? size_t(Notation::packedSize(engine->board)) : 0;
+}
+int hex_max_moves(hex_engine const* engine){
+    return engine ? MoveList::capacity : HEX_ERROR_ARGUMENT;
+}
+//............................................................................................................
+//.......................................... Позиции .........................................................
+//............................................................................................................
+int hex_start_position(hex_engine const* engine, uint8_t* position){
+    if (!engine || !position){
+        return HEX_ERROR_ARGUMENT;
+    }
+    int8_t cells[HexBoard::maxCells];
+    engine->board.fillStartField(cells);
+    Notation::packTo(engine->board, engine->board.positionFromField(cells, 1), position);
+    return HEX_OK;
+}
+int hex_position_from_text(hex_engine const* engine, char const* text, uint8_t* position){
+    if (!engine || !text || !position){
+        return HEX_ERROR_ARGUMENT;
+    }
+    try {
+        HexBoard board(engine->board.side());
+        Position parsed;
+        if (!Notation::fromText(text, board, parsed) || board.side() != engine->board.side()
+                || board.blocked() != engine->board.blocked()){
+            return HEX_ERROR_POSITION;                      // Запись ошибочна или другого поля.
+        }
+        Notation::packTo(engine->board, parsed, position);
+    } catch (...){
+        return HEX_ERROR_MEMORY;
+    }
+    return HEX_OK;
+}
+int hex_position_to_text(hex_engine const* engine, uint8_t const* position, char* buffer, size_t size){
+    if (!engine || !position || !buffer || size == 0){
+        return HEX_ERROR_ARGUMENT;
+    }
+    Position unpacked;
+    if (!Notation::unpackOnBoard(position, engine->board, unpacked)){
+        return HEX_ERROR_POSITION;
+    }
+    try {
+        std::string text = Notation::toText(engine->board, unpacked);
+        if (text.size() + 1 > size){
+            return HEX_ERROR_CAPACITY;
+        }
+        std::memcpy(buffer, text.c_str(), text.size() + 1);
+    } catch (...){
+        return HEX_ERROR_MEMORY;
+    }
+    return HEX_OK;
+}
+//............................................................................................................
+//.......................................... Пакетные функции ................................................
+//............................................................................................................
+int hex_generate_moves(hex_engine* engine, uint8_t const* positions, size_t count,
+                       hex_move* moves, size_t capacity, int32_t* move_counts){
+    if (!engine || (count && (!positions || !move_counts || (capacity && !moves)))){
+        return HEX_ERROR_ARGUMENT;
+    }
+    size_t stride = size_t(Notation::packedSize(engine->board));
+    std::atomic<int> status{HEX_OK};
+    parallelFor(engine, count, 256, [&](int, size_t i){
+        Position position;
+        if (!Notation::unpackOnBoard(positions + i * stride, engine->board, position)){
+            move_counts[i] = -1;
+            status = HEX_ERROR_POSITION;
+            return;
+        }
+        MoveList list;
+        engine->board.generateMoves(position, list);
+        size_t written = std::min(capacity, size_t(list.size));
+        for (size_t m = 0; m < written; m++){
+            moves[i * capacity + m] = apiMove(list[int(m)]);
+        }
+        if (written < size_t(list.size)){
+            status = HEX_ERROR_CAPACITY;
+        }
+        move_counts[i] = list.size;
+    });
+    return status;
+}
+int hex_do_moves(hex_engine* engine, uint8_t const* positions, hex_move const* moves, size_t count,
+                 uint8_t* results, int32_t* flips){
+    if (!engine || (count && (!positions || !moves || !results))){
+        return HEX_ERROR_ARGUMENT;
+    }
+    size_t stride = size_t(Notation::packedSize(engine->board));
+    std::atomic<int> status{HEX_OK};
+    parallelFor(engine, count, 256, [&](int, size_t i){
+        Position position;
+        Move move;
+        if (!Notation::unpackOnBoard(positions + i * stride, engine->board, position)){
+            status = HEX_ERROR_POSITION;
+        } else
+        if (!legalMove(engine->board, position, moves[i], move)){
+            status = HEX_ERROR_MOVE;
+        } else {
+            int flipped = engine->board.doMove(position, move).count();
+            Notation::packTo(engine->board, position, results + i * stride);
+            if (flips) flips[i] = flipped;
+            return;
+        }
+        if (flips) flips[i] = -1;                           // Результат не записан.
+    });
+    return status;
+}
+int hex_evaluate(hex_engine* engine, uint8_t const* positions, size_t count, int32_t* scores, int32_t* valid){
+    if (!engine || (count && (!positions || !scores))){
+        return HEX_ERROR_ARGUMENT;
+    }
+    size_t stride = size_t(Notation::packedSize(engine->board));
+    std::atomic<int> status{HEX_OK};
+    parallelFor(engine, count, 256, [&](int, size_t i){
+        Position position;
+        bool unpacked = Notation::unpackOnBoard(positions + i * stride, engine->board, position);
+        scores[i] = unpacked ? evaluatePosition(engine, position) : 0;
+        if (valid) valid[i] = unpacked ? 1 : 0;
+        if (!unpacked) status = HEX_ERROR_POSITION;
+    });
+    return status;
+}
+int hex_search(hex_engine* engine, uint8_t const* positions, size_t count, int depth,
+               hex_search_result* results){
+    if (!engine || depth < 1 || depth > SearchEngine::maxDepth || (count && (!positions || !results))){
+        return HEX_ERROR_ARGUMENT;
+    }
+    try {
+        while (engine->searches.size() < size_t(engine->threads)){// Поиск и таблица на каждый поток.
+            engine->searches.emplace_back(new SearchEngine(engine->tableSizeMb));
+            engine->searches.back()->setEvaluator([engine](Position const& position){
+                return evaluatePosition(engine, position);
+            });
+        }
+    } catch (...){
+        return HEX_ERROR_MEMORY;
+    }
+    size_t stride = size_t(Notation::packedSize(engine->board));
+    std::atomic<int> status{HEX_OK};
+    SearchLimits limits;
+    limits.depth = depth;
+    std::atomic<bool> stop{false};
+    parallelFor(engine, count, 1, [&](int thread, size_t i){
+        hex_search_result& result = results[i];
+        result = hex_search_result{hex_move{-1, -1, 0}, 0, -1, 0};
+        Position position;
+        if (!Notation::unpackOnBoard(positions + i * stride, engine->board, position)){
+            status = HEX_ERROR_POSITION;
+            return;
+        }
+        try {
+            SearchInfo info = engine->searches[size_t(thread)]->analyze(engine->board, position, limits,
+                                                                         SearchEngine::Reporter(), stop);
+            if (!info.line.empty()){
+                result.move = apiMove(info.line.front());
+            }
+            result.score = info.score;
+            result.depth = info.depth;
+            result.nodes = info.nodes;
+        } catch (...){
+            status = HEX_ERROR_MEMORY;
+        }
+    });
+    return status;
+}
@@ -0,0 +1,128 @@
+﻿/**
+* @file hexxagonapi.h
+* @author Oleg2008e28
+* @date 20.10.2026 00:34:15
+* @brief Заголовочный файл C-интерфейса библиотеки HexxagonLibrary: генерация ходов, выполнение ходов,
+* статическая оценка и поиск на заданную глубину для массивов позиций. Интерфейс на языке C, поэтому
+* библиотеку можно вызывать из Python (ctypes, cffi), Julia, Rust и других языков.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*
+* Позиции передаются массивом упакованных записей Notation (как в файлах партий): байт стороны поля,
+* байт игрока, который ходит, затем по 2 бита на ячейку (0 - пусто, 1 - игрок 1, 2 - игрок 2,
+* 3 - блок), ячейка i - биты 2*(i%4) байта 2+i/4. Все записи одного поля имеют размер
+* hex_packed_size(), запись i начинается с байта i*hex_packed_size(). Библиотека читает записи на месте
+* и пишет результаты в буферы вызывающего: позиции не копируются, память на позицию не выделяется
+* (кроме главного варианта поиска внутри hex_search).
+*
+* Пакетные функции делят массив между потоками движка. Одновременно движок может выполнять только один
+* вызов; для параллельных вызовов из разных потоков создаются разные движки. Ошибочная позиция не
+* прерывает пакет: ее результат помечается (количество ходов, оценка или глубина -1), а функция
+* возвращает HEX_ERROR_POSITION.
+*/
+#ifndef HEXXAGONAPI_H
+#define HEXXAGONAPI_H
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(HEXXAGON_LIBRARY)
+#    define HEX_API __declspec(dllexport)
+#  else
+#    define HEX_API __declspec(dllimport)
+#  endif
+#else
+#  define HEX_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+//............................................................................................................
+#define HEX_API_VERSION 1                               /* Версия интерфейса. */
+
+#define HEX_OK 0                                        /* Успешное выполнение. */
+#define HEX_ERROR_ARGUMENT -1                           /* Неверный аргумент или пустой указатель. */
+#define HEX_ERROR_POSITION -2                           /* Хотя бы одна позиция пакета ошибочна. */
+#define HEX_ERROR_CAPACITY -3                           /* Ходы не поместились в буфер. */
+#define HEX_ERROR_MOVE -4                               /* Хотя бы один ход пакета невозможен. */
+#define HEX_ERROR_FILE -5                               /* Файл не прочитан. */
+#define HEX_ERROR_MEMORY -6                             /* Не хватило памяти для таблиц или потоков. */
+
+#define HEX_EVALUATOR_MATERIAL 0                        /* Оценка разностью фишек. */
+#define HEX_EVALUATOR_WEIGHTS 1                         /* Линейная оценка Evaluation (по умолчанию). */
+//............................................................................................................
+/**
+ * @brief hex_engine Движок: геометрия поля, оценочная функция, потоки и таблицы транспозиций поиска.
+ */
+typedef struct hex_engine hex_engine;
+/**
+ * @brief hex_move Ход: ближний (jump = 0) - фишка добавляется в to рядом с from, дальний (jump = 1) -
+ * фишка переходит из from в to через одну ячейку.
+ */
+typedef struct hex_move {
+    int16_t from;                                       /* Ячейка фишки, которая ходит. */
+    int16_t to;                                         /* Конечная ячейка. */
+    int32_t jump;                                       /* 1 - дальний ход с очисткой from. */
+} hex_move;
+/**
+ * @brief hex_search_result Результат поиска позиции.
+ */
+typedef struct hex_search_result {
+    hex_move move;                                      /* Лучший ход, from = to = -1 - ходов нет. */
+    int32_t score;                                      /* Оценка для игрока, который ходит. */
+    int32_t depth;                                      /* Глубина поиска, -1 - позиция ошибочна. */
+    uint64_t nodes;                                     /* Количество позиций поиска. */
+} hex_search_result;
+//............................................................................................................
+HEX_API int hex_api_version(void);                      /* Версия интерфейса библиотеки. */
+/**
+ * Создание движка для поля со стороной side. blocked - индексы заблокированных ячеек (blocked_count
+ * штук); NULL - стандартная раскладка. threads - количество потоков пакетных функций, 0 - все ядра.
+ * Возвращает NULL при неверной геометрии.
+ */
+HEX_API hex_engine* hex_engine_create(int side, int const* blocked, int blocked_count, int threads);
+HEX_API void hex_engine_destroy(hex_engine* engine);
+HEX_API int hex_engine_set_threads(hex_engine* engine, int threads);
+HEX_API int hex_engine_set_table_size(hex_engine* engine, int size_mb);     /* На каждый поток. */
+HEX_API int hex_engine_set_evaluator(hex_engine* engine, int evaluator);    /* HEX_EVALUATOR_*. */
+HEX_API int hex_engine_load_weights(hex_engine* engine, char const* file_name);
+HEX_API int hex_cell_count(hex_engine const* engine);  /* Количество ячеек поля. */
+HEX_API size_t hex_packed_size(hex_engine const* engine);/* Размер упакованной записи позиции, байт. */
+HEX_API int hex_max_moves(hex_engine const* engine);    /* Наибольшее количество ходов в позиции. */
+//............................................................................................................
+HEX_API int hex_start_position(hex_engine const* engine, uint8_t* position);
+HEX_API int hex_position_from_text(hex_engine const* engine, char const* text, uint8_t* position);
+/** Текстовая запись позиции в buffer размером size байт с завершающим нулем. */
+HEX_API int hex_position_to_text(hex_engine const* engine, uint8_t const* position, char* buffer, size_t size);
+//............................................................................................................
+/**
+ * Ходы count позиций: ходы позиции i записываются в moves + i*capacity, их количество - в
+ * move_counts[i] (0 - конец партии). Если ходов больше capacity, записываются первые capacity, а
+ * функция возвращает HEX_ERROR_CAPACITY; capacity = hex_max_moves() достаточно всегда.
+ */
+HEX_API int hex_generate_moves(hex_engine* engine, uint8_t const* positions, size_t count,
+                               hex_move* moves, size_t capacity, int32_t* move_counts);
+/**
+ * Выполнение хода moves[i] в позиции i, результат - в results + i*hex_packed_size(). flips (может быть
+ * NULL) получает количество перевернутых фишек или -1 для невозможного хода.
+ */
+HEX_API int hex_do_moves(hex_engine* engine, uint8_t const* positions, hex_move const* moves, size_t count,
+                         uint8_t* results, int32_t* flips);
+/**
+ * Статическая оценка позиций для игрока, который ходит, 100 - одна фишка. valid (может быть NULL)
+ * получает 1 для верной позиции и 0 для ошибочной.
+ */
+HEX_API int hex_evaluate(hex_engine* engine, uint8_t const* positions, size_t count,
+                         int32_t* scores, int32_t* valid);
+/**
+ * Поиск с итеративным углублением до глубины depth (1..64) для каждой позиции. Таблица транспозиций
+ * потока сохраняется между позициями и вызовами; hex_engine_set_table_size очищает ее. Поэтому оценка
+ * позиции может немного зависеть от позиций, найденных тем же потоком раньше.
+ */
+HEX_API int hex_search(hex_engine* engine, uint8_t const* positions, size_t count, int depth,
+                       hex_search_result* results);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // HEXXAGONAPI_H
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Отрисовка позиций из файлов партий в изображения без окна.
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+TARGET = HexxagonRender
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../HexxagonApplication/engine.pri)
+
+SOURCES += \
+    ../HexxagonApplication/boardrenderer.cpp \
+    main.cpp
+
+HEADERS  += \
+    ../HexxagonApplication/boardrenderer.h
@@ -0,0 +1,131 @@
+#include "boardrenderer.h"
+#include "gamerecord.h"
+#include "hexnotation.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QThread>
+#include <atomic>
+#include <map>
+#include <memory>
+
+/**
+ * @brief The RenderGroup struct Позиции партий с одинаковой геометрией поля и имена их изображений.
+ */
+struct RenderGroup {
+    std::unique_ptr<HexBoard> board;                            // Геометрия поля.
+    std::vector<BoardPicture> pictures;                         // Позиции.
+    std::vector<QString> names;                                 // Имена файлов изображений.
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCommandLineParser parser;                                  // Параметры отрисовки.
+    parser.setApplicationDescription("Отрисовка позиций партий в файлы изображений без окна.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("records", "Файлы партий, записанные с --record.", "records...");
+    QCommandLineOption outputOption("output", "Каталог изображений (по умолчанию текущий).", "dir", ".");
+    QCommandLineOption heightOption("height", "Высота изображения, пикселей.", "n", "400");
+    QCommandLineOption threadsOption("threads", "Количество потоков отрисовки.", "n",
+                                     QString::number(QThread::idealThreadCount()));
+    QCommandLineOption finalOption("final", "Только конечные позиции партий.");
+    QCommandLineOption formatOption("format", "Формат изображений: png (по умолчанию) или jpg.", "name", "png");
+    QCommandLineOption positionOption("position",
+            "Отрисовка одной позиции в текстовой записи в файл --output.", "text");
+    parser.addOption(outputOption);
+    parser.addOption(heightOption);
+    parser.addOption(threadsOption);
+    parser.addOption(finalOption);
+    parser.addOption(formatOption);
+    parser.addOption(positionOption);
+    parser.process(a);
+    int height = parser.value(heightOption).toInt();
+    if (height < 16){
+        qDebug() << "Ошибка: высота изображения должна быть не меньше 16";
+        return -1;
+    }
+    if (parser.isSet(positionOption)){                          // Одна позиция без партий.
+        HexBoard board;
+        BoardPicture picture;
+        if (!Notation::fromText(parser.value(positionOption).toStdString(), board, picture.position)){
+            qDebug() << "Ошибка: неверная запись позиции" << parser.value(positionOption);
+            return -1;
+        }
+        if (!BoardRenderer(board, height).render(picture).save(parser.value(outputOption))){
+            qDebug() << "Ошибка: не удалось записать" << parser.value(outputOption);
+            return -1;
+        }
+        return 0;
+    }
+    if (parser.positionalArguments().isEmpty()){
+        parser.showHelp(-1);
+    }
+    QDir output(parser.value(outputOption));
+    if (!output.mkpath(".")){
+        qDebug() << "Ошибка: не удалось создать каталог" << parser.value(outputOption);
+        return -1;
+    }
+    QString format = parser.value(formatOption);
+    std::map<std::string, RenderGroup> groups;                  // Поля разной геометрии рисуются отдельно.
+    int games = 0;
+    for (QString const& fileName : parser.positionalArguments()){
+        GameRecordReader reader(fileName.toStdString());
+        if (!reader.isOpen()){
+            qDebug() << "Ошибка: неверный файл партий" << fileName;
+            return -1;
+        }
+        QString prefix = QFileInfo(fileName).completeBaseName();
+        GameRecord record;
+        for (int game = 1; reader.next(record); game++){
+            HexBoard board;
+            std::vector<Position> positions;
+            std::vector<Move> moves;
+            if (!record.replay(board, positions, moves)){
+                qDebug() << "Пропущена неверная партия" << game << "файла" << fileName;
+                continue;
+            }
+            Position empty{{Bitboard::empty(), Bitboard::empty()}, 1};
+            RenderGroup& group = groups[Notation::toText(board, empty)];
+            if (!group.board){
+                group.board.reset(new HexBoard(board));
+            }
+            size_t first = parser.isSet(finalOption) ? positions.size() - 1 : 0;
+            for (size_t ply = first; ply < positions.size(); ply++){
+                BoardPicture picture;
+                picture.position = positions[ply];
+                if (ply > 0){                                   // Подсветка хода, приведшего к позиции.
+                    picture.lastMove = moves[ply - 1];
+                    picture.hasLastMove = true;
+                }
+                group.pictures.push_back(picture);
+                group.names.push_back(output.filePath(QString("%1_%2_%3.%4").arg(prefix)
+                                      .arg(game, 5, 10, QChar('0')).arg(int(ply), 3, 10, QChar('0'))
+                                      .arg(format)));
+            }
+            games++;
+        }
+    }
+    QElapsedTimer timer;
+    timer.start();
+    std::atomic<int> failed(0);
+    size_t images = 0;
+    for (auto& item : groups){
+        RenderGroup& group = item.second;
+        BoardRenderer renderer(*group.board, height);
+        renderer.renderBatch(group.pictures, parser.value(threadsOption).toInt(),
+                             [&](size_t index, QImage const& image){
+            if (!image.save(group.names[index])) failed++;      // Кодирование тоже идет в потоках отрисовки.
+        });
+        images += group.pictures.size();
+    }
+    qDebug() << "Партий:" << games << "изображений:" << images << "за" << timer.elapsed() << "мс";
+    if (failed > 0){
+        qDebug() << "Ошибка: не удалось записать изображений:" << int(failed);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+#-------------------------------------------------
+#
+# Сервер партий: много партий в одном процессе, ходы компьютера ищет общий пул потоков.
+#
+#-------------------------------------------------
+
+QT       += core network
+QT       -= gui
+
+TARGET = HexxagonServer
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../HexxagonApplication/engine.pri)
+
+SOURCES += \
+    enginepool.cpp \
+    gameserver.cpp \
+    gamesession.cpp \
+    main.cpp
+
+HEADERS  += \
+    enginepool.h \
+    gameserver.h \
+    gamesession.h
@@ -0,0 +1,172 @@
+﻿/**
+* @file enginepool.cpp
+* @author Oleg2008e28
+* @date 20.10.2026 10:40:05
+* @brief Файл реализации методов класса EnginePool.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "enginepool.h"
+#include "hexmcts.h"
+#include "hexsearch.h"
+#include <algorithm>
+#include <chrono>
+const int EnginePool::mctsNodeCapacity;
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief EnginePool::EnginePool Конструктор класса, запускает потоки пула.
+ * @param threadCount Количество потоков, не меньше 1.
+ * @param tableSizeMb Размер таблицы транспозиций каждого потока, МБ.
+ * @param evaluation Оценочная функция.
+ * @param parent Родительский объект.
+ */
+EnginePool::EnginePool(int threadCount, int tableSizeMb, Evaluation const& evaluation, QObject* parent)
+    : QObject(parent), evaluation(evaluation), tableSize(tableSizeMb){
+    for (int i = 0; i < std::max(1, threadCount); i++){
+        threads.emplace_back(&EnginePool::worker, this);
+    }
+}
+/**
+ * @brief EnginePool::~EnginePool Деструктор класса: выполняемые поиски останавливаются, задания очереди
+ * отбрасываются.
+ */
+EnginePool::~EnginePool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shutdown = true;
+        pending.clear();
+        for (Running& job : running){
+            *job.stop = true;
+        }
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+}
+/**
+ * @brief EnginePool::submit Метод ставит задание в очередь. Прежнее задание партии отменяется.
+ * @param job Задание.
+ */
+void EnginePool::submit(EngineJob const& job){
+    cancel(job.session);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(Pending{job, submitted++});
+    }
+    wake.notify_one();
+}
+/**
+ * @brief EnginePool::cancel Метод удаляет задание партии из очереди и останавливает его поиск. Поиск
+ * заканчивается в течение нескольких микросекунд, его результат получатель отбрасывает по номеру задания.
+ * @param session Номер партии.
+ */
+void EnginePool::cancel(int session){
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [session](Pending const& item){
+        return item.job.session == session;
+    }), pending.end());
+    for (Running& job : running){
+        if (job.session == session){
+            *job.stop = true;
+        }
+    }
+}
+/**
+ * @brief EnginePool::threadCount Метод возвращает количество потоков пула.
+ * @return Количество потоков.
+ */
+int EnginePool::threadCount() const{
+    return int(threads.size());
+}
+/**
+ * @brief EnginePool::pendingCount Метод возвращает количество заданий, ожидающих потока.
+ * @return Количество заданий.
+ */
+int EnginePool::pendingCount(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return int(pending.size());
+}
+//............................................................................................................
+//......................................... private methods ..................................................
+//............................................................................................................
+/**
+ * @brief EnginePool::worker Цикл потока пула: выбор задания партии, потратившей меньше всего времени,
+ * поиск хода и передача результата.
+ */
+void EnginePool::worker(){
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true){
+        wake.wait(lock, [this](){ return shutdown || !pending.empty(); });
+        if (shutdown){
+            return;
+        }
+        auto next = std::min_element(pending.begin(), pending.end(), [](Pending const& a, Pending const& b){
+            return a.job.consumed != b.job.consumed ? a.job.consumed < b.job.consumed : a.order < b.order;
+        });
+        EngineJob job = next->job;
+        pending.erase(next);
+        std::shared_ptr<std::atomic<bool>> stop = std::make_shared<std::atomic<bool>>(false);
+        running.push_back(Running{job.session, stop});
+        lock.unlock();
+        auto begin = std::chrono::steady_clock::now();
+        int score = 0;
+        Move move = search(job, *stop, score);
+        int time = int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - begin).count());
+        if (!*stop){                                        // Сигнал доставляется в поток сервера.
+            emit finished(job.session, job.serial, move.beginPostion, move.newPostion,
+                          move.clearBeginPostion, score, time);
+        }
+        lock.lock();
+        running.erase(std::find_if(running.begin(), running.end(), [&stop](Running const& item){
+            return item.stop == stop;
+        }));
+    }
+}
+/**
+ * @brief EnginePool::search Метод ищет ход задания поиском потока: MCTS в одном потоке или итеративным
+ * углублением (профили миниМакса ищут им же на глубину профиля).
+ * @param job Задание.
+ * @param stop Признак отмены задания.
+ * @param [out] score Оценка хода для игрока, который ходит.
+ * @return Ход или нулевой ход, если ходов нет.
+ */
+Move EnginePool::search(EngineJob const& job, std::atomic<bool> const& stop, int& score){
+    thread_local std::unique_ptr<SearchEngine> searchEngine;// Поиски потока создаются при первом задании
+    thread_local std::unique_ptr<MctsEngine> mctsEngine;    // и живут, пока живет поток.
+    if (job.profile.algorithm == EngineProfile::Algorithm::mcts){
+        if (!mctsEngine){
+            mctsEngine.reset(new MctsEngine(mctsNodeCapacity));
+        }
+        Move move = mctsEngine->search(job.board, job.position, job.timeLimit, 1, job.profile.nodes, &stop);
+        score = int((mctsEngine->bestValue() * 2 - 1) * 1000);
+        return move;
+    }
+    if (!searchEngine){
+        searchEngine.reset(new SearchEngine(tableSize));
+    }
+    bool material = job.profile.evaluator == EngineProfile::Evaluator::material;
+    HexBoard const& board = job.board;
+    searchEngine->setEvaluator([this, &board, material](Position const& position){
+        if (material){
+            int own = position.player - 1;
+            return (position.chips[own].count() - position.chips[1 - own].count()) * Evaluation::scale;
+        }
+        return evaluation.evaluate(board, position, position.player);
+    });
+    SearchOptions options;
+    options.reductions = job.profile.reductions;
+    options.futility = job.profile.futility;
+    options.nullMove = job.profile.nullMove;
+    searchEngine->setOptions(options);
+    SearchLimits limits;
+    limits.depth = std::max(0, job.profile.depth);
+    limits.nodes = uint64_t(std::max<int64_t>(0, job.profile.nodes));
+    limits.solverNodes = uint64_t(job.profile.solverNodes);
+    limits.time = job.timeLimit;
+    SearchInfo info = searchEngine->analyze(board, job.position, limits, SearchEngine::Reporter(), stop);
+    score = info.score;
+    return info.line.empty() ? Move{0, 0, false} : info.line.front();
+}
@@ -0,0 +1,92 @@
+﻿/**
+* @file enginepool.h
+* @author Oleg2008e28
+* @date 20.10.2026 10:12:30
+* @brief Заголовочный файл класса EnginePool - общего для всех партий сервера пула потоков поиска хода.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef ENGINEPOOL_H
+#define ENGINEPOOL_H
+#include <QObject>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "hexboard.h"
+#include "hexevaluation.h"
+#include "hexprofile.h"
+//............................................................................................................
+/**
+ * @brief The EngineJob struct Задание поиска хода: позиция партии, профиль компьютера и выделенное время.
+ */
+struct EngineJob {
+    int session = 0;                                    //!Номер партии.
+    int serial = 0;                                     //!Номер задания партии, устаревшие ответы отбрасываются.
+    HexBoard board;                                     //!Геометрия поля партии.
+    Position position;                                  //!Позиция, в которой нужен ход.
+    EngineProfile profile;                              //!Профиль компьютера.
+    int timeLimit = 0;                                  //!Время поиска, мс.
+    int64_t consumed = 0;                               //!Время, уже потраченное партией, мс.
+};
+//............................................................................................................
+/**
+ * @brief The EnginePool class Пул потоков поиска хода, общий для всех партий.
+ *
+ * Количество потоков ограничено, у каждого потока свои поиски: SearchEngine с таблицей транспозиций и,
+ * по требованию, MctsEngine. У партии не больше одного задания. Свободный поток берет задание партии,
+ * потратившей меньше всего времени поиска, при равенстве - более раннее, поэтому долгие партии не
+ * вытесняют короткие. Задание ищет не дольше выделенного партии времени. Результат передается сигналом
+ * finished, который доставляется в поток получателя.
+ */
+class EnginePool : public QObject{
+    Q_OBJECT
+public:
+    EnginePool(int threadCount, int tableSizeMb,
+               Evaluation const& evaluation,
+               QObject* parent = nullptr);              // Конструктор, запуск потоков.
+    ~EnginePool();                                      // Деструктор, остановка потоков.
+    void submit(EngineJob const& job);                  // Постановка задания в очередь.
+    void cancel(int session);                           // Отмена задания партии.
+    int threadCount() const;                            // Количество потоков.
+    int pendingCount();                                 // Количество заданий в очереди.
+//............................................................................................................
+public:
+    static const int mctsNodeCapacity = 1 << 18;        //!Размер пула узлов MCTS каждого потока.
+//............................................................................................................
+signals:
+    void finished(int session, int serial, int begin, int end,
+                  bool clear, int score, int time);     // Сигнал о найденном ходе.
+//............................................................................................................
+private:
+    void worker();                                      // Цикл потока пула.
+    Move search(EngineJob const& job,
+                std::atomic<bool> const& stop,
+                int& score);                            // Поиск хода задания.
+private:
+    /**
+     * @brief The Pending struct Задание в очереди.
+     */
+    struct Pending {
+        EngineJob job;                                  //!Задание.
+        uint64_t order;                                 //!Порядковый номер постановки.
+    };
+    /**
+     * @brief The Running struct Выполняемое задание.
+     */
+    struct Running {
+        int session;                                    //!Номер партии.
+        std::shared_ptr<std::atomic<bool>> stop;        //!Признак остановки поиска.
+    };
+    Evaluation evaluation;                              // Оценка позиций.
+    int tableSize;                                      // Размер таблицы транспозиций потока, МБ.
+    std::vector<std::thread> threads;                   // Потоки пула.
+    std::mutex mutex;                                   // Защита очереди.
+    std::condition_variable wake;                       // Появление задания или остановка.
+    std::vector<Pending> pending;                       // Очередь заданий.
+    std::vector<Running> running;                       // Выполняемые задания.
+    uint64_t submitted = 0;                             // Количество поставленных заданий.
+    bool shutdown = false;                              // Пул останавливается.
+};
+#endif // ENGINEPOOL_H
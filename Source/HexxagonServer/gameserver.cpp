@@ -0,0 +1,266 @@
+﻿/**
+* @file gameserver.cpp
+* @author Oleg2008e28
+* @date 20.10.2026 12:17:52
+* @brief Файл реализации методов класса GameServer.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "gameserver.h"
+#include "hexnotation.h"
+#include <algorithm>
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief GameServer::GameServer Конструктор сервера.
+ * @param pool Пул поиска ходов.
+ * @param profiles Профили, которые клиент выбирает по названию.
+ * @param defaultProfile Профиль партий без выбранного профиля.
+ * @param budget Бюджет времени поиска партии, мс, 0 - без ограничения.
+ * @param maxSessions Наибольшее количество одновременных партий.
+ * @param parent Родительский объект.
+ */
+GameServer::GameServer(EnginePool* pool, std::vector<EngineProfile> const& profiles,
+                       EngineProfile const& defaultProfile, int budget, int maxSessions, QObject* parent)
+    : QObject(parent), pool(pool), profiles(profiles), defaultProfile(defaultProfile),
+      budget(budget), maxSessions(maxSessions){
+    server = new QLocalServer(this);
+    connect(server, SIGNAL(newConnection()), this, SLOT(newConnection()));
+    connect(pool, SIGNAL(finished(int,int,int,int,bool,int,int)),   // Сигнал потока пула доставляется
+            this, SLOT(searchFinished(int,int,int,int,bool,int,int)));// в поток сервера очередью.
+}
+/**
+ * @brief GameServer::listen Метод начинает прием клиентов. Оставшийся от упавшего сервера сокет
+ * удаляется.
+ * @param name Имя сервера (имя канала или путь сокета).
+ * @return true - прием начат.
+ */
+bool GameServer::listen(QString const& name){
+    QLocalServer::removeServer(name);
+    return server->listen(name);
+}
+/**
+ * @brief GameServer::errorString Метод возвращает описание ошибки приема клиентов.
+ */
+QString GameServer::errorString() const{
+    return server->errorString();
+}
+//............................................................................................................
+//.......................................... private slots ...................................................
+//............................................................................................................
+/**
+ * @brief GameServer::newConnection Метод принимает подключившихся клиентов.
+ */
+void GameServer::newConnection(){
+    while (QLocalSocket* client = server->nextPendingConnection()){
+        connect(client, SIGNAL(readyRead()), this, SLOT(readClient()));
+        connect(client, SIGNAL(disconnected()), this, SLOT(clientDisconnected()));
+    }
+}
+/**
+ * @brief GameServer::readClient Метод читает и выполняет законченные строки команд клиента.
+ */
+void GameServer::readClient(){
+    QLocalSocket* client = qobject_cast<QLocalSocket*>(sender());
+    while (client && client->canReadLine()){
+        QString line = QString::fromUtf8(client->readLine()).trimmed();
+        if (!line.isEmpty()){
+            command(client, line);
+        }
+    }
+}
+/**
+ * @brief GameServer::clientDisconnected Метод закрывает партии отключившегося клиента.
+ */
+void GameServer::clientDisconnected(){
+    QLocalSocket* client = qobject_cast<QLocalSocket*>(sender());
+    for (int id : owners.keys(client)){
+        closeSession(id);
+    }
+    client->deleteLater();
+}
+/**
+ * @brief GameServer::searchFinished Метод выполняет ход компьютера, найденный пулом. Результаты
+ * отмененных и устаревших заданий отбрасываются.
+ * @param session Номер партии.
+ * @param serial Номер задания.
+ * @param begin Начальная ячейка хода.
+ * @param end Конечная ячейка хода.
+ * @param clear Признак дальнего хода.
+ * @param score Оценка хода.
+ * @param time Время поиска, мс.
+ */
+void GameServer::searchFinished(int session, int serial, int begin, int end, bool clear, int score, int time){
+    Q_UNUSED(score);
+    auto found = sessions.find(session);
+    if (found == sessions.end() || !found->second->acceptResult(serial, time)){
+        return;
+    }
+    Move move{int16_t(begin), int16_t(end), clear};
+    found->second->play(move);
+    afterMove(*found->second, move);
+}
+//............................................................................................................
+//......................................... private methods ..................................................
+//............................................................................................................
+/**
+ * @brief GameServer::command Метод выполняет команду клиента.
+ * @param client Клиент.
+ * @param line Строка команды.
+ */
+void GameServer::command(QLocalSocket* client, QString const& line){
+    QStringList words = line.split(' ', QString::SkipEmptyParts);
+    QString const& name = words[0];
+    if (name == "new"){
+        createSession(client, line.mid(3).trimmed().split("; "));
+    } else
+    if (name == "move" && words.size() == 3){
+        GameSession* session = findSession(client, words[1]);
+        Move move;
+        if (!session){
+            return;
+        }
+        if (session->isOver() || session->isComputerTurn()){
+            reply(client, "error not your move");
+            return;
+        }
+        if (!Notation::moveFromName(session->board(), session->position(), words[2].toStdString(), move)){
+            reply(client, "error illegal move " + words[2]);
+            return;
+        }
+        session->play(move);
+        afterMove(*session, move);
+    } else
+    if (name == "show" && words.size() == 2){
+        if (GameSession* session = findSession(client, words[1])){
+            reply(client, QString("position %1 %2").arg(session->id()).arg(positionText(*session)));
+        }
+    } else
+    if (name == "close" && words.size() == 2){
+        if (GameSession* session = findSession(client, words[1])){
+            int id = session->id();
+            closeSession(id);
+            reply(client, QString("closed %1").arg(id));
+        }
+    } else
+    if (name == "stats"){
+        reply(client, QString("stats sessions %1 pending %2 threads %3")
+              .arg(int(sessions.size())).arg(pool->pendingCount()).arg(pool->threadCount()));
+    } else {
+        reply(client, "error unknown command " + name);
+    }
+}
+/**
+ * @brief GameServer::createSession Метод создает партию по параметрам команды new.
+ * @param client Клиент.
+ * @param fields Параметры: стороны компьютера, затем "profile <название>" и "position <позиция>".
+ */
+void GameServer::createSession(QLocalSocket* client, QStringList const& fields){
+    if (int(sessions.size()) >= maxSessions){
+        reply(client, "error too many sessions");
+        return;
+    }
+    QString sides = fields.value(0).trimmed();
+    int computers = sides == "none" ? 0 : sides == "1" ? 1 : sides == "2" ? 2 : sides == "both" ? 3 : -1;
+    if (computers < 0){
+        reply(client, "error computers must be none, 1, 2 or both");
+        return;
+    }
+    HexBoard board;
+    int8_t cells[HexBoard::maxCells];
+    board.fillStartField(cells);
+    Position position = board.positionFromField(cells, 1);
+    EngineProfile profile = defaultProfile;
+    for (int i = 1; i < fields.size(); i++){
+        QString field = fields[i].trimmed();
+        if (field.startsWith("profile ")){
+            QString wanted = field.mid(8).trimmed();
+            auto found = std::find_if(profiles.begin(), profiles.end(), [&](EngineProfile const& item){
+                return QString::fromStdString(item.name) == wanted;
+            });
+            if (found == profiles.end()){
+                reply(client, "error unknown profile " + wanted);
+                return;
+            }
+            profile = *found;
+        } else
+        if (field.startsWith("position ")){
+            if (!Notation::fromText(field.mid(9).trimmed().toStdString(), board, position)){
+                reply(client, "error bad position");
+                return;
+            }
+        } else {
+            reply(client, "error unknown parameter " + field);
+            return;
+        }
+    }
+    int id = nextId++;
+    GameSession* session = new GameSession(id, board, position, computers, profile, budget);
+    sessions[id].reset(session);
+    owners.insert(id, client);
+    reply(client, QString("session %1 %2").arg(id).arg(positionText(*session)));
+    if (session->isOver()){
+        reply(client, QString("over %1 %2 %3").arg(id).arg(session->chips(1)).arg(session->chips(2)));
+    } else
+    if (session->isComputerTurn()){
+        pool->submit(session->createJob());
+    }
+}
+/**
+ * @brief GameServer::closeSession Метод закрывает партию и отменяет ее поиск.
+ * @param id Номер партии.
+ */
+void GameServer::closeSession(int id){
+    pool->cancel(id);
+    sessions.erase(id);
+    owners.remove(id);
+}
+/**
+ * @brief GameServer::afterMove Метод сообщает клиенту о ходе и окончании партии и ставит в очередь
+ * поиск, если дальше ходит компьютер.
+ * @param session Партия после хода.
+ * @param move Выполненный ход.
+ */
+void GameServer::afterMove(GameSession& session, Move const& move){
+    QLocalSocket* client = owners.value(session.id());
+    reply(client, QString("moved %1 %2 %3").arg(session.id())
+          .arg(QString::fromStdString(Notation::moveName(session.board(), move)))
+          .arg(positionText(session)));
+    if (session.isOver()){
+        reply(client, QString("over %1 %2 %3").arg(session.id()).arg(session.chips(1)).arg(session.chips(2)));
+    } else
+    if (session.isComputerTurn()){
+        pool->submit(session.createJob());
+    }
+}
+/**
+ * @brief GameServer::findSession Метод находит партию клиента, иначе отвечает ошибкой.
+ * @param client Клиент.
+ * @param id Номер партии в записи команды.
+ * @return Партия или nullptr.
+ */
+GameSession* GameServer::findSession(QLocalSocket* client, QString const& id){
+    auto found = sessions.find(id.toInt());
+    if (found == sessions.end() || owners.value(found->first) != client){
+        reply(client, "error unknown session " + id);
+        return nullptr;
+    }
+    return found->second.get();
+}
+/**
+ * @brief GameServer::reply Метод отправляет клиенту строку ответа.
+ * @param client Клиент.
+ * @param text Ответ без перевода строки.
+ */
+void GameServer::reply(QLocalSocket* client, QString const& text){
+    if (client){
+        client->write((text + "\n").toUtf8());
+    }
+}
+/**
+ * @brief GameServer::positionText Метод возвращает текстовую запись позиции партии.
+ * @param session Партия.
+ */
+QString GameServer::positionText(GameSession const& session) const{
+    return QString::fromStdString(Notation::toText(session.board(), session.position()));
+}
@@ -0,0 +1,73 @@
+﻿/**
+* @file gameserver.h
+* @author Oleg2008e28
+* @date 20.10.2026 11:48:27
+* @brief Заголовочный файл класса GameServer - сервера партий: принимает клиентов через QLocalServer
+* (именованный канал Windows или сокет Unix) и ведет их партии, ходы компьютера ищет общий пул EnginePool.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QHash>
+#include <QStringList>
+#include <map>
+#include <memory>
+#include "gamesession.h"
+//............................................................................................................
+/**
+ * @brief The GameServer class Сервер партий.
+ *
+ * Клиент передает команды текстовыми строками, параметры команды new разделяются "; ":
+ *   new <none|1|2|both>[; profile <название>][; position <позиция>] - новая партия, компьютер играет за
+ *                                                 указанных игроков, ответ "session <номер> <позиция>";
+ *   move <номер> <ход>      - ход человека, ответ "moved <номер> <ход> <позиция>";
+ *   show <номер>            - ответ "position <номер> <позиция>";
+ *   close <номер>           - закрытие партии, ответ "closed <номер>";
+ *   stats                   - ответ "stats sessions <n> pending <n> threads <n>".
+ * Ходы компьютера сервер сообщает строкой "moved", окончание партии - "over <номер> <фишки 1> <фишки 2>",
+ * ошибки - "error <описание>". Позиции и ходы записываются как в Notation. Партии клиента закрываются
+ * при его отключении.
+ */
+class GameServer : public QObject{
+    Q_OBJECT
+public:
+    GameServer(EnginePool* pool,
+               std::vector<EngineProfile> const& profiles,
+               EngineProfile const& defaultProfile,
+               int budget, int maxSessions,
+               QObject* parent = nullptr);              // Конструктор сервера.
+    bool listen(QString const& name);                   // Начало приема клиентов.
+    QString errorString() const;                        // Описание ошибки приема.
+//............................................................................................................
+private slots:
+    void newConnection();                               // Подключение клиента.
+    void readClient();                                  // Чтение команд клиента.
+    void clientDisconnected();                          // Отключение клиента.
+    void searchFinished(int session, int serial, int begin, int end,
+                        bool clear, int score, int time);// Ход компьютера найден.
+//............................................................................................................
+private:
+    void command(QLocalSocket* client, QString const& line);// Выполнение команды клиента.
+    void createSession(QLocalSocket* client,
+                       QStringList const& fields);      // Создание партии.
+    void closeSession(int id);                          // Закрытие партии.
+    void afterMove(GameSession& session, Move const& move);// Сообщение о ходе и ход компьютера.
+    GameSession* findSession(QLocalSocket* client,
+                             QString const& id);        // Партия клиента по номеру.
+    void reply(QLocalSocket* client, QString const& text);// Отправка строки клиенту.
+    QString positionText(GameSession const& session) const;// Текстовая запись позиции партии.
+private:
+    QLocalServer* server;                               // Прием клиентов.
+    EnginePool* pool;                                   // Пул поиска ходов.
+    std::vector<EngineProfile> profiles;                // Профили компьютеров.
+    EngineProfile defaultProfile;                       // Профиль по умолчанию.
+    int budget;                                         // Бюджет времени поиска партии, мс.
+    int maxSessions;                                    // Наибольшее количество партий.
+    int nextId = 1;                                     // Номер следующей партии.
+    std::map<int, std::unique_ptr<GameSession>> sessions;// Партии по номерам.
+    QHash<int, QLocalSocket*> owners;                   // Клиенты партий.
+};
+#endif // GAMESERVER_H
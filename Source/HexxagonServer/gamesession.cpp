@@ -0,0 +1,122 @@
+﻿/**
+* @file gamesession.cpp
+* @author Oleg2008e28
+* @date 20.10.2026 11:21:13
+* @brief Файл реализации методов класса GameSession.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "gamesession.h"
+#include <algorithm>
+const int GameSession::defaultMoveTime;
+const int GameSession::minimumMoveTime;
+/**
+ * @brief GameSession::GameSession Конструктор партии.
+ * @param id Номер партии.
+ * @param board Геометрия поля.
+ * @param position Стартовая позиция.
+ * @param computers Игроки, за которых ходит компьютер: бит 1 - игрок 1, бит 2 - игрок 2.
+ * @param profile Профиль компьютера.
+ * @param budget Бюджет времени поиска партии, мс, 0 - без ограничения.
+ */
+GameSession::GameSession(int id, HexBoard const& board, Position const& position, int computers,
+                         EngineProfile const& profile, int budget)
+    : sessionId(id), sessionBoard(board), current(position), computerMask(computers),
+      profile(profile), budget(budget){
+}
+/**
+ * @brief GameSession::id Метод возвращает номер партии.
+ */
+int GameSession::id() const{
+    return sessionId;
+}
+/**
+ * @brief GameSession::board Метод возвращает геометрию поля партии.
+ */
+HexBoard const& GameSession::board() const{
+    return sessionBoard;
+}
+/**
+ * @brief GameSession::position Метод возвращает текущую позицию партии.
+ */
+Position const& GameSession::position() const{
+    return current;
+}
+/**
+ * @brief GameSession::isOver Метод проверяет окончание партии: у игрока, который ходит, нет ходов.
+ */
+bool GameSession::isOver() const{
+    return !sessionBoard.hasMoves(current, current.player);
+}
+/**
+ * @brief GameSession::isComputerTurn Метод проверяет, должен ли ходить компьютер.
+ */
+bool GameSession::isComputerTurn() const{
+    return !isOver() && (computerMask & current.player) != 0;
+}
+/**
+ * @brief GameSession::isSearching Метод проверяет, ждет ли партия хода от пула.
+ */
+bool GameSession::isSearching() const{
+    return searching;
+}
+/**
+ * @brief GameSession::chips Метод возвращает количество фишек игрока.
+ * @param player Игрок (1 или 2).
+ */
+int GameSession::chips(int player) const{
+    return current.chips[player - 1].count();
+}
+/**
+ * @brief GameSession::consumed Метод возвращает время поиска, потраченное партией.
+ * @return Время, мс.
+ */
+int64_t GameSession::consumed() const{
+    return spent;
+}
+/**
+ * @brief GameSession::play Метод выполняет ход игрока, который ходит. Ход проверяется вызывающим.
+ * @param move Ход.
+ */
+void GameSession::play(Move const& move){
+    sessionBoard.doMove(current, move);
+}
+/**
+ * @brief GameSession::createJob Метод создает задание поиска хода компьютера с новым номером.
+ * @return Задание.
+ */
+EngineJob GameSession::createJob(){
+    EngineJob job;
+    job.session = sessionId;
+    job.serial = ++serial;
+    job.board = sessionBoard;
+    job.position = current;
+    job.profile = profile;
+    job.consumed = spent;
+    int moveTime = profile.time > 0 ? profile.time : defaultMoveTime;
+    if (budget > 0){                                        // Остаток бюджета делится между ходами.
+        moveTime = int(std::min<int64_t>(moveTime, (budget - spent) / 2));
+    }
+    job.timeLimit = std::max(minimumMoveTime, moveTime);
+    searching = true;
+    return job;
+}
+/**
+ * @brief GameSession::acceptResult Метод принимает результат задания, если это последнее задание партии.
+ * @param serial Номер задания.
+ * @param time Время поиска, мс.
+ * @return true - ход задания нужно выполнить.
+ */
+bool GameSession::acceptResult(int serial, int time){
+    if (!searching || serial != this->serial){
+        return false;
+    }
+    searching = false;
+    spent += time;
+    return true;
+}
+/**
+ * @brief GameSession::cancelSearch Метод отказывается от результата выполняемого задания.
+ */
+void GameSession::cancelSearch(){
+    searching = false;
+}
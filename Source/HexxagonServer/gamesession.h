@@ -0,0 +1,52 @@
+﻿/**
+* @file gamesession.h
+* @author Oleg2008e28
+* @date 20.10.2026 11:05:48
+* @brief Заголовочный файл класса GameSession - партии сервера: позиции, сторон, за которые играет
+* компьютер, профиля компьютера и бюджета времени поиска.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+#include "enginepool.h"
+//............................................................................................................
+/**
+ * @brief The GameSession class Партия сервера. Ходит игрок позиции; если у него нет ходов, партия
+ * окончена. За игроков, отмеченных в computers, ходит пул поиска. Партия получает общий бюджет времени
+ * поиска: ход ищется время профиля, но не больше половины остатка бюджета, и не меньше minimumMoveTime.
+ */
+class GameSession{
+public:
+    GameSession(int id, HexBoard const& board,
+                Position const& position, int computers,
+                EngineProfile const& profile,
+                int budget);                            // Конструктор партии.
+    int id() const;                                     // Номер партии.
+    HexBoard const& board() const;                      // Геометрия поля.
+    Position const& position() const;                   // Текущая позиция.
+    bool isOver() const;                                // Признак окончания партии.
+    bool isComputerTurn() const;                        // Признак хода компьютера.
+    bool isSearching() const;                           // Признак ожидания хода пула.
+    int chips(int player) const;                        // Количество фишек игрока.
+    int64_t consumed() const;                           // Время поиска, потраченное партией, мс.
+    void play(Move const& move);                        // Выполнение хода.
+    EngineJob createJob();                              // Задание поиска хода компьютера.
+    bool acceptResult(int serial, int time);            // Прием результата задания.
+    void cancelSearch();                                // Отказ от результата задания.
+//............................................................................................................
+public:
+    static const int defaultMoveTime = 1000;            //!Время хода, если в профиле оно не задано, мс.
+    static const int minimumMoveTime = 10;              //!Наименьшее время хода, мс.
+//............................................................................................................
+private:
+    int sessionId;                                      // Номер партии.
+    HexBoard sessionBoard;                              // Геометрия поля.
+    Position current;                                   // Текущая позиция.
+    int computerMask;                                   // Бит 1 - компьютер 1, бит 2 - компьютер 2.
+    EngineProfile profile;                              // Профиль компьютера.
+    int budget;                                         // Бюджет времени поиска, мс, 0 - без ограничения.
+    int64_t spent = 0;                                  // Потраченное время поиска, мс.
+    int serial = 0;                                     // Номер последнего задания.
+    bool searching = false;                             // Задание в пуле.
+};
+#endif // GAMESESSION_H
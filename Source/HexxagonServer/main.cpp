@@ -0,0 +1,68 @@
+#include "gameserver.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QThread>
+#include <algorithm>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCommandLineParser parser;                                  // Параметры сервера.
+    parser.setApplicationDescription("Сервер партий: клиенты подключаются к локальному сокету, ходы "
+                                     "компьютера всех партий ищет общий пул потоков.");
+    parser.addHelpOption();
+    QCommandLineOption nameOption("name", "Имя сервера (по умолчанию hexxagon).", "name", "hexxagon");
+    QCommandLineOption threadsOption("threads", "Количество потоков поиска.", "n",
+                                     QString::number(QThread::idealThreadCount()));
+    QCommandLineOption hashOption("hash", "Таблица транспозиций каждого потока, МБ.", "mb", "16");
+    QCommandLineOption budgetOption("budget",
+            "Бюджет времени поиска одной партии, мс, 0 - без ограничения.", "ms", "120000");
+    QCommandLineOption sessionsOption("max-sessions", "Наибольшее количество партий.", "n", "1000");
+    QCommandLineOption weightsOption("weights", "Файл весов оценочной функции.", "file");
+    QCommandLineOption profilesOption("profiles", "Файл профилей компьютеров.", "file");
+    QCommandLineOption profileOption("profile", "Профиль партий по умолчанию.", "name");
+    parser.addOption(nameOption);
+    parser.addOption(threadsOption);
+    parser.addOption(hashOption);
+    parser.addOption(budgetOption);
+    parser.addOption(sessionsOption);
+    parser.addOption(weightsOption);
+    parser.addOption(profilesOption);
+    parser.addOption(profileOption);
+    parser.process(a);
+    Evaluation evaluation;                                      // Веса по умолчанию или из файла.
+    if (parser.isSet(weightsOption) && !evaluation.load(parser.value(weightsOption).toStdString())){
+        qDebug() << "Ошибка: неверный файл весов" << parser.value(weightsOption);
+        return -1;
+    }
+    std::vector<EngineProfile> profiles;
+    if (parser.isSet(profilesOption)){
+        std::string error;
+        if (!EngineProfiles::load(parser.value(profilesOption).toStdString(), profiles, error)){
+            qDebug() << "Ошибка: неверный файл профилей:" << QString::fromStdString(error);
+            return -1;
+        }
+    }
+    EngineProfile defaultProfile;                               // Итеративное углубление на время хода.
+    defaultProfile.algorithm = EngineProfile::Algorithm::search;
+    if (parser.isSet(profileOption)){
+        auto found = std::find_if(profiles.begin(), profiles.end(), [&](EngineProfile const& profile){
+            return QString::fromStdString(profile.name) == parser.value(profileOption);
+        });
+        if (found == profiles.end()){
+            qDebug() << "Ошибка: нет профиля" << parser.value(profileOption);
+            return -1;
+        }
+        defaultProfile = *found;
+    }
+    EnginePool pool(parser.value(threadsOption).toInt(), parser.value(hashOption).toInt(), evaluation);
+    GameServer server(&pool, profiles, defaultProfile, parser.value(budgetOption).toInt(),
+                      parser.value(sessionsOption).toInt());
+    if (!server.listen(parser.value(nameOption))){
+        qDebug() << "Ошибка: не удалось открыть сервер" << parser.value(nameOption) << server.errorString();
+        return -1;
+    }
+    qDebug() << "Сервер" << parser.value(nameOption) << "потоков поиска:" << pool.threadCount();
+    return a.exec();
+}
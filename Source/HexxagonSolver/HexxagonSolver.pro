@@ -0,0 +1,18 @@
+#-------------------------------------------------
+#
+# Разметка позиций решателем: выигрыш, проигрыш или не известно.
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = HexxagonSolver
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../HexxagonApplication/engine.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,144 @@
+#include "gamerecord.h"
+#include "hexnotation.h"
+#include "hexsolver.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <thread>
+
+/**
+ * @brief The SolvedPosition struct Позиция набора и ее результат.
+ */
+struct SolvedPosition {
+    std::string text;                                           // Текстовая запись позиции.
+    ProofInfo info;                                             // Результат решателя.
+    std::string move;                                           // Запись выигрывающего хода.
+    bool valid;                                                 // Запись позиции разобрана.
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCommandLineParser parser;                                  // Параметры разметки.
+    parser.setApplicationDescription("Разметка позиций решателем: win, loss или unknown для игрока, который ходит.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("files", "Файлы позиций в текстовой записи, по одной в строке.", "files...");
+    QCommandLineOption recordsOption("records", "Файлы - партии, записанные с --record: размечаются все их позиции.");
+    QCommandLineOption nodesOption("nodes", "Бюджет решателя на позицию, позиций.", "n", "100000");
+    QCommandLineOption threadsOption("threads", "Количество потоков, у каждого свой решатель.", "n",
+                                     QString::number(QThread::idealThreadCount()));
+    QCommandLineOption tableOption("table", "Размер таблицы доказательств потока, МБ.", "mb",
+                                   QString::number(ProofSolver::defaultTableSizeMb));
+    QCommandLineOption outputOption("output", "Файл результатов (по умолчанию стандартный вывод).", "file");
+    parser.addOption(recordsOption);
+    parser.addOption(nodesOption);
+    parser.addOption(threadsOption);
+    parser.addOption(tableOption);
+    parser.addOption(outputOption);
+    parser.process(a);
+    if (parser.positionalArguments().isEmpty()){
+        parser.showHelp(-1);
+    }
+    std::vector<SolvedPosition> positions;
+    std::set<std::string> seen;                                 // Позиции партий без повторов.
+    for (QString const& fileName : parser.positionalArguments()){
+        if (parser.isSet(recordsOption)){
+            GameRecordReader reader(fileName.toStdString());
+            if (!reader.isOpen()){
+                qDebug() << "Ошибка: неверный файл партий" << fileName;
+                return -1;
+            }
+            GameRecord record;
+            for (int game = 1; reader.next(record); game++){
+                HexBoard board;
+                std::vector<Position> replayed;
+                std::vector<Move> moves;
+                if (!record.replay(board, replayed, moves)){
+                    qDebug() << "Пропущена неверная партия" << game << "файла" << fileName;
+                    continue;
+                }
+                for (Position const& position : replayed){
+                    std::string text = Notation::toText(board, position);
+                    if (seen.insert(text).second){
+                        positions.push_back(SolvedPosition{text, ProofInfo(), std::string(), true});
+                    }
+                }
+            }
+            continue;
+        }
+        std::ifstream file(fileName.toStdString());
+        if (!file){
+            qDebug() << "Ошибка: не удалось открыть" << fileName;
+            return -1;
+        }
+        std::string line;
+        while (std::getline(file, line)){
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            positions.push_back(SolvedPosition{line, ProofInfo(), std::string(), true});
+        }
+    }
+    uint64_t nodeLimit = parser.value(nodesOption).toULongLong();
+    int threadCount = std::max(1, parser.value(threadsOption).toInt());
+    int tableSize = std::max(1, parser.value(tableOption).toInt());
+    QElapsedTimer timer;
+    timer.start();
+    std::atomic<size_t> next(0);                                // Позиции раздаются потокам по одной.
+    std::atomic<int> invalid(0);
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++){
+        workers.emplace_back([&]{
+            ProofSolver solver(tableSize);
+            for (size_t i = next++; i < positions.size(); i = next++){
+                SolvedPosition& item = positions[i];
+                HexBoard board;
+                Position position;
+                if (!Notation::fromText(item.text, board, position)){
+                    item.valid = false;
+                    invalid++;
+                    continue;
+                }
+                item.info = solver.solve(board, position, nodeLimit, stop);
+                if (item.info.result == ProofResult::win){
+                    item.move = Notation::moveName(board, item.info.move);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers){
+        worker.join();
+    }
+    std::ofstream file;
+    if (parser.isSet(outputOption)){
+        file.open(parser.value(outputOption).toStdString());
+        if (!file){
+            qDebug() << "Ошибка: не удалось записать" << parser.value(outputOption);
+            return -1;
+        }
+    }
+    std::ostream& output = parser.isSet(outputOption) ? file : std::cout;
+    int counts[3] = {0, 0, 0};                                  // unknown, win, loss.
+    uint64_t nodes = 0;
+    for (SolvedPosition const& item : positions){               // Результаты в порядке набора.
+        output << item.text << '\t' << (item.valid ? ProofSolver::resultName(item.info.result) : "invalid") << '\t'
+               << (item.move.empty() ? "-" : item.move) << '\t' << item.info.nodes << '\n';
+        counts[int(item.info.result)]++;
+        nodes += item.info.nodes;
+    }
+    output.flush();
+    qDebug() << "Позиций:" << positions.size() << "выигрыш:" << counts[int(ProofResult::win)]
+             << "проигрыш:" << counts[int(ProofResult::loss)] << "не известно:" << counts[int(ProofResult::unknown)]
+             << "позиций решателя:" << nodes << "за" << timer.elapsed() << "мс";
+    if (invalid > 0){
+        qDebug() << "Ошибка: неверных записей позиций:" << int(invalid);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+#-------------------------------------------------
+#
+# Подбор весов оценочной функции по файлам партий, обучение n-кортежей самоигрой и матчи поиска.
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = HexxagonTuner
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../HexxagonApplication/engine.pri)
+
+SOURCES += \
+    main.cpp \
+    searchmatch.cpp \
+    tdtrainer.cpp \
+    texeltuner.cpp
+
+HEADERS  += \
+    searchmatch.h \
+    tdtrainer.h \
+    texeltuner.h
@@ -0,0 +1,343 @@
+#include "texeltuner.h"
+#include "tdtrainer.h"
+#include "searchmatch.h"
+#include "hexsuite.h"
+#include "hexnnue.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+/**
+ * @brief runSuite Функция проверяет набор тестовых позиций: количество листьев perft и лучшие ходы и
+ * оценки поиска. Каждое расхождение выводится отдельной строкой.
+ * @param entries Тестовые позиции.
+ * @param evaluation Оценочная функция поиска.
+ * @param depth Глубина поиска для позиций без операции depth.
+ * @return Количество расхождений.
+ */
+static int runSuite(std::vector<SuiteEntry> const& entries, Evaluation const& evaluation, int depth){
+    int failures = 0;
+    uint64_t perftNodes = 0;
+    QElapsedTimer clock;
+    clock.start();
+    std::atomic<bool> stop(false);
+    for (SuiteEntry const& entry : entries){
+        QString name = QString::fromStdString(entry.id.empty() ? Notation::toText(entry.board, entry.position)
+                                                               : entry.id);
+        for (auto const& p : entry.perft){                      // Генератор ходов.
+            uint64_t nodes = TestSuite::perft(entry.board, entry.position, p.first);
+            perftNodes += nodes;
+            if (nodes != p.second){
+                qDebug().noquote() << name << "perft" << p.first << ":" << nodes << "вместо" << p.second;
+                failures++;
+            }
+        }
+        if (entry.bestMoves.empty() && !entry.hasScore){
+            continue;
+        }
+        SearchEngine engine;                                    // Поиск с чистой таблицей.
+        HexBoard const& board = entry.board;
+        engine.setEvaluator([&evaluation, &board](Position const& position){
+            return evaluation.evaluate(board, position, position.player);
+        });
+        SearchLimits limits;
+        limits.depth = entry.depth > 0 ? entry.depth : depth;
+        SearchInfo info = engine.analyze(board, entry.position, limits, SearchEngine::Reporter(), stop);
+        Move move = info.line.empty() ? Move{0, 0, false} : info.line[0];
+        bool found = entry.bestMoves.empty()
+                || std::any_of(entry.bestMoves.begin(), entry.bestMoves.end(), [&](Move const& best){
+            return !info.line.empty() && best.newPostion == move.newPostion        // Ближние ходы в ячейку
+                    && best.clearBeginPostion == move.clearBeginPostion            // из разных фишек
+                    && (!move.clearBeginPostion || best.beginPostion == move.beginPostion);// одинаковы.
+        });
+        if (!found){
+            qDebug().noquote() << name << "bm: ход"
+                               << (info.line.empty() ? QString("-")
+                                                     : QString::fromStdString(Notation::moveName(board, move)));
+            failures++;
+        }
+        if (entry.hasScore && info.score != entry.score){
+            qDebug().noquote() << name << "ce:" << info.score << "вместо" << entry.score;
+            failures++;
+        }
+    }
+    qint64 elapsed = std::max<qint64>(1, clock.elapsed());
+    qDebug() << "Позиций:" << entries.size() << "расхождений:" << failures << "perft:" << perftNodes
+             << "узлов," << elapsed << "мс";
+    return failures;
+}
+
+/**
+ * @brief nextRandom Генератор псевдослучайных чисел xorshift64*.
+ * @param state Состояние генератора, не равное нулю.
+ * @return Случайное число.
+ */
+static inline uint64_t nextRandom(uint64_t& state){
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+/**
+ * @brief checkNetwork Функция проверяет вычисления нейросетевой оценки на случайных партиях. В каждой
+ * позиции аккумулятор, обновленный после хода, и аккумулятор refresh сравниваются с аккумулятором,
+ * вычисленным скалярным кодом, оценка evaluate - с оценкой evaluateScalar для обоих игроков. При сборке
+ * с AVX2 так проверяются векторные команды, без AVX2 - только обновление аккумулятора.
+ * @param name Название сети для вывода.
+ * @param network Сеть.
+ * @param board Поле.
+ * @param games Количество партий.
+ * @param material true - оценка должна быть равна разнице фишек.
+ * @return Количество позиций с расхождениями.
+ */
+static int checkNetwork(QString const& name, Nnue const& network, HexBoard const& board, int games,
+                        bool material){
+    const int maxPlies = 400;                                   // Партия без конца прерывается.
+    int failures = 0;
+    int positions = 0;
+    uint64_t random = 0x9E3779B97F4A7C15ULL;
+    int8_t field[HexBoard::maxCells];
+    board.fillStartField(field);
+    for (int game = 0; game < games; game++){
+        Position position = board.positionFromField(field, 1);
+        NnueAccumulator incremental;
+        network.refresh(position, incremental);
+        for (int ply = 0; ply < maxPlies; ply++){
+            NnueAccumulator full;
+            NnueAccumulator reference;
+            network.refresh(position, full);
+            network.refreshScalar(position, reference);
+            bool same = std::memcmp(incremental.values, reference.values, sizeof(reference.values)) == 0
+                    && std::memcmp(full.values, reference.values, sizeof(reference.values)) == 0;
+            for (int player = 1; player <= 2; player++){
+                same = same && network.evaluate(incremental, position.player, player)
+                        == network.evaluateScalar(reference, position.player, player);
+            }
+            int difference = position.chips[0].count() - position.chips[1].count();
+            same = same && (!material || network.evaluate(incremental, position.player, 1)
+                            == difference * Evaluation::scale);
+            if (!same){
+                if (failures < 10){
+                    qDebug().noquote() << name << "партия" << game << "ход" << ply << ":"
+                                       << QString::fromStdString(Notation::toText(board, position));
+                }
+                failures++;
+            }
+            positions++;
+            MoveList moves;
+            if (board.generateMoves(position, moves) == 0){
+                break;
+            }
+            Move move = moves[int(nextRandom(random) % uint64_t(moves.size))];
+            int player = position.player;
+            Bitboard flips = board.doMove(position, move);
+            network.update(incremental, move, player, flips);
+        }
+    }
+    qDebug().noquote() << name << QString("(%1):").arg(Nnue::simdName()) << "позиций" << positions
+                       << "расхождений" << failures;
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCommandLineParser parser;                                  // Параметры подбора весов.
+    parser.setApplicationDescription("Подбор весов оценочной функции по файлам партий, обучение "
+                                     "n-кортежей самоигрой (--td-games), матч выборочного поиска (--match) или "
+                                     "проверка набора тестовых позиций (--suite), запись (--nnue-material) и "
+                                     "проверка (--nnue-check) нейросетевой оценки.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("records", "Файлы партий, записанные с --record.", "records...");
+    QCommandLineOption outputOption("output", "Файл подобранных весов (по умолчанию weights.txt).",
+                                    "file", "weights.txt");
+    QCommandLineOption initialOption("initial", "Файл исходных весов.", "file");
+    QCommandLineOption threadsOption("threads", "Количество потоков.", "n",
+                                     QString::number(QThread::idealThreadCount()));
+    QCommandLineOption iterationsOption("iterations", "Количество итераций спуска.", "n", "500");
+    QCommandLineOption rateOption("rate", "Шаг спуска в единицах веса.", "x", "1.0");
+    QCommandLineOption skipOption("skip-plies", "Количество пропускаемых начальных ходов партии.", "n", "4");
+    parser.addOption(outputOption);
+    parser.addOption(initialOption);
+    parser.addOption(threadsOption);
+    parser.addOption(iterationsOption);
+    parser.addOption(rateOption);
+    QCommandLineOption tdGamesOption("td-games", "Обучение n-кортежей заданным количеством партий самоигры.", "n");
+    QCommandLineOption tdRateOption("td-rate", "Шаг обучения n-кортежей.", "x", "0.05");
+    QCommandLineOption explorationOption("exploration", "Вероятность случайного хода при самоигре.", "x", "0.1");
+    parser.addOption(skipOption);
+    parser.addOption(tdGamesOption);
+    parser.addOption(tdRateOption);
+    parser.addOption(explorationOption);
+    QCommandLineOption matchOption("match", "Матч самоигры поиска со всеми приемами выборочного поиска "
+                                   "против поиска с приемами --baseline, количество партий.", "n");
+    QCommandLineOption baselineOption("baseline", "Приемы второго участника матча через запятую: reductions, "
+                                      "futility, nullmove или none.", "list", "none");
+    QCommandLineOption timeOption("time", "Время хода в матче, мс.", "ms", "100");
+    QCommandLineOption openingOption("opening-plies", "Количество случайных ходов дебюта в матче.", "n", "4");
+    QCommandLineOption suiteOption("suite", "Проверка набора тестовых позиций (Suites/*.hts): perft, лучшие "
+                                   "ходы и оценки поиска. Код возврата - 1, если есть расхождения.", "file");
+    QCommandLineOption suiteDepthOption("suite-depth", "Глубина поиска для позиций набора без depth.", "n", "4");
+    parser.addOption(matchOption);
+    parser.addOption(baselineOption);
+    parser.addOption(timeOption);
+    parser.addOption(openingOption);
+    parser.addOption(suiteOption);
+    parser.addOption(suiteDepthOption);
+    QCommandLineOption nnueMaterialOption("nnue-material", "Запись сети, оценивающей разницу фишек, в файл "
+                                          "--output (по умолчанию material.nnue) для --network.");
+    QCommandLineOption nnueCheckOption("nnue-check", "Проверка обновления аккумулятора и векторных команд "
+                                       "нейросетевой оценки на заданном количестве случайных партий: сеть "
+                                       "--initial или сеть разницы фишек и случайная сеть. Код возврата - 1, "
+                                       "если есть расхождения.", "n");
+    parser.addOption(nnueMaterialOption);
+    parser.addOption(nnueCheckOption);
+    parser.process(a);
+    if (parser.isSet(suiteOption)){                             // Проверка набора тестовых позиций.
+        Evaluation evaluation;
+        if (parser.isSet(initialOption) && !evaluation.load(parser.value(initialOption).toStdString())){
+            qDebug() << "Ошибка: неверный файл весов" << parser.value(initialOption);
+            return -1;
+        }
+        std::ifstream stream(parser.value(suiteOption).toStdString());
+        std::vector<SuiteEntry> entries;
+        std::string error;
+        if (!stream){
+            qDebug() << "Ошибка: не удалось открыть набор" << parser.value(suiteOption);
+            return -1;
+        }
+        if (!TestSuite::load(stream, entries, error)){
+            qDebug() << "Ошибка: набор" << parser.value(suiteOption) << QString::fromStdString(error);
+            return -1;
+        }
+        return runSuite(entries, evaluation, std::max(1, parser.value(suiteDepthOption).toInt())) ? 1 : 0;
+    }
+    if (parser.isSet(nnueMaterialOption)){                      // Сеть разницы фишек.
+        QString output = parser.isSet(outputOption) ? parser.value(outputOption) : "material.nnue";
+        if (!Nnue::materialNetwork(HexBoard().cellCount()).save(output.toStdString())){
+            qDebug() << "Ошибка: не удалось записать" << output;
+            return -1;
+        }
+        return 0;
+    }
+    if (parser.isSet(nnueCheckOption)){                         // Проверка нейросетевой оценки.
+        HexBoard board;
+        int games = std::max(1, parser.value(nnueCheckOption).toInt());
+        int failures = 0;
+        if (parser.isSet(initialOption)){
+            Nnue network;
+            if (!network.load(parser.value(initialOption).toStdString())
+                    || network.cells() != board.cellCount()){
+                qDebug() << "Ошибка: неверный файл сети" << parser.value(initialOption);
+                return -1;
+            }
+            failures += checkNetwork(parser.value(initialOption), network, board, games, false);
+        } else {
+            int cells = board.cellCount();
+            failures += checkNetwork("material", Nnue::materialNetwork(cells), board, games, true);
+            failures += checkNetwork("random", Nnue::randomNetwork(cells, 1), board, games, false);
+        }
+        return failures ? 1 : 0;
+    }
+    if (parser.isSet(matchOption)){                             // Матч выборочного поиска.
+        Evaluation evaluation;
+        if (parser.isSet(initialOption) && !evaluation.load(parser.value(initialOption).toStdString())){
+            qDebug() << "Ошибка: неверный файл весов" << parser.value(initialOption);
+            return -1;
+        }
+        SearchOptions baseline;
+        baseline.reductions = baseline.futility = baseline.nullMove = false;
+        for (QString const& name : parser.value(baselineOption).split(',', QString::SkipEmptyParts)){
+            if (name == "reductions"){
+                baseline.reductions = true;
+            } else
+            if (name == "futility"){
+                baseline.futility = true;
+            } else
+            if (name == "nullmove"){
+                baseline.nullMove = true;
+            } else
+            if (name != "none"){
+                qDebug() << "Ошибка: неизвестный прием" << name;
+                return -1;
+            }
+        }
+        SearchMatch match(HexBoard(), evaluation, parser.value(threadsOption).toInt());
+        match.setOpeningPlies(parser.value(openingOption).toInt());
+        MatchResult result = match.play(SearchOptions(), baseline, parser.value(matchOption).toInt(),
+                                        parser.value(timeOption).toInt(), [](MatchResult const& result){
+            qDebug() << "Партий" << result.games << "+" << result.wins << "=" << result.draws
+                     << "-" << result.losses;
+        });
+        double score = std::min(0.99, std::max(0.01, result.score()));
+        qDebug() << "Очки выборочного поиска:" << result.score() * 100 << "%, Elo"
+                 << int(std::lround(-400.0 * std::log10(1.0 / score - 1.0)));
+        qDebug() << "Средняя глубина:" << result.averageDepth(0) << "против" << result.averageDepth(1);
+        return 0;
+    }
+    if (parser.isSet(tdGamesOption)){                           // Обучение n-кортежей самоигрой.
+        HexBoard board;
+        NTupleNetwork network(board);
+        if (parser.isSet(initialOption) && !network.load(parser.value(initialOption).toStdString())){
+            qDebug() << "Ошибка: неверный файл n-кортежей" << parser.value(initialOption);
+            return -1;
+        }
+        qDebug() << "Кортежей:" << network.tupleCount() << "таблиц:" << network.tableCount()
+                 << "симметрий:" << network.symmetryCount();
+        TdTrainer trainer(board, parser.value(threadsOption).toInt());
+        trainer.setExploration(parser.value(explorationOption).toDouble());
+        trainer.train(network, parser.value(tdGamesOption).toInt(), parser.value(tdRateOption).toDouble(),
+                      [](int games, double error){
+            qDebug() << "Партий" << games << "ошибка" << error;
+        });
+        QString output = parser.isSet(outputOption) ? parser.value(outputOption) : "ntuple.bin";
+        if (!network.save(output.toStdString())){
+            qDebug() << "Ошибка: не удалось записать" << output;
+            return -1;
+        }
+        return 0;
+    }
+    if (parser.positionalArguments().isEmpty()){
+        parser.showHelp(-1);
+    }
+    Evaluation evaluation;                                      // Веса по умолчанию или из файла.
+    if (parser.isSet(initialOption) && !evaluation.load(parser.value(initialOption).toStdString())){
+        qDebug() << "Ошибка: неверный файл весов" << parser.value(initialOption);
+        return -1;
+    }
+    TexelTuner tuner(parser.value(threadsOption).toInt());
+    for (QString const& fileName : parser.positionalArguments()){
+        std::string error;
+        if (!tuner.loadRecords(fileName.toStdString(), parser.value(skipOption).toInt(), error)){
+            qDebug() << "Ошибка:" << QString::fromStdString(error);
+            return -1;
+        }
+    }
+    qDebug() << "Позиций:" << tuner.sampleCount();
+    if (tuner.sampleCount() == 0){
+        return -1;
+    }
+    qDebug() << "K =" << tuner.fitScale(evaluation) << "ошибка" << tuner.error(evaluation);
+    double error = tuner.tune(evaluation, parser.value(iterationsOption).toInt(),
+                              parser.value(rateOption).toDouble(),
+                              [](int iteration, double error){
+        if (iteration % 50 == 0){
+            qDebug() << "Итерация" << iteration << "ошибка" << error;
+        }
+    });
+    qDebug() << "Ошибка после подбора:" << error;
+    for (int f = 0; f < Evaluation::featureCount; f++){
+        qDebug() << Evaluation::featureName(f) << evaluation.weight(f);
+    }
+    if (!evaluation.save(parser.value(outputOption).toStdString())){
+        qDebug() << "Ошибка: не удалось записать" << parser.value(outputOption);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+﻿/**
+* @file searchmatch.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 23:58:42
+* @brief Файл реализации методов класса SearchMatch.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "searchmatch.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+const int SearchMatch::maxPlies;
+const int SearchMatch::tableSizeMb;
+/**
+ * @brief nextRandom Генератор псевдослучайных чисел xorshift64*.
+ * @param state Состояние генератора, не равное нулю.
+ * @return Случайное число.
+ */
+static inline uint64_t nextRandom(uint64_t& state){
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+//............................................................................................................
+//.......................................... MatchResult .....................................................
+//............................................................................................................
+/**
+ * @brief MatchResult::score Метод вычисляет долю очков первого варианта: выигрыш - очко, ничья - пол-очка.
+ * @return Доля очков от 0 до 1, 0.5 - если партий нет.
+ */
+double MatchResult::score() const{
+    return games == 0 ? 0.5 : (wins + 0.5 * draws) / games;
+}
+/**
+ * @brief MatchResult::averageDepth Метод вычисляет среднюю глубину законченной итерации на ход.
+ * @param side Вариант: 0 - первый, 1 - второй.
+ * @return Средняя глубина.
+ */
+double MatchResult::averageDepth(int side) const{
+    return moves[side] == 0 ? 0.0 : double(depthSum[side]) / moves[side];
+}
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief SearchMatch::SearchMatch Конструктор класса.
+ * @param board Геометрия игрового поля.
+ * @param evaluation Оценочная функция обоих вариантов.
+ * @param threadCount Количество потоков матча.
+ */
+SearchMatch::SearchMatch(HexBoard const& board, Evaluation const& evaluation, int threadCount)
+    : board(board), evaluation(evaluation){
+    threads = std::max(1, threadCount);
+    started = 0;
+}
+/**
+ * @brief SearchMatch::setOpeningPlies Метод задает количество случайных ходов, которыми начинается каждая
+ * пара партий.
+ * @param plies Количество ходов.
+ */
+void SearchMatch::setOpeningPlies(int plies){
+    openingPlies = std::max(0, plies);
+}
+/**
+ * @brief SearchMatch::play Метод играет матч двух вариантов поиска.
+ * @param first Приемы выборочного поиска первого варианта.
+ * @param second Приемы выборочного поиска второго варианта.
+ * @param games Количество партий, округляется вверх до четного.
+ * @param time Время хода, мс.
+ * @param progress Функция, получающая итог после каждой сыгранной партии. Вызывается из потоков матча
+ * по одному.
+ * @return Итог матча для первого варианта.
+ */
+MatchResult SearchMatch::play(SearchOptions const& first, SearchOptions const& second, int games, int time,
+                              std::function<void(MatchResult const&)> const& progress){
+    games += games & 1;                                     // Партии играются парами.
+    started = 0;
+    result = MatchResult();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++){
+        pool.emplace_back(&SearchMatch::worker, this, std::cref(first), std::cref(second), games,
+                          std::max(1, time), uint64_t(0x9E3779B97F4A7C15ULL), std::cref(progress));
+    }
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+    return result;
+}
+//............................................................................................................
+//.......................................... private methods .................................................
+//............................................................................................................
+/**
+ * @brief SearchMatch::worker Метод потока матча: играет партии, пока общее количество начатых партий
+ * меньше заданного.
+ * @param first Приемы первого варианта.
+ * @param second Приемы второго варианта.
+ * @param games Количество партий.
+ * @param time Время хода, мс.
+ * @param seed Начальное значение генератора дебютов, одинаковое для всех потоков: дебют зависит только
+ * от номера пары.
+ * @param progress Функция, получающая итог после каждой партии.
+ */
+void SearchMatch::worker(SearchOptions const& first, SearchOptions const& second, int games, int time,
+                         uint64_t seed, std::function<void(MatchResult const&)> const& progress){
+    SearchEngine firstEngine(tableSizeMb);
+    SearchEngine secondEngine(tableSizeMb);
+    SearchEngine* engines[2] = {&firstEngine, &secondEngine};
+    firstEngine.setOptions(first);
+    secondEngine.setOptions(second);
+    for (SearchEngine* engine : engines){
+        engine->setEvaluator([this](Position const& position){
+            return evaluation.evaluate(board, position, position.player);
+        });
+    }
+    std::atomic<bool> stop{false};
+    SearchLimits limits;
+    limits.time = time;
+    for (int game; (game = started.fetch_add(1)) < games; ){
+        Position position = opening(seed + uint64_t(game / 2));
+        int firstPlayer = 1 + game % 2;                     // Цвета меняются внутри пары.
+        uint64_t moves[2] = {0, 0};
+        uint64_t depthSum[2] = {0, 0};
+        MoveList list;
+        for (int ply = 0; ply < maxPlies && board.generateMoves(position, list) > 0; ply++){
+            int side = position.player == firstPlayer ? 0 : 1;
+            engines[side]->clear();
+            SearchInfo info = engines[side]->analyze(board, position, limits, SearchEngine::Reporter(), stop);
+            moves[side]++;
+            depthSum[side] += uint64_t(info.depth);
+            board.doMove(position, info.line.empty() ? list[0] : info.line.front());
+        }
+        int own = position.chips[firstPlayer - 1].count();
+        int other = position.chips[2 - firstPlayer].count();
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result.games++;
+        result.wins += own > other;
+        result.draws += own == other;
+        result.losses += own < other;
+        for (int side = 0; side < 2; side++){
+            result.moves[side] += moves[side];
+            result.depthSum[side] += depthSum[side];
+        }
+        progress(result);
+    }
+}
+/**
+ * @brief SearchMatch::opening Метод строит стартовую позицию пары партий: openingPlies случайных ходов
+ * со стартовой позиции поля. Если партия кончилась раньше, дебют короче.
+ * @param seed Начальное значение генератора.
+ * @return Позиция.
+ */
+Position SearchMatch::opening(uint64_t seed) const{
+    uint64_t random = seed * 0x2545F4914F6CDD1DULL | 1;
+    int8_t field[HexBoard::maxCells];
+    board.fillStartField(field);
+    Position position = board.positionFromField(field, 1);
+    MoveList moves;
+    for (int ply = 0; ply < openingPlies && board.generateMoves(position, moves) > 0; ply++){
+        board.doMove(position, moves[int(nextRandom(random) % uint64_t(moves.size))]);
+    }
+    return position;
+}
@@ -0,0 +1,71 @@
+﻿/**
+* @file searchmatch.h
+* @author Oleg2008e28
+* @date 19.10.2026 23:41:07
+* @brief Заголовочный файл класса SearchMatch - матча самоигры двух вариантов SearchEngine с разными
+* приемами выборочного поиска при одинаковом времени хода.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef SEARCHMATCH_H
+#define SEARCHMATCH_H
+#include "hexsearch.h"
+#include "hexevaluation.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+//............................................................................................................
+/**
+ * @brief The MatchResult struct Итог матча для первого варианта поиска.
+ */
+struct MatchResult {
+    int games = 0;                                      //!Количество сыгранных партий.
+    int wins = 0;                                       //!Выигрыши первого варианта.
+    int draws = 0;                                      //!Ничьи.
+    int losses = 0;                                     //!Проигрыши первого варианта.
+    uint64_t moves[2] = {0, 0};                         //!Количество ходов каждого варианта.
+    uint64_t depthSum[2] = {0, 0};                      //!Сумма глубин законченных итераций по ходам.
+    double score() const;                               // Доля очков первого варианта.
+    double averageDepth(int side) const;                // Средняя глубина хода варианта.
+};
+/**
+ * @brief The SearchMatch class Матч самоигры двух вариантов поиска.
+ *
+ * Партии играются парами: обе партии пары начинаются с одной и той же позиции после openingPlies
+ * случайных ходов, в первой партии пары первый вариант играет за игрока 1, во второй - за игрока 2.
+ * Каждый ход ищется с чистой таблицей транспозиций и ограничением времени, поэтому выигрыш в глубине
+ * от выборочного поиска сразу сказывается на силе игры. Партия заканчивается, когда у игрока, который
+ * ходит, нет ходов, или через maxPlies ходов; побеждает тот, у кого больше фишек. Потоки играют разные
+ * партии; при ограничении по времени потоков должно быть не больше, чем ядер.
+ */
+class SearchMatch{
+public:
+    SearchMatch(HexBoard const& board,
+                Evaluation const& evaluation,
+                int threadCount);                       // Конструктор, поле, оценка и количество потоков.
+    void setOpeningPlies(int plies);                    // Количество случайных ходов дебюта.
+    MatchResult play(SearchOptions const& first,
+                     SearchOptions const& second,
+                     int games, int time,
+                     std::function<void(MatchResult const&)> const&
+                     progress);                         // Матч из заданного количества партий.
+//............................................................................................................
+public:
+    static const int maxPlies = 400;                    //!Наибольшая длина партии.
+    static const int tableSizeMb = 16;                  //!Размер таблицы транспозиций каждого варианта.
+private:
+    void worker(SearchOptions const& first,
+                SearchOptions const& second,
+                int games, int time, uint64_t seed,
+                std::function<void(MatchResult const&)> const&
+                progress);                              // Поток матча.
+    Position opening(uint64_t seed) const;              // Стартовая позиция пары партий.
+private:
+    HexBoard board;                                     // Геометрия игрового поля.
+    Evaluation evaluation;                              // Оценочная функция обоих вариантов.
+    int threads;                                        // Количество потоков.
+    int openingPlies = 4;                               // Количество случайных ходов дебюта.
+    std::atomic<int> started;                           // Количество начатых партий.
+    std::mutex resultMutex;                             // Защита итога матча.
+    MatchResult result;                                 // Итог матча.
+};
+#endif // SEARCHMATCH_H
@@ -0,0 +1,163 @@
+﻿/**
+* @file tdtrainer.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 20:49:35
+* @brief Файл реализации методов класса TdTrainer.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "tdtrainer.h"
+#include "hexevaluation.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+const int TdTrainer::maxPlies;
+/**
+ * @brief nextRandom Генератор псевдослучайных чисел xorshift64*.
+ * @param state Состояние генератора, не равное нулю.
+ * @return Случайное число.
+ */
+static inline uint64_t nextRandom(uint64_t& state){
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief TdTrainer::TdTrainer Конструктор класса.
+ * @param board Геометрия игрового поля, на котором играются партии.
+ * @param threadCount Количество потоков самоигры.
+ */
+TdTrainer::TdTrainer(HexBoard const& board, int threadCount) : board(board){
+    threads = std::max(1, threadCount);
+    started = 0;
+    finished = 0;
+    errorSum = 0;
+    errorCount = 0;
+}
+/**
+ * @brief TdTrainer::setExploration Метод задает вероятность случайного хода при самоигре.
+ * @param probability Вероятность от 0 до 1.
+ */
+void TdTrainer::setExploration(double probability){
+    exploration = std::min(1.0, std::max(0.0, probability));
+}
+/**
+ * @brief TdTrainer::train Метод обучает сеть самоигрой. Пока потоки играют, вызывающий поток раз в
+ * секунду сообщает о ходе обучения.
+ * @param network Сеть, построенная для поля тренера.
+ * @param games Количество партий.
+ * @param rate Доля разности оценок, на которую сдвигается оценка позиции.
+ * @param progress Функция, получающая количество сыгранных партий и средний квадрат ошибки в фишках.
+ * @return Средний квадрат ошибки в фишках за последний отрезок обучения.
+ */
+double TdTrainer::train(NTupleNetwork& network, int games, double rate,
+                        std::function<void(int, double)> const& progress){
+    started = 0;
+    finished = 0;
+    takeError();
+    std::vector<std::thread> pool;
+    uint64_t seed = uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+    for (int t = 0; t < threads; t++){
+        pool.emplace_back(&TdTrainer::worker, this, std::ref(network), games, rate,
+                          seed + uint64_t(t) * 0x9E3779B97F4A7C15ULL);
+    }
+    double error = 0.0;
+    for (int tick = 1; finished.load() < games; tick++){
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (tick % 10 == 0){                                // Сообщение раз в секунду.
+            error = takeError();
+            progress(finished.load(), error);
+        }
+    }
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+    if (errorCount.load() > 0){
+        error = takeError();
+    }
+    progress(finished.load(), error);
+    return error;
+}
+//............................................................................................................
+//.......................................... private methods .................................................
+//............................................................................................................
+/**
+ * @brief TdTrainer::worker Метод потока самоигры: играет партии, пока общее количество начатых партий
+ * меньше заданного.
+ * @param network Обучаемая сеть.
+ * @param games Количество партий.
+ * @param rate Доля разности оценок.
+ * @param seed Начальное значение генератора случайных чисел.
+ */
+void TdTrainer::worker(NTupleNetwork& network, int games, double rate, uint64_t seed){
+    uint64_t random = seed | 1;
+    uint32_t explore = uint32_t(exploration * 4294967295.0); // Порог случайного хода.
+    int8_t field[HexBoard::maxCells];
+    board.fillStartField(field);
+    Position start = board.positionFromField(field, 1);
+    double unit = rate * (1 << NTupleNetwork::weightShift);
+    while (started.fetch_add(1) < games){
+        Position position = start;
+        uint64_t localSum = 0;
+        uint64_t localCount = 0;
+        for (int ply = 0; ; ply++){
+            MoveList moves;
+            int target;
+            Position next = position;
+            bool last = board.generateMoves(position, moves) == 0 || ply >= maxPlies;
+            if (last){                                      // Партия окончена или прервана.
+                target = finalScore(position);
+            } else
+            if (uint32_t(nextRandom(random) >> 32) < explore){
+                board.doMove(next, moves[int(nextRandom(random) % uint64_t(moves.size))]);
+                target = board.hasMoves(next, next.player) ? -network.value(next) : -finalScore(next);
+            } else {
+                target = 0;
+                for (int i = 0; i < moves.size; i++){       // Ход с наибольшей оценкой после хода.
+                    Position child = position;
+                    board.doMove(child, moves[i]);
+                    int score = board.hasMoves(child, child.player) ? -network.value(child)
+                                                                    : -finalScore(child);
+                    if (i == 0 || score > target){
+                        target = score;
+                        next = child;
+                    }
+                }
+            }
+            int error = target - network.value(position);
+            network.update(position, int(unit * error));
+            localSum += uint64_t(error) * uint64_t(error) / uint64_t(Evaluation::scale * Evaluation::scale / 256);
+            localCount++;
+            if (last){
+                break;
+            }
+            position = next;
+        }
+        errorSum.fetch_add(localSum);
+        errorCount.fetch_add(localCount);
+        finished.fetch_add(1);
+    }
+}
+/**
+ * @brief TdTrainer::finalScore Метод вычисляет счет позиции: разность фишек игрока, который ходит, и
+ * противника.
+ * @param position Позиция.
+ * @return Счет, Evaluation::scale - одна фишка.
+ */
+int TdTrainer::finalScore(Position const& position) const{
+    int own = position.player - 1;
+    return (position.chips[own].count() - position.chips[1 - own].count()) * Evaluation::scale;
+}
+/**
+ * @brief TdTrainer::takeError Метод возвращает средний квадрат ошибки с прошлого вызова и обнуляет суммы.
+ * @return Средний квадрат ошибки в фишках.
+ */
+double TdTrainer::takeError(){
+    uint64_t sum = errorSum.exchange(0);
+    uint64_t count = errorCount.exchange(0);
+    return count == 0 ? 0.0 : sum / 256.0 / count;
+}
@@ -0,0 +1,50 @@
+﻿/**
+* @file tdtrainer.h
+* @author Oleg2008e28
+* @date 19.10.2026 20:24:13
+* @brief Заголовочный файл класса TdTrainer - обучения оценочной функции NTupleNetwork самоигрой методом
+* временных разностей TD(0). Партии играются в нескольких потоках, все потоки меняют общие таблицы.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef TDTRAINER_H
+#define TDTRAINER_H
+#include "hexntuple.h"
+#include <atomic>
+#include <functional>
+//............................................................................................................
+/**
+ * @brief The TdTrainer class Обучение n-кортежей самоигрой.
+ *
+ * Каждый поток играет партии со стартовой позиции поля: ход выбирается по наибольшей оценке позиции
+ * после хода, с вероятностью exploration - случайно. Оценка позиции до хода сдвигается к оценке после
+ * хода, взятой с обратным знаком (после хода очередь противника), на долю rate от разности. В конце
+ * партии целью служит счет: разность фишек игрока, который должен ходить, умноженная на
+ * Evaluation::scale. Партия длиннее maxPlies ходов прерывается с целью по текущей разности фишек.
+ * Блокировок нет: NTupleNetwork::update меняет строки таблиц атомарным сложением.
+ */
+class TdTrainer{
+public:
+    TdTrainer(HexBoard const& board, int threadCount);  // Конструктор, поле и количество потоков.
+    void setExploration(double probability);            // Вероятность случайного хода.
+    double train(NTupleNetwork& network, int games,
+                 double rate,
+                 std::function<void(int, double)> const&
+                 progress);                             // Обучение заданным количеством партий.
+//............................................................................................................
+public:
+    static const int maxPlies = 400;                    //!Наибольшая длина партии.
+private:
+    void worker(NTupleNetwork& network, int games,
+                double rate, uint64_t seed);            // Поток самоигры.
+    int finalScore(Position const& position) const;     // Счет для игрока, который ходит.
+    double takeError();                                 // Средний квадрат ошибки с прошлого вызова.
+private:
+    HexBoard board;                                     // Геометрия игрового поля.
+    int threads;                                        // Количество потоков.
+    double exploration = 0.1;                           // Вероятность случайного хода.
+    std::atomic<int> started;                           // Количество начатых партий.
+    std::atomic<int> finished;                          // Количество сыгранных партий.
+    std::atomic<uint64_t> errorSum;                     // Сумма квадратов ошибок, в фишках^2 / 256.
+    std::atomic<uint64_t> errorCount;                   // Количество ошибок в сумме.
+};
+#endif // TDTRAINER_H
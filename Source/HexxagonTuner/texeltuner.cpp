@@ -0,0 +1,237 @@
+﻿/**
+* @file texeltuner.cpp
+* @author Oleg2008e28
+* @date 19.10.2026 16:31:47
+* @brief Файл реализации методов класса TexelTuner.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#include "texeltuner.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+static const int featureCount = Evaluation::featureCount;
+//............................................................................................................
+//.......................................... public methods ..................................................
+//............................................................................................................
+/**
+ * @brief TexelTuner::TexelTuner Конструктор класса.
+ * @param threadCount Количество потоков вычисления ошибки и градиента.
+ */
+TexelTuner::TexelTuner(int threadCount){
+    threads = std::max(1, threadCount);
+}
+/**
+ * @brief TexelTuner::loadRecords Метод загружает позиции из файла партий. Берутся только законченные
+ * партии, первые ходы партии пропускаются: в них результат почти не зависит от позиции.
+ * @param [in] fileName Имя файла партий.
+ * @param [in] skipPlies Количество пропускаемых начальных ходов.
+ * @param [out] error Описание ошибки.
+ * @return true - файл прочитан, false - файл не открыт или поврежден.
+ */
+bool TexelTuner::loadRecords(std::string const& fileName, int skipPlies, std::string& error){
+    GameRecordReader reader(fileName);
+    if (!reader.isOpen()){
+        error = "не удалось открыть файл партий " + fileName;
+        return false;
+    }
+    GameRecord record;
+    HexBoard board;
+    std::vector<Position> positions;
+    std::vector<Move> moves;
+    int16_t values[featureCount];
+    while (reader.next(record)){
+        if (record.result < 0){                             // Партия не закончена.
+            continue;
+        }
+        if (!record.replay(board, positions, moves)){
+            error = "партия не соответствует правилам в файле " + fileName;
+            return false;
+        }
+        uint8_t result = uint8_t(record.result == 1 ? 2 : record.result == 2 ? 0 : 1);
+        for (size_t i = size_t(std::max(0, skipPlies)); i < positions.size(); i++){
+            Evaluation::features(board, positions[i], values);
+            features.insert(features.end(), values, values + featureCount);
+            results.push_back(result);
+        }
+    }
+    return true;
+}
+/**
+ * @brief TexelTuner::sampleCount Метод возвращает количество загруженных позиций.
+ * @return Количество позиций.
+ */
+size_t TexelTuner::sampleCount() const{
+    return results.size();
+}
+/**
+ * @brief TexelTuner::fitScale Метод подбирает коэффициент K сигмоиды при заданных весах методом
+ * золотого сечения.
+ * @param evaluation Оценочная функция.
+ * @return Коэффициент K.
+ */
+double TexelTuner::fitScale(Evaluation const& evaluation){
+    double weights[featureCount];
+    for (int f = 0; f < featureCount; f++){
+        weights[f] = evaluation.weight(f);
+    }
+    const double ratio = (std::sqrt(5.0) - 1) / 2;
+    double a = 0.01, b = 10.0;                              // Границы поиска K.
+    for (int i = 0; i < 40; i++){
+        double x1 = b - ratio * (b - a);
+        double x2 = a + ratio * (b - a);
+        scaleK = x1;
+        double e1 = error(weights);
+        scaleK = x2;
+        double e2 = error(weights);
+        if (e1 < e2) b = x2;
+        else a = x1;
+    }
+    scaleK = (a + b) / 2;
+    return scaleK;
+}
+/**
+ * @brief TexelTuner::error Метод вычисляет ошибку предсказания при весах оценочной функции.
+ * @param evaluation Оценочная функция.
+ * @return Средний квадрат ошибки.
+ */
+double TexelTuner::error(Evaluation const& evaluation) const{
+    double weights[featureCount];
+    for (int f = 0; f < featureCount; f++){
+        weights[f] = evaluation.weight(f);
+    }
+    return error(weights);
+}
+/**
+ * @brief TexelTuner::tune Метод подбирает веса оценочной функции градиентным спуском Adam. Веса ведутся
+ * вещественными и округляются при записи в оценочную функцию.
+ * @param [in,out] evaluation Оценочная функция с исходными весами, после подбора - с подобранными.
+ * @param [in] iterations Количество итераций.
+ * @param [in] rate Шаг спуска в единицах веса.
+ * @param [in] progress Функция, вызываемая на каждой итерации с номером итерации и ошибкой весов,
+ * для которых на этой итерации вычислен градиент.
+ * @return Ошибка предсказания при подобранных весах.
+ */
+double TexelTuner::tune(Evaluation& evaluation, int iterations, double rate,
+                        std::function<void(int, double)> const& progress){
+    const double beta1 = 0.9, beta2 = 0.999, epsilon = 1e-12;
+    double weights[featureCount], grad[featureCount];
+    double m[featureCount] = {}, v[featureCount] = {};      // Моменты Adam.
+    for (int f = 0; f < featureCount; f++){
+        weights[f] = evaluation.weight(f);
+    }
+    for (int it = 1; it <= iterations; it++){
+        double currentError = gradient(weights, grad);
+        for (int f = 0; f < featureCount; f++){
+            if (f == Evaluation::material){                 // Вес фишки задает единицу оценки.
+                continue;
+            }
+            m[f] = beta1 * m[f] + (1 - beta1) * grad[f];
+            v[f] = beta2 * v[f] + (1 - beta2) * grad[f] * grad[f];
+            double mHat = m[f] / (1 - std::pow(beta1, it));
+            double vHat = v[f] / (1 - std::pow(beta2, it));
+            weights[f] -= rate * mHat / (std::sqrt(vHat) + epsilon);
+        }
+        if (progress){
+            progress(it, currentError);
+        }
+    }
+    for (int f = 0; f < featureCount; f++){
+        evaluation.setWeight(f, int(std::lround(weights[f])));
+    }
+    return error(evaluation);
+}
+//............................................................................................................
+//......................................... private methods ..................................................
+//............................................................................................................
+/**
+ * @brief TexelTuner::parallelFor Метод делит позиции на равные непрерывные части и вызывает функцию для
+ * каждой части в отдельном потоке.
+ * @param f Функция, принимающая номер части, первую позицию и позицию за последней.
+ */
+template<class F>
+void TexelTuner::parallelFor(F f) const{
+    size_t count = results.size();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++){
+        size_t begin = count * t / threads;
+        size_t end = count * (t + 1) / threads;
+        pool.emplace_back(f, t, begin, end);
+    }
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+}
+/**
+ * @brief TexelTuner::error Метод вычисляет ошибку предсказания при вещественных весах.
+ * @param weights Веса признаков.
+ * @return Средний квадрат ошибки.
+ */
+double TexelTuner::error(double const* weights) const{
+    if (results.empty()){
+        return 0.0;
+    }
+    std::vector<double> sums(threads, 0.0);
+    double k = scaleK / Evaluation::scale;
+    parallelFor([&](int t, size_t begin, size_t end){
+        double sum = 0.0;
+        int16_t const* row = features.data() + begin * featureCount;
+        for (size_t i = begin; i < end; i++, row += featureCount){
+            double score = 0.0;
+            for (int f = 0; f < featureCount; f++){
+                score += weights[f] * row[f];
+            }
+            double diff = results[i] * 0.5 - 1.0 / (1.0 + std::exp(-k * score));
+            sum += diff * diff;
+        }
+        sums[t] = sum;
+    });
+    double total = 0.0;
+    for (double sum : sums){
+        total += sum;
+    }
+    return total / results.size();
+}
+/**
+ * @brief TexelTuner::gradient Метод вычисляет градиент ошибки предсказания по весам и саму ошибку
+ * за один проход по позициям.
+ * @param [in] weights Веса признаков.
+ * @param [out] result Градиент, featureCount значений.
+ * @return Средний квадрат ошибки.
+ */
+double TexelTuner::gradient(double const* weights, double* result) const{
+    std::vector<double> sums(size_t(threads) * featureCount, 0.0);
+    std::vector<double> errors(threads, 0.0);
+    double k = scaleK / Evaluation::scale;
+    parallelFor([&](int t, size_t begin, size_t end){
+        double local[featureCount] = {};
+        double errorSum = 0.0;
+        int16_t const* row = features.data() + begin * featureCount;
+        for (size_t i = begin; i < end; i++, row += featureCount){
+            double score = 0.0;
+            for (int f = 0; f < featureCount; f++){
+                score += weights[f] * row[f];
+            }
+            double sigmoid = 1.0 / (1.0 + std::exp(-k * score));
+            double diff = sigmoid - results[i] * 0.5;
+            double factor = diff * sigmoid * (1.0 - sigmoid);
+            errorSum += diff * diff;
+            for (int f = 0; f < featureCount; f++){
+                local[f] += factor * row[f];
+            }
+        }
+        std::copy(local, local + featureCount, sums.begin() + t * featureCount);
+        errors[t] = errorSum;
+    });
+    double total = 0.0;
+    for (double sum : errors){
+        total += sum;
+    }
+    for (int f = 0; f < featureCount; f++){
+        result[f] = 0.0;
+        for (int t = 0; t < threads; t++){
+            result[f] += sums[t * featureCount + f];
+        }
+        result[f] *= 2.0 * k / std::max<size_t>(1, results.size());
+    }
+    return total / std::max<size_t>(1, results.size());
+}
@@ -0,0 +1,54 @@
+﻿/**
+* @file texeltuner.h
+* @author Oleg2008e28
+* @date 19.10.2026 16:05:22
+* @brief Заголовочный файл класса TexelTuner - подбора весов оценочной функции по результатам сыгранных
+* партий (метод Texel): веса выбираются так, чтобы оценка позиции лучше всего предсказывала результат.
+* @note https://github.com/Oleg2008e28/Hexxagon
+*/
+#ifndef TEXELTUNER_H
+#define TEXELTUNER_H
+#include "hexevaluation.h"
+#include "gamerecord.h"
+#include <functional>
+#include <string>
+#include <vector>
+//............................................................................................................
+/**
+ * @brief The TexelTuner class Подбор весов оценочной функции.
+ *
+ * При загрузке партий для каждой позиции один раз вычисляются признаки Evaluation, и позиция хранится
+ * строкой из featureCount 16-битных чисел в общем массиве, рядом хранится результат партии. Ошибка
+ * предсказания - средний квадрат разности результата (1 - победа игрока 1, 0.5 - ничья, 0 - поражение)
+ * и сигмоиды оценки: 1 / (1 + exp(-K * оценка / scale)). Сначала подбирается K при исходных весах,
+ * затем веса подбираются градиентным спуском (Adam). Проход по позициям делится на равные части между
+ * потоками, каждый поток считает свои суммы градиента и ошибки, суммы складываются после прохода.
+ * Вес фишки не меняется: он задает единицу оценки.
+ */
+class TexelTuner{
+public:
+    explicit TexelTuner(int threadCount);               // Конструктор, количество потоков.
+    bool loadRecords(std::string const& fileName,
+                     int skipPlies,
+                     std::string& error);               // Загрузка позиций из файла партий.
+    size_t sampleCount() const;                         // Количество загруженных позиций.
+    double fitScale(Evaluation const& evaluation);      // Подбор коэффициента K сигмоиды.
+    double error(Evaluation const& evaluation) const;   // Ошибка предсказания при заданных весах.
+    double tune(Evaluation& evaluation, int iterations,
+                double rate,
+                std::function<void(int, double)> const&
+                progress);                              // Подбор весов.
+//............................................................................................................
+private:
+    double error(double const* weights) const;          // Ошибка предсказания при вещественных весах.
+    double gradient(double const* weights,
+                    double* result) const;              // Градиент и ошибка за один проход.
+    template<class F>
+    void parallelFor(F f) const;                        // Параллельный проход по частям позиций.
+private:
+    int threads;                                        // Количество потоков.
+    double scaleK = 1.0;                                // Коэффициент K сигмоиды.
+    std::vector<int16_t> features;                      // Признаки позиций, featureCount на позицию.
+    std::vector<uint8_t> results;                       // Результаты в полуочках: 2, 1, 0.
+};
+#endif // TEXELTUNER_H